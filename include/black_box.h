@@ -0,0 +1,64 @@
+#ifndef BLACK_BOX_H
+#define BLACK_BOX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data_storage.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_BLACK_BOX_ENABLE 1
+#define PT_BLACK_BOX_FILENAME "black_box.bin"
+#define PT_BLACK_BOX_WINDOW_MS 5000         /* 비상 시 남길 최근 구간 */
+#define PT_BLACK_BOX_ENTRY_RATE_HZ 1000     /* 로그 엔트리 최대 속도 (용량 산정) */
+
+/* ============================================================
+ * 블랙박스
+ *
+ * 비상 종료 직전 링 버퍼의 최근 N초를 비행 로그 컨테이너 형식으로
+ * 남긴다. 파일과 범위는 미리 할당하고 0으로 채워 두므로, 비상 경로는
+ * 메모리 할당 없이 이미 할당된 블록을 덮어쓰기만 한다 (fdatasync 가
+ * 파일 메타데이터를 갱신할 필요가 없음).
+ *
+ * 파일 = [SETUP][TELEMETRY ...][INDEX][0 ...][트레일러 (파일 끝)]
+ * 트레일러가 기록되기 전에 끊기면 읽기 측이 순차 탐색으로 복구한다.
+ * ============================================================ */
+
+typedef struct {
+    uint32_t entries;
+    uint64_t bytes;
+    uint32_t serialize_us;
+    uint32_t write_us;
+    uint32_t sync_us;
+    uint32_t total_us;
+    bool within_deadline;               /* total_us <= PT_EMERGENCY_SHUTDOWN_TIME_MS */
+} BlackBoxReport;
+
+typedef struct {
+    int fd;
+    LogBuffer *log;
+    uint32_t window_ms;
+    uint32_t max_entries;
+
+    uint8_t *staging;                   /* 직렬화 버퍼 (미리 접근해 둠) */
+    uint32_t staging_size;
+    uint8_t *index_bytes;               /* FlightLogState 색인 (재할당 없음) */
+    uint32_t index_capacity;
+    uint64_t file_size;
+
+    uint32_t flush_count;
+    BlackBoxReport last;
+} BlackBox;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+BlackBox* BlackBox_Create(const char *filename, LogBuffer *log, uint32_t window_ms);
+void BlackBox_Destroy(BlackBox *bb);
+
+bool BlackBox_Flush(BlackBox *bb, BlackBoxReport *report);
+
+#endif
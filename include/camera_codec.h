@@ -0,0 +1,67 @@
+#ifndef CAMERA_CODEC_H
+#define CAMERA_CODEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_CAMERA_JPEG_QUALITY 75           /* 시작 품질 (비율 제어가 조정) */
+#define PT_CAMERA_JPEG_QUALITY_MIN 10
+#define PT_CAMERA_JPEG_QUALITY_MAX 95
+#define PT_CAMERA_JPEG_QUALITY_STEP 5          /* 목표와 2배 이상 차이 날 때 */
+#define PT_CAMERA_JPEG_SIZE_TOLERANCE 0.15f /* 목표 크기 ±15% 안이면 품질 유지 */
+
+/* ============================================================
+ * IRIGFIX_: 고정
+ * ============================================================ */
+
+#define IRIGFIX_JPEG_BLOCK 8
+#define IRIGFIX_JPEG_HEADER_SIZE 328        /* SOI ~ SOS (흑백, 표준 허프만 표) */
+
+/* ============================================================
+ * 카메라 영상 압축 (JPEG 베이스라인, 흑백)
+ *
+ * 8비트 휘도 영상을 8×8 블록 단위로 레벨 이동 → AAN 부동소수 DCT →
+ * 양자화 → 지그재그 → 표준 허프만 (ITU T.81 부록 K) 으로 부호화한다.
+ * DCT 와 양자화는 블록의 한 행을 8레인 벡터로 두고 8열을 동시에
+ * 처리하며, 엔트로피 부호화만 스칼라로 남는다. 출력은 일반 JPEG
+ * 디코더로 열리는 완전한 JFIF 파일이다.
+ *
+ * target_size 가 0 이 아니면 프레임마다 결과 크기를 보고 다음 프레임
+ * 품질을 한 단계씩 조정해 목표 압축률을 따라간다.
+ * ============================================================ */
+
+typedef struct {
+    int quality;
+    uint32_t target_size;               /* 0 = 고정 품질 */
+
+    uint8_t qtable[64];                 /* DQT 기록용 (지그재그 순서) */
+    float qscale[64] __attribute__((aligned(32)));  /* 1 / (q × AAN 배율 × 8), 자연 순서 */
+
+    uint16_t dc_code[12];
+    uint8_t dc_len[12];
+    uint16_t ac_code[256];
+    uint8_t ac_len[256];
+
+    uint64_t frames_encoded;
+    uint64_t bytes_out;
+} CameraCodec;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+CameraCodec* CameraCodec_Create(int quality, uint32_t target_size);
+void CameraCodec_Destroy(CameraCodec *codec);
+
+void CameraCodec_SetQuality(CameraCodec *codec, int quality);
+
+/* 흑백 영상 → JPEG. 반환: 출력 바이트 수 (0 = 출력 버퍼 부족 / 인자 오류) */
+uint32_t CameraCodec_EncodeGray(CameraCodec *codec, const uint8_t *pixels,
+                                uint16_t width, uint16_t height,
+                                uint8_t *out, uint32_t out_capacity);
+
+#endif
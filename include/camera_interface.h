@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 
 /* ============================================================
  * PT_: 프로젝트 튜닝
@@ -13,18 +14,23 @@
 #define PT_CAMERA_FPS 10
 #define PT_CAMERA_COMPRESSION_RATIO 10
 #define PT_CAMERA_ENABLE 1
+#define PT_CAMERA_POOL_FRAMES 112           /* 로그 링 보관분 (10초 × 10fps) + 처리 중 여유 */
+#define PT_CAMERA_SYNTHETIC_SOURCE 1        /* 실제 장치 대신 합성 패턴 원천 사용 */
 
 /* ============================================================
  * IRIGFIX_: 고정
  * ============================================================ */
 
 #define IRIGFIX_CAMERA_MAX_FRAME_SIZE (1024 * 200)
+#define IRIGFIX_CAMERA_FORMAT_RAW_GRAY 0
 #define IRIGFIX_CAMERA_FORMAT_JPEG 1
 
 /* ============================================================
  * 카메라 구조
  * ============================================================ */
 
+struct CameraFramePool;
+
 typedef struct {
     uint32_t frame_id;
     uint64_t timestamp_us;
@@ -32,12 +38,63 @@ typedef struct {
     uint16_t height;
     uint32_t data_size;
     uint8_t *data;
+    uint8_t format;                     /* IRIGFIX_CAMERA_FORMAT_* */
+    
+    /* 참조 계수: 마지막 Camera_ReleaseFrame 이 풀에 반환 (풀 없으면 free) */
+    _Atomic uint32_t refcount;
+    struct CameraFramePool *pool;
+    uint32_t pool_index;
 } CameraFrame;
 
+/* ============================================================
+ * 프레임 풀
+ *
+ * IRIGFIX_CAMERA_MAX_FRAME_SIZE 버퍼 N개를 한 번에 할당해 두고 캡처마다
+ * 꺼내 쓴다. 캡처/압축/로그/다운링크가 같은 버퍼를 Camera_RetainFrame 으로
+ * 공유하므로 소비자마다 복사하지 않는다. 빈 목록은 짧은 스핀락으로 보호.
+ * 버퍼는 미리 접근하지 않으므로 실제로 채운 크기만큼만 페이지가 잡힌다.
+ *
+ * 풀 자체도 참조 계수를 가진다 (소유자 1 + 나가 있는 프레임 수).
+ * CameraFramePool_Destroy 뒤에도 나가 있던 프레임이 모두 반환되면 해제된다.
+ * ============================================================ */
+
+typedef struct CameraFramePool {
+    CameraFrame *frames;
+    uint8_t *buffers;
+    uint32_t frame_count;
+    
+    uint32_t *free_stack;
+    uint32_t free_count;
+    atomic_flag lock;
+    
+    _Atomic uint32_t refs;
+    _Atomic uint32_t exhausted;         /* 빈 버퍼가 없어 실패한 Acquire 수 */
+} CameraFramePool;
+
+/* ============================================================
+ * 영상 원천
+ *
+ * 캡처 시 width × height 흑백 화소를 채우는 콜백. 실제 센서 드라이버나
+ * 시험용 합성 패턴을 같은 자리에 꽂는다. 실패하면 false (프레임 버림).
+ * ============================================================ */
+
+typedef bool (*CameraSourceFn)(void *context, uint32_t frame_id,
+                               uint8_t *pixels, uint16_t width, uint16_t height);
+
+typedef struct {
+    CameraSourceFn read;                /* NULL = 화소 없음 (빈 프레임) */
+    void *context;
+} CameraSource;
+
 typedef struct {
     void *camera_handle;
     uint32_t current_frame_id;
     bool is_streaming;
+    
+    CameraFramePool *pool;
+    uint32_t frames_dropped;            /* 풀 고갈 / 원천 실패로 놓친 캡처 */
+    
+    CameraSource source;
 } CameraDevice;
 
 /* ============================================================
@@ -49,8 +106,19 @@ void Camera_Destroy(CameraDevice *cam);
 
 bool Camera_Start(CameraDevice *cam);
 bool Camera_Stop(CameraDevice *cam);
+void Camera_SetSource(CameraDevice *cam, CameraSourceFn read, void *context);
+
+/* 결정적 합성 패턴 (같은 frame_id → 같은 화소). context 미사용 */
+bool Camera_SyntheticSource(void *context, uint32_t frame_id,
+                            uint8_t *pixels, uint16_t width, uint16_t height);
 
 CameraFrame* Camera_CaptureFrame(CameraDevice *cam);
+void Camera_RetainFrame(CameraFrame *frame);
 void Camera_ReleaseFrame(CameraFrame *frame);
 
+CameraFramePool* CameraFramePool_Create(uint32_t frame_count);
+void CameraFramePool_Destroy(CameraFramePool *pool);
+CameraFrame* CameraFramePool_Acquire(CameraFramePool *pool);
+uint32_t CameraFramePool_GetFreeCount(CameraFramePool *pool);
+
 #endif
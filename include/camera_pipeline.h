@@ -0,0 +1,100 @@
+#ifndef CAMERA_PIPELINE_H
+#define CAMERA_PIPELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include "camera_interface.h"
+#include "camera_codec.h"
+#include "camera_scaler.h"
+#include "data_storage.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_CAMERA_TRIGGER_QUEUE 4           /* 압축 대기 캡처 요청 (2의 거듭제곱) */
+#define PT_CAMERA_DOWNLINK_QUEUE 16         /* 다운링크 대기 압축 프레임 (2의 거듭제곱) */
+
+/* ============================================================
+ * 카메라 압축 파이프라인
+ *
+ * 텔레메트리 루프는 CameraPipeline_Trigger 로 캡처 시각만 큐에 넣고
+ * 바로 돌아온다. 전용 워커 스레드가 원천에서 원시 프레임을 받아
+ * (설정에 따라 ROI 자르기 / 축소 후) JPEG 로 압축한 뒤 같은 풀 버퍼를
+ * 참조로 로그와 다운링크 큐에 넘긴다. 축소 설정은 요청마다 함께 복사해
+ * 넘기므로 워커와 공유하는 상태가 없다.
+ *
+ * 두 큐 모두 단일 생산자-단일 소비자 (head/tail 원자 변수) 이다.
+ * 워커가 밀려 요청 큐가 차면 요청을, 다운링크가 밀려 큐가 차면
+ * 압축 프레임을 버리고 센다 (텔레메트리 루프는 절대 기다리지 않음).
+ * ============================================================ */
+
+typedef struct {
+    uint64_t timestamp_us;
+    CameraScaleParams scale;            /* 요청 시점 축소 설정 */
+} CameraTrigger;
+
+typedef struct {
+    _Atomic uint32_t head;              /* 소비자 */
+    _Atomic uint32_t tail;              /* 생산자 */
+    CameraTrigger entries[PT_CAMERA_TRIGGER_QUEUE];
+} CameraTriggerQueue;
+
+typedef struct {
+    _Atomic uint32_t head;
+    _Atomic uint32_t tail;
+    CameraFrame *frames[PT_CAMERA_DOWNLINK_QUEUE];
+} CameraDownlinkQueue;
+
+typedef struct {
+    CameraDevice *camera;
+    LogBuffer *log;                     /* NULL = 로그에 넣지 않음 */
+    CameraCodec *codec;
+    CameraScaler *scaler;               /* 워커 전용 */
+    CameraScaleParams scale;            /* 텔레메트리 루프 측 현재 설정 */
+
+    CameraTriggerQueue triggers;
+    CameraDownlinkQueue downlink;
+
+    pthread_t thread;
+    sem_t wakeup;
+    _Atomic bool running;
+
+    /* 통계 */
+    _Atomic uint32_t frames_compressed;
+    _Atomic uint32_t triggers_dropped;  /* 요청 큐 가득 참 (워커 지연) */
+    _Atomic uint32_t capture_failures;  /* 풀 고갈 / 원천 실패 / 출력 부족 */
+    _Atomic uint32_t downlink_dropped;  /* 다운링크 큐 가득 참 */
+    _Atomic uint64_t raw_bytes;
+    _Atomic uint64_t compressed_bytes;
+    _Atomic uint64_t encode_us_total;
+    _Atomic uint32_t encode_us_max;
+    _Atomic uint32_t frames_scaled;
+    _Atomic uint64_t scale_us_total;
+} CameraPipeline;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+CameraPipeline* CameraPipeline_Create(CameraDevice *camera, LogBuffer *log);
+/* 대기 중인 요청까지 처리한 뒤 스레드 종료, 다운링크 큐에 남은 프레임 반환 */
+void CameraPipeline_Destroy(CameraPipeline *pipeline);
+
+/* 텔레메트리 루프: 다음 요청부터 쓸 ROI / 축소 설정 (ConfigSet 에서 읽기) */
+void CameraPipeline_SetScale(CameraPipeline *pipeline, const CameraScaleParams *scale);
+void CameraPipeline_ApplyConfig(CameraPipeline *pipeline, ConfigSet *config);
+
+/* 텔레메트리 루프: 캡처 요청 (블로킹 없음). 큐가 차면 false */
+bool CameraPipeline_Trigger(CameraPipeline *pipeline, uint64_t timestamp_us);
+
+/* 다운링크: 압축 프레임 하나 (참조 1, 다 쓰면 Camera_ReleaseFrame). 없으면 NULL */
+CameraFrame* CameraPipeline_PopDownlink(CameraPipeline *pipeline);
+
+/* 요청 큐가 빌 때까지 대기 (시험/종료용) */
+void CameraPipeline_WaitIdle(CameraPipeline *pipeline);
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef CAMERA_SCALER_H
+#define CAMERA_SCALER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "camera_interface.h"
+#include "telemetry_config.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_CAMERA_SCALER_MAX_WIDTH 2048     /* 원본 한 행 최대 화소 (작업 버퍼 크기) */
+#define PT_CAMERA_SCALE_MAX_FACTOR 16       /* 박스 축소 한 축 최대 배율 (16×16 합 ≤ u16) */
+
+/* ConfigSet 파라미터 ID (int, 0 = 원본 그대로) */
+#define CAMERA_CONFIG_PARAM_OUT_WIDTH 7     /* 출력 폭 (ROI 보다 크면 ROI 폭) */
+#define CAMERA_CONFIG_PARAM_OUT_HEIGHT 8
+#define CAMERA_CONFIG_PARAM_SCALE_MODE 9    /* CAMERA_SCALE_* */
+#define CAMERA_CONFIG_PARAM_ROI_X 10
+#define CAMERA_CONFIG_PARAM_ROI_Y 11
+#define CAMERA_CONFIG_PARAM_ROI_WIDTH 12    /* 0 = 원본 끝까지 */
+#define CAMERA_CONFIG_PARAM_ROI_HEIGHT 13
+
+#define CAMERA_SCALE_BOX 0                  /* 정수 배율 평균 (나누어떨어지지 않으면 쌍선형) */
+#define CAMERA_SCALE_BILINEAR 1             /* 임의 크기, 화소 중심 정렬 */
+
+/* ============================================================
+ * 카메라 축소 / 관심 영역
+ *
+ * 링크 여유가 없을 때 압축 전에 원시 흑백 프레임을 줄인다. ROI 는
+ * 원본 위 사각형이고, 그 영역을 출력 크기로 축소한다 (확대 없음).
+ * 축소 없이 ROI 만 고르면 행 단위 복사, 축소는 세로 방향 (행 간)
+ * 누적/보간을 16바이트 벡터로 처리하고 가로 방향만 열 단위로 모은다.
+ * 입력이 줄면 DCT 블록 수와 압축 바이트가 함께 준다.
+ * ============================================================ */
+
+typedef struct {
+    uint16_t roi_x;
+    uint16_t roi_y;
+    uint16_t roi_width;                 /* 0 = 원본 끝까지 */
+    uint16_t roi_height;
+    uint16_t out_width;                 /* 0 = ROI 크기 */
+    uint16_t out_height;
+    uint8_t mode;                       /* CAMERA_SCALE_* */
+} CameraScaleParams;
+
+typedef struct {
+    uint16_t *rows;                     /* 세로 누적/보간 결과 한 행 (+ 여유) */
+
+    /* 쌍선형 열 표 (src_width/out_width 가 바뀔 때만 다시 계산) */
+    uint16_t *x_index;
+    uint16_t *x_weight;                 /* Q8, 오른쪽 화소 가중치 */
+    uint16_t table_src_width;
+    uint16_t table_out_width;
+
+    uint64_t frames_scaled;
+} CameraScaler;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+CameraScaler* CameraScaler_Create(void);
+void CameraScaler_Destroy(CameraScaler *scaler);
+
+/* 원본 전체, 축소 없음 */
+void CameraScaler_DefaultParams(CameraScaleParams *params);
+/* CAMERA_CONFIG_PARAM_* 읽기 (등록되지 않은 파라미터는 0 = 원본) */
+void CameraScaler_ApplyConfig(CameraScaleParams *params, ConfigSet *config);
+
+/* 원본 크기에 맞춰 ROI / 출력 크기 확정. 반환: 원본과 달라지면 true */
+bool CameraScaler_Resolve(const CameraScaleParams *params, uint16_t src_width,
+                          uint16_t src_height, CameraScaleParams *resolved);
+
+/* 원시 흑백 src 의 ROI 를 잘라 출력 크기로 dst 에 (frame_id/시각 복사).
+ * 변환이 필요 없거나 실패하면 false */
+bool CameraScaler_Process(CameraScaler *scaler, const CameraScaleParams *params,
+                          const CameraFrame *src, CameraFrame *dst);
+
+/* 커널 (src 는 ROI 왼쪽 위, stride 는 원본 행 바이트) */
+void CameraScaler_Crop(const uint8_t *src, uint32_t stride, uint16_t width,
+                       uint16_t height, uint8_t *dst);
+bool CameraScaler_Box(CameraScaler *scaler, const uint8_t *src, uint32_t stride,
+                      uint16_t src_width, uint16_t src_height,
+                      uint8_t *dst, uint16_t out_width, uint16_t out_height);
+bool CameraScaler_Bilinear(CameraScaler *scaler, const uint8_t *src, uint32_t stride,
+                           uint16_t src_width, uint16_t src_height,
+                           uint8_t *dst, uint16_t out_width, uint16_t out_height);
+
+#endif
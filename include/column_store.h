@@ -0,0 +1,112 @@
+#ifndef COLUMN_STORE_H
+#define COLUMN_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "missile_telemetry.h"
+#include "telemetry_channels.h"
+#include "data_storage.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_ENABLE_COLUMN_EXPORT 1
+#define PT_COLUMN_EXPORT_FILENAME "flight_columns.tmc"
+#define PT_COLUMN_CHUNK_ROWS 4096           /* 청크당 행 수 (통계 단위) */
+#define PT_COLUMN_EXPORT_THREADS 4          /* 채널 병렬 변환 스레드 */
+
+/* ============================================================
+ * IRIGFIX_: 고정 - 열 저장 파일 형식 (변경 금지)
+ *
+ * 비행 후 분석용. 모든 필드는 리틀 엔디언.
+ *
+ * 파일 = [헤더 32][열 0 청크들][열 1 청크들] ... [디렉터리]
+ * 헤더:  0 magic u32        4 version u32
+ *        8 column_count u32 12 chunk_rows u32
+ *       16 row_count u64    24 directory_offset u64
+ * 디렉터리 = 열 항목 column_count 개, 이어서 열마다 청크 표
+ * 열 항목 48바이트: name[32], type u8, size u8, encoding u8, 예약 u8,
+ *                   chunk_count u32, chunk_table_offset u64
+ * 청크 표 항목 40바이트: offset u64, data_len u32, row_count u32,
+ *                   min f64, max f64, encoding u8, width u8, 예약 6
+ *
+ * 청크 본문
+ *   RAW:   값 row_count 개 (채널 크기 그대로)
+ *   DELTA: 첫 값 u64 + 이후 값의 (원시 비트 차분 → 지그재그) 를
+ *          width 비트씩 LSB 우선으로 패킹. 이득이 없으면 RAW 로 저장.
+ * min/max 는 NaN 을 제외한 값 (전부 NaN 이면 NaN).
+ * ============================================================ */
+
+#define IRIGFIX_COLUMN_MAGIC 0x434D5454     /* "TTMC" */
+#define IRIGFIX_COLUMN_VERSION 1
+#define IRIGFIX_COLUMN_HEADER_BYTES 32
+#define IRIGFIX_COLUMN_ENTRY_BYTES 48
+#define IRIGFIX_COLUMN_CHUNK_ENTRY_BYTES 40
+#define IRIGFIX_COLUMN_NAME_BYTES 32
+
+#define IRIGFIX_COLUMN_ENC_RAW 0
+#define IRIGFIX_COLUMN_ENC_DELTA 1
+
+/* ============================================================
+ * 내보내기 옵션 / 읽기 구조
+ * ============================================================ */
+
+typedef struct {
+    uint32_t chunk_rows;                /* 0 = PT_COLUMN_CHUNK_ROWS */
+    uint32_t threads;                   /* 0 = PT_COLUMN_EXPORT_THREADS */
+    bool compress;                      /* 모든 열에 DELTA 시도 */
+    const bool *compress_column;        /* 열별 지정 (NULL 이면 compress 사용) */
+} ColumnExportOptions;
+
+typedef struct {
+    uint64_t offset;
+    uint32_t data_len;
+    uint32_t row_count;
+    double min;
+    double max;
+    uint8_t encoding;
+    uint8_t width;
+} ColumnChunkInfo;
+
+typedef struct {
+    char name[IRIGFIX_COLUMN_NAME_BYTES];
+    TelemetryChannelType type;
+    uint8_t size;
+    uint8_t encoding;
+    uint32_t chunk_count;
+    ColumnChunkInfo *chunks;
+} ColumnInfo;
+
+typedef struct {
+    int fd;
+    uint32_t column_count;
+    uint32_t chunk_rows;
+    uint64_t row_count;
+    ColumnInfo *columns;
+
+    _Atomic uint64_t bytes_read;        /* 헤더/디렉터리 + 읽은 청크 본문 */
+} ColumnStore;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+/* 내보내기: 링 버퍼를 시간 순서로 전치해 채널별 열 파일로 기록 */
+bool ColumnStore_Export(LogBuffer *log, const char *filename,
+                        const ColumnExportOptions *options);
+
+/* 읽기: 열 단위 / 청크 단위 접근 (ReadChunk 는 여러 스레드에서 호출 가능) */
+ColumnStore* ColumnStore_Open(const char *filename);
+void ColumnStore_Close(ColumnStore *store);
+
+int ColumnStore_FindColumn(const ColumnStore *store, const char *name);
+const ColumnChunkInfo* ColumnStore_GetChunk(const ColumnStore *store, int column,
+                                            uint32_t chunk);
+uint32_t ColumnStore_ReadChunk(ColumnStore *store, int column, uint32_t chunk,
+                               double *out);
+uint64_t ColumnStore_ReadColumn(ColumnStore *store, int column,
+                                double *out, uint64_t max);
+
+#endif
@@ -3,7 +3,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include "missile_telemetry.h"
+#include "log_writer.h"
+#include "log_pyramid.h"
+#include "camera_interface.h"
 
 /* ============================================================
  * PT_: 프로젝트 튜닝 - 자유롭게 변경
@@ -14,6 +18,10 @@
 #define PT_ENABLE_CAMERA_LOGGING 1
 #define PT_CAMERA_FRAME_SIZE (1024 * 100)
 #define PT_LOG_BUFFER_SIZE (1024 * 512)
+#define PT_CAMERA_SLAB_ENTRY_INTERVAL 100   /* 1 kHz 로그 / 10 fps 카메라 */
+#define PT_CAMERA_SLAB_SPARE 4
+#define PT_LOG_SAVE_PERIOD_MS 50            /* 증분 저장 주기 (0 = 끔) */
+#define PT_LOG_SAVE_FILENAME "flight_save.bin"
 
 /* ============================================================
  * IRIGFIX_: IRIG 106 고정 - 절대 변경 금지
@@ -40,14 +48,80 @@ typedef struct {
     
 } LogEntry;
 
+/* camera_frame_id → 슬롯 (선형 탐사 해시, 부하율 <= 0.5) */
+typedef struct {
+    uint32_t frame_id;
+    uint32_t slot;                      /* CAMERA_INDEX_EMPTY = 빈 칸 */
+} CameraIndexEntry;
+
+#define CAMERA_INDEX_EMPTY 0xFFFFFFFF
+
+/* ============================================================
+ * 다중 생산자 수집
+ *
+ * 생산자는 티켓 (fetch_add) 으로 슬롯을 예약해 엔트리를 제자리에 채우고
+ * 커밋한다. 커밋은 슬롯별 순번으로 표시되며, 연속으로 커밋된 티켓까지만
+ * 공개 (buffer_count / write_position / is_full / last_position 갱신) 된다.
+ * 공개와 스트리밍은 trylock 을 잡은 생산자가 대신 처리하므로 생산자끼리
+ * 기다리지 않는다. 카메라 색인/슬랩만 짧은 스핀락으로 보호한다.
+ * ============================================================ */
+
+typedef struct {
+    LogEntry *entry;                    /* 예약된 슬롯 (커밋 전까지 비공개) */
+    uint64_t ticket;
+} LogReservation;
+
 typedef struct {
     LogEntry *buffer;
-    uint32_t buffer_count;
+    _Atomic uint32_t buffer_count;
     uint32_t buffer_capacity;
-    uint32_t write_position;
-    bool is_full;
+    _Atomic uint32_t write_position;
+    _Atomic bool is_full;
+    
+    /* 예약/커밋 상태 */
+    _Atomic uint64_t reserve_ticket;    /* 다음에 예약할 티켓 */
+    _Atomic uint64_t published;         /* 이 티켓 미만은 모두 커밋되어 공개됨 */
+    _Atomic uint64_t *slot_seq;         /* 슬롯별 마지막 커밋 티켓 + 1 */
+    atomic_flag publish_lock;           /* 공개 + 스트리밍 (trylock 전용) */
+    atomic_flag camera_lock;            /* 카메라 색인/슬랩 */
+    _Atomic uint32_t reserve_waits;     /* 한 바퀴 앞선 생산자를 기다린 횟수 */
+    
+    /* 카메라 프레임 색인 (WriteCameraFrame / 링 덮어쓰기 시 갱신) */
+    CameraIndexEntry *camera_index;
+    uint32_t camera_index_mask;
+    _Atomic uint32_t camera_frame_count;
+    
+    /* 카메라 페이로드 슬랩 (PT_CAMERA_FRAME_SIZE 단위, 링 슬롯과 함께 재활용) */
+    uint8_t *camera_arena;
+    uint32_t camera_slab_count;
+    uint32_t *camera_free_slabs;        /* 빈 슬랩 스택 */
+    uint32_t camera_free_count;
+    _Atomic uint32_t camera_frames_dropped;  /* 크기 초과 / 슬랩 부족 */
+    
+    /* 풀 프레임 참조 (WriteCameraFrameRef, 슬롯별). 슬랩 대신 복사 없이 보관 */
+    CameraFrame **camera_refs;
+    
+    /* 비행 중 연속 기록 (선택) */
+    LogWriter *writer;
+    void *stream_state;                 /* FlightLogState (패킷 순번/색인) */
+    _Atomic uint32_t last_position;     /* 마지막으로 공개된 엔트리 */
+    uint64_t stream_next;               /* 다음에 내보낼 티켓 (최신 엔트리는 카메라 대기) */
+    
+    /* 증분 저장 (AppendToSD): 열린 파일 + 영속 워터마크 */
+    void *append_state;
+    
+    /* 퀵룩 감축 피라미드 (선택, 공개 순서대로 갱신) */
+    LogPyramid *pyramid;
+    uint64_t pyramid_next;              /* 다음에 더할 티켓 */
 } LogBuffer;
 
+/* 시간 순서 반복자 (순번 = 가장 오래된 엔트리부터 0) */
+typedef struct {
+    LogBuffer *log;
+    uint32_t next;
+    uint32_t end;
+} LogIterator;
+
 /* ============================================================
  * 함수 선언
  * ============================================================ */
@@ -55,17 +129,37 @@ typedef struct {
 LogBuffer* DataStorage_Init(uint32_t capacity);
 void DataStorage_Destroy(LogBuffer *log);
 
+LogEntry* DataStorage_Reserve(LogBuffer *log, LogReservation *res);
+void DataStorage_Commit(LogBuffer *log, LogReservation *res);
 void DataStorage_WriteEntry(LogBuffer *log, LogEntry *entry);
 void DataStorage_WriteCameraFrame(LogBuffer *log, uint32_t frame_id,
                                    uint8_t *frame_data, uint32_t size);
+bool DataStorage_WriteCameraFrameRef(LogBuffer *log, CameraFrame *frame);
 
 LogEntry* DataStorage_ReadEntry(LogBuffer *log, uint32_t index);
-uint8_t* DataStorage_ReadCameraFrame(LogBuffer *log, uint32_t frame_id);
+LogEntry* DataStorage_ReadEntryChrono(LogBuffer *log, uint32_t n);
+
+uint32_t DataStorage_LowerBound(LogBuffer *log, uint64_t time_us);
+void DataStorage_IterBegin(LogBuffer *log, LogIterator *it);
+uint32_t DataStorage_QueryRange(LogBuffer *log, uint64_t start_us, uint64_t end_us,
+                                LogIterator *it);
+LogEntry* DataStorage_IterNext(LogIterator *it);
+uint32_t DataStorage_ReadCameraFrame(LogBuffer *log, uint32_t frame_id,
+                                     uint8_t *out, uint32_t capacity);
 
 uint32_t DataStorage_GetEntryCount(LogBuffer *log);
 uint32_t DataStorage_GetCameraFrameCount(LogBuffer *log);
 
+bool DataStorage_AttachWriter(LogBuffer *log, LogWriter *writer);
+void DataStorage_FlushWriter(LogBuffer *log);
+bool DataStorage_DetachWriter(LogBuffer *log);
+
+bool DataStorage_AttachPyramid(LogBuffer *log, LogPyramid *pyramid);
+void DataStorage_DetachPyramid(LogBuffer *log);
+
 bool DataStorage_SaveToSD(LogBuffer *log, const char *filename);
+bool DataStorage_AppendToSD(LogBuffer *log, const char *filename);
+bool DataStorage_CloseAppend(LogBuffer *log);
 bool DataStorage_LoadFromSD(LogBuffer *log, const char *filename);
 
 #endif
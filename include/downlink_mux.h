@@ -0,0 +1,135 @@
+#ifndef DOWNLINK_MUX_H
+#define DOWNLINK_MUX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "missile_telemetry.h"
+#include "frame_packer.h"
+#include "camera_interface.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_MUX_TELEMETRY_QUEUE 64           /* 송신 대기 텔레메트리 프레임 */
+#define PT_MUX_VIDEO_QUEUE 4                /* 송신 대기 영상 프레임 (가득 차면 가장 오래된 것 폐기) */
+#define PT_MUX_VIDEO_MAX_AGE_US 500000      /* 캡처 후 이 시간 안에 다 못 보내면 폐기 */
+#define PT_MUX_MIN_FRAGMENT_BYTES 32        /* 이보다 작은 여유에는 조각을 싣지 않음 */
+#define PT_MUX_SPARE_AVG_SHIFT 4            /* 블록당 여유 바이트 이동 평균 (1/16) */
+
+/* ============================================================
+ * IRIGFIX_: 고정 - 영상 조각 레이아웃 (변경 금지)
+ * ============================================================ */
+
+/* 정보 블록 = [헤더 4][텔레메트리 페이로드 payload_len][영상 조각 ...][0 패딩]
+ * 영상 조각 = [표식 0xC7][frame_id u32][total_size u24][offset u24][len u16]
+ *             [데이터 len][CRC32 (표식 ~ 데이터)], MSB 우선
+ * 기존 FrameUnpacker 는 payload_len 뒤를 보지 않으므로 그대로 호환된다. */
+#define IRIGFIX_MUX_FRAGMENT_MARKER 0xC7
+#define IRIGFIX_MUX_FRAGMENT_HEADER_BYTES 13
+#define IRIGFIX_MUX_FRAGMENT_CRC_BYTES 4
+#define IRIGFIX_MUX_FRAGMENT_OVERHEAD \
+    (IRIGFIX_MUX_FRAGMENT_HEADER_BYTES + IRIGFIX_MUX_FRAGMENT_CRC_BYTES)
+
+/* ============================================================
+ * 하향 링크 다중화기
+ *
+ * 고정 속도 링크는 코드워드 하나 (block_period_us) 마다 정보 블록 하나를
+ * 반드시 보낸다. 슬롯마다 대기 중인 텔레메트리를 먼저 전부 패킹하고
+ * (블록을 넘기면 다음 슬롯으로 이월), 남는 자리만 영상 조각으로 채운다.
+ * 영상은 텔레메트리 자리를 빼앗지 않으므로 텔레메트리 지연은 영상 유무와
+ * 무관하게 최대 한 슬롯 + 대기열이다.
+ *
+ * 영상은 캡처 시각 + PT_MUX_VIDEO_MAX_AGE_US 를 마감으로 가장 이른 마감
+ * 순서 (= 캡처 순서) 로 보낸다. 마감이 지났거나, 남은 바이트를 최근 여유
+ * 평균으로 나눈 예상 완료 시각이 마감을 넘으면 보내던 중이라도 폐기하고
+ * 다음 프레임으로 넘어간다 (지난 영상을 쌓아 두지 않음).
+ * ============================================================ */
+
+typedef struct {
+    CameraFrame *frame;                 /* 참조 1 보유 */
+    uint64_t deadline_us;
+} DownlinkVideoSlot;
+
+typedef struct {
+    FramePacker *packer;
+    double block_period_us;             /* 코드워드 하나의 송신 시간 */
+    double next_slot_us;                /* 다음 블록 송신 시각 (음수 = 미정) */
+
+    MissileTelemetryFrame telemetry[PT_MUX_TELEMETRY_QUEUE];
+    uint32_t telemetry_head;
+    uint32_t telemetry_count;
+
+    DownlinkVideoSlot video[PT_MUX_VIDEO_QUEUE];
+    uint32_t video_head;
+    uint32_t video_count;
+    uint32_t video_offset;              /* 맨 앞 프레임에서 이미 보낸 바이트 */
+    uint32_t spare_avg;                 /* 블록당 여유 바이트 이동 평균 */
+    uint8_t *fragment;                  /* 조각 조립 버퍼 (payload_capacity) */
+
+    /* 통계 */
+    uint64_t blocks;
+    uint64_t telemetry_frames;
+    uint32_t telemetry_overflow;        /* 대기열 가득 참 (링크 용량 부족) */
+    uint64_t telemetry_latency_max_us;  /* 프레임 시각 → 마지막 바이트가 실린 슬롯 끝 */
+    uint64_t video_fragments;
+    uint64_t video_bytes;
+    uint32_t video_frames_sent;
+    uint32_t video_frames_stale;        /* 마감 초과 / 예상 초과 */
+    uint32_t video_frames_superseded;   /* 대기열이 차서 밀려남 */
+    uint64_t spare_bytes_unused;
+} DownlinkMux;
+
+/* ============================================================
+ * 지상측 영상 재조립
+ *
+ * 링크는 순서를 지키므로 한 번에 프레임 하나만 조립한다. offset 이
+ * 이어지지 않거나 (코드워드 손실) CRC 가 틀리면 그 프레임은 버린다.
+ * ============================================================ */
+
+typedef void (*DownlinkVideoFn)(void *context, uint32_t frame_id,
+                                const uint8_t *data, uint32_t size);
+
+typedef struct {
+    uint32_t payload_capacity;
+    DownlinkVideoFn on_frame;
+    void *context;
+
+    uint8_t *frame_buf;                 /* IRIGFIX_CAMERA_MAX_FRAME_SIZE */
+    bool active;
+    uint32_t frame_id;
+    uint32_t total_size;
+    uint32_t received;
+
+    uint64_t fragments;
+    uint32_t fragments_bad;             /* CRC / 길이 오류 */
+    uint32_t frames_completed;
+    uint32_t frames_incomplete;
+} DownlinkDemux;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+DownlinkMux* DownlinkMux_Create(int info_bits, double block_period_us);
+void DownlinkMux_Destroy(DownlinkMux *mux);
+
+/* 텔레메트리 프레임 복사해 대기 (가득 차면 false) */
+bool DownlinkMux_AddTelemetry(DownlinkMux *mux, const MissileTelemetryFrame *frame);
+/* 압축 영상 프레임 대기 (참조 추가, 호출자 참조는 그대로) */
+bool DownlinkMux_SubmitVideo(DownlinkMux *mux, CameraFrame *frame);
+
+/* now_us 까지 송신 시각이 된 슬롯이 있으면 블록 하나를 info 에 만들고 true.
+ * 시각 t 의 텔레메트리는 t 까지의 슬롯을 보낸 뒤 넣는다 (이미 지난 슬롯에 실리지 않도록) */
+bool DownlinkMux_NextBlock(DownlinkMux *mux, uint64_t now_us, uint8_t *info);
+/* 보낼 텔레메트리/영상이 남았는지 */
+bool DownlinkMux_HasPending(const DownlinkMux *mux);
+
+DownlinkDemux* DownlinkDemux_Create(int info_bits, DownlinkVideoFn on_frame, void *context);
+void DownlinkDemux_Destroy(DownlinkDemux *demux);
+
+/* FrameUnpacker_Unpack 이 바이트로 압축한 정보 블록에서 영상 조각 처리.
+ * 반환: 이 블록으로 완성된 프레임 수 */
+int DownlinkDemux_PushBlock(DownlinkDemux *demux, const uint8_t *block);
+
+#endif
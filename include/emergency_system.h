@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "black_box.h"
 
 /* ============================================================
  * PT_: 프로젝트 튜닝
@@ -69,6 +70,9 @@ bool EmergencySystem_ProcessCommand(EmergencyCommand *cmd,
                                      EmergencyState *state);
 bool EmergencySystem_ValidateCommand(EmergencyCommand *cmd);
 
+/* Terminate / SelfDestruct 가 멈추기 전에 최근 로그를 남길 블랙박스 */
+void EmergencySystem_SetBlackBox(BlackBox *bb);
+
 void EmergencySystem_Terminate(void);
 void EmergencySystem_SelfDestruct(void);
 void EmergencySystem_AbortMission(void);
@@ -0,0 +1,175 @@
+#ifndef FLIGHT_LOG_H
+#define FLIGHT_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "missile_telemetry.h"
+#include "data_storage.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_FLOG_INDEX_STRIDE 64             /* 텔레메트리 패킷 N개마다 색인 */
+#define PT_FLOG_MAX_PACKET_BYTES (16 * 1024 * 1024)
+
+/* ============================================================
+ * IRIGFIX_: 고정 - 비행 로그 컨테이너 형식 (변경 금지)
+ *
+ * IRIG 106 Chapter 10 패킷 구조를 따른다. 모든 필드는 리틀 엔디언.
+ *
+ * 패킷 = [헤더 24바이트][본문 data_len][0 패딩 (4바이트 정렬)][CRC32]
+ * 헤더:  0 sync u16 (0xEB25)     2 channel_id u16
+ *        4 packet_len u32        8 data_len u32
+ *       12 version u8           13 sequence u8 (채널별)
+ *       14 flags u8             15 data_type u8
+ *       16 time_us u48          22 header_checksum u16 (앞 22바이트 u16 합)
+ * CRC32: 본문 + 패딩 (IEEE 802.3)
+ *
+ * 파일 = SETUP 패킷, TELEMETRY/CAMERA 패킷 ..., INDEX 패킷, 트레일러
+ * 트레일러 16바이트: index_offset u64, magic u32, CRC32 (앞 12바이트)
+ * 트레일러가 없으면 (비행 중 전원 차단) 마지막 유효 패킷까지 복구한다.
+ * 증분 저장 파일은 저장마다 COMMIT 패킷 (SETUP 채널) 으로 끝난다.
+ * ============================================================ */
+
+#define IRIGFIX_FLOG_SYNC 0xEB25
+#define IRIGFIX_FLOG_VERSION 1
+#define IRIGFIX_FLOG_HEADER_BYTES 24
+#define IRIGFIX_FLOG_CRC_BYTES 4
+#define IRIGFIX_FLOG_TRAILER_BYTES 16
+#define IRIGFIX_FLOG_TRAILER_MAGIC 0x58444E49  /* "INDX" */
+#define IRIGFIX_FLOG_TIME_MASK 0xFFFFFFFFFFFFULL
+
+#define IRIGFIX_FLOG_CHANNEL_SETUP 0
+#define IRIGFIX_FLOG_CHANNEL_TELEMETRY 1
+#define IRIGFIX_FLOG_CHANNEL_CAMERA 2
+#define IRIGFIX_FLOG_NUM_CHANNELS 3
+
+#define IRIGFIX_FLOG_TYPE_SETUP 0x01        /* Computer Generated F1 */
+#define IRIGFIX_FLOG_TYPE_COMMIT 0x02       /* Computer Generated F2 */
+#define IRIGFIX_FLOG_TYPE_INDEX 0x03        /* Computer Generated F3 */
+#define IRIGFIX_FLOG_TYPE_TELEMETRY 0x09    /* PCM F1 */
+#define IRIGFIX_FLOG_TYPE_CAMERA 0x40       /* Video F0 */
+
+/* 본문 레이아웃 */
+#define IRIGFIX_FLOG_SETUP_BYTES 16         /* version, frame_size, channels, stride */
+#define IRIGFIX_FLOG_TM_PREFIX_BYTES 20     /* entry_id, cam_id, cam_size, cmd, thrust */
+#define IRIGFIX_FLOG_TM_BODY_BYTES \
+    (IRIGFIX_FLOG_TM_PREFIX_BYTES + sizeof(MissileTelemetryFrame))
+#define IRIGFIX_FLOG_CAM_PREFIX_BYTES 8     /* frame_id, size */
+#define IRIGFIX_FLOG_INDEX_ENTRY_BYTES 16   /* time_us u64, offset u64 */
+#define IRIGFIX_FLOG_COMMIT_BYTES 16        /* telemetry_packets u64, commit_offset u64 */
+
+#define FLIGHT_LOG_HEAD_MAX (IRIGFIX_FLOG_HEADER_BYTES + IRIGFIX_FLOG_TM_BODY_BYTES)
+
+/* ============================================================
+ * 패킷 / 기록 상태
+ * ============================================================ */
+
+typedef struct {
+    uint16_t channel_id;
+    uint8_t data_type;
+    uint8_t sequence;
+    uint8_t flags;
+    uint32_t packet_len;
+    uint32_t data_len;
+    uint64_t time_us;
+} FlightLogPacketHeader;
+
+/* 조립된 패킷: head + payload + tail 순서로 그대로 기록하면 된다 */
+typedef struct {
+    uint8_t head[FLIGHT_LOG_HEAD_MAX];  /* 헤더 + 고정 본문 */
+    uint32_t head_len;
+    const uint8_t *payload;             /* 복사하지 않는 가변 본문 */
+    uint32_t payload_len;
+    uint8_t tail[3 + IRIGFIX_FLOG_CRC_BYTES];
+    uint32_t tail_len;
+
+    uint16_t channel_id;
+    uint8_t data_type;
+    uint64_t time_us;
+    uint32_t packet_len;
+} FlightLogPacket;
+
+typedef struct {
+    uint64_t time_us;
+    uint64_t offset;
+} FlightLogIndexEntry;
+
+/* 기록 측 상태: 파일 오프셋, 채널별 순번, 색인 */
+typedef struct {
+    uint64_t offset;
+    uint8_t sequence[IRIGFIX_FLOG_NUM_CHANNELS];
+    uint32_t telemetry_packets;
+
+    uint8_t *index_bytes;               /* 직렬화된 색인 항목 (INDEX 본문) */
+    uint32_t index_count;
+    uint32_t index_capacity;
+} FlightLogState;
+
+typedef struct {
+    FILE *file;
+    uint64_t file_size;
+    uint64_t data_end;                  /* 마지막 유효 패킷 다음 */
+    uint64_t position;
+    bool has_footer;
+
+    FlightLogIndexEntry *index;
+    uint32_t index_count;
+
+    uint8_t *packet_buf;
+    uint32_t packet_cap;
+} FlightLogReader;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+uint32_t FlightLog_CRC32(uint32_t crc, const uint8_t *data, uint32_t len);
+
+/* 기록 */
+void FlightLogState_Init(FlightLogState *state);
+void FlightLogState_Free(FlightLogState *state);
+
+void FlightLog_BuildSetup(const FlightLogState *state, FlightLogPacket *pkt);
+void FlightLog_BuildTelemetry(const FlightLogState *state, FlightLogPacket *pkt,
+                              const LogEntry *entry);
+void FlightLog_BuildCamera(const FlightLogState *state, FlightLogPacket *pkt,
+                           uint64_t time_us, uint32_t frame_id,
+                           const uint8_t *data, uint32_t size);
+void FlightLog_BuildIndex(const FlightLogState *state, FlightLogPacket *pkt,
+                          uint64_t time_us);
+void FlightLog_BuildCommit(const FlightLogState *state, FlightLogPacket *pkt,
+                           uint64_t time_us);
+bool FlightLog_Commit(FlightLogState *state, const FlightLogPacket *pkt);
+void FlightLog_BuildTrailer(uint8_t *out, uint64_t index_offset);
+
+bool FlightLog_WritePacket(FILE *file, FlightLogState *state, const FlightLogPacket *pkt);
+
+/* 파싱 (메모리 버퍼) */
+bool FlightLog_ParseHeader(const uint8_t *p, uint64_t avail, FlightLogPacketHeader *hdr);
+bool FlightLog_VerifyPacket(const uint8_t *p, uint64_t avail, FlightLogPacketHeader *hdr);
+int64_t FlightLog_FindSync(const uint8_t *p, uint64_t len);
+bool FlightLog_ParseTrailer(const uint8_t *p, uint64_t *index_offset);
+
+bool FlightLog_DecodeTelemetry(const FlightLogPacketHeader *hdr, const uint8_t *body,
+                               LogEntry *entry);
+bool FlightLog_DecodeCamera(const FlightLogPacketHeader *hdr, const uint8_t *body,
+                            uint32_t *frame_id, const uint8_t **data, uint32_t *size);
+bool FlightLog_DecodeCommit(const FlightLogPacketHeader *hdr, const uint8_t *body,
+                            uint64_t *telemetry_packets, uint64_t *commit_offset);
+uint32_t FlightLog_DecodeIndex(const FlightLogPacketHeader *hdr, const uint8_t *body,
+                               FlightLogIndexEntry *out, uint32_t max);
+int64_t FlightLog_IndexLookup(const FlightLogIndexEntry *index, uint32_t count,
+                              uint64_t time_us);
+
+/* 파일 읽기 */
+FlightLogReader* FlightLogReader_Open(const char *filename);
+void FlightLogReader_Close(FlightLogReader *reader);
+bool FlightLogReader_Next(FlightLogReader *reader, FlightLogPacketHeader *hdr,
+                          const uint8_t **body);
+bool FlightLogReader_SeekTime(FlightLogReader *reader, uint64_t time_us);
+void FlightLogReader_Rewind(FlightLogReader *reader);
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef FLIGHT_LOG_MAP_H
+#define FLIGHT_LOG_MAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "flight_log.h"
+
+/* ============================================================
+ * 메모리 매핑 비행 로그 리더 (사후 분석용)
+ *
+ * 파일 전체를 mmap 하고 엔트리/카메라 데이터를 매핑 안의 뷰로 돌려준다.
+ * 열 때는 트레일러와 색인 패킷만 읽으며, 엔트리 i 는 색인 간격
+ * (PT_FLOG_INDEX_STRIDE) 안에서 패킷 헤더만 따라가 찾는다. 카메라
+ * 페이로드는 호출자가 실제로 접근할 때만 페이지 폴트로 읽힌다.
+ * ============================================================ */
+
+typedef enum {
+    FLOG_ACCESS_RANDOM = 0,             /* 기본: 미리 읽기 없음 */
+    FLOG_ACCESS_SEQUENTIAL,             /* 전체 순차 재생 */
+    FLOG_ACCESS_WILLNEED                /* 전체 미리 읽기 요청 */
+} FlightLogAccess;
+
+typedef struct {
+    uint64_t timestamp_us;
+    uint32_t entry_id;
+    uint32_t camera_frame_id;
+    uint8_t last_command_type;
+    float last_thrust_cmd;
+
+    const MissileTelemetryFrame *telemetry;  /* 매핑 내부 (리틀 엔디언 호스트) */
+    MissileTelemetryFrame storage;           /* 빅 엔디언 호스트용 변환 사본 */
+
+    uint64_t packet_offset;
+    uint64_t camera_offset;                  /* 0 = 카메라 패킷 없음 */
+} FlightLogEntryView;
+
+typedef struct {
+    int fd;
+    const uint8_t *base;
+    uint64_t size;
+    uint64_t data_end;
+    bool has_footer;
+
+    FlightLogIndexEntry *index;         /* PT_FLOG_INDEX_STRIDE 엔트리마다 */
+    uint32_t index_count;
+    uint32_t entry_count;
+} FlightLogMap;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+FlightLogMap* FlightLogMap_Open(const char *filename);
+void FlightLogMap_Close(FlightLogMap *map);
+void FlightLogMap_Advise(FlightLogMap *map, FlightLogAccess pattern);
+
+uint32_t FlightLogMap_GetEntryCount(const FlightLogMap *map);
+bool FlightLogMap_GetEntry(const FlightLogMap *map, uint32_t index,
+                           FlightLogEntryView *view);
+int64_t FlightLogMap_FindTime(const FlightLogMap *map, uint64_t time_us);
+uint32_t FlightLogMap_QueryRange(const FlightLogMap *map, uint64_t start_us,
+                                 uint64_t end_us, uint32_t *first);
+
+bool FlightLogMap_GetCamera(const FlightLogMap *map, const FlightLogEntryView *view,
+                            const uint8_t **data, uint32_t *size);
+bool FlightLogMap_VerifyCamera(const FlightLogMap *map, const FlightLogEntryView *view);
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef FRAME_PACKER_H
+#define FRAME_PACKER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "missile_telemetry.h"
+#include "ldpc_codec.h"
+
+/* ============================================================
+ * IRIGFIX_: 고정 - 정보 블록 레이아웃 (변경 금지)
+ * ============================================================ */
+
+/* 정보 블록 = [헤더 4바이트][페이로드 ...][0 패딩]
+ * 헤더: first_frame_offset (16비트) + payload_len (16비트), MSB 우선
+ * first_frame_offset: 이 블록에서 처음 시작하는 프레임의 페이로드 내 위치
+ *                     (이전 블록에서 넘어온 나머지 바이트 수와 같음) */
+#define IRIGFIX_PACKER_HEADER_BYTES 4
+#define IRIGFIX_PACKER_NO_FRAME_START 0xFFFF
+
+/* 블록당 최대 프레임 뷰 개수 (최대 K + 이월 프레임 1개) */
+#define FRAME_PACKER_MAX_FRAMES_PER_BLOCK \
+    ((IRIGFIX_LDPC_N / 8) / sizeof(MissileTelemetryFrame) + 2)
+
+/* ============================================================
+ * 패커 / 언패커 구조
+ * ============================================================ */
+
+typedef struct {
+    int info_bits;                      /* LDPC K (정보 비트 수) */
+    uint32_t payload_capacity;          /* 블록당 페이로드 바이트 */
+    uint32_t payload_len;               /* 현재 블록에 기록된 바이트 */
+    uint16_t first_frame_offset;        /* 현재 블록 헤더 값 */
+    uint32_t frame_offset;              /* 현재 레코드에서 이미 기록한 바이트 */
+    uint32_t record_len;                /* 현재 레코드 길이 */
+    bool block_ready;                   /* 블록 완성 (LDPC_Encode 대기) */
+
+    uint32_t frames_packed;
+    uint32_t blocks_packed;
+} FramePacker;
+
+typedef struct {
+    int info_bits;
+    uint32_t payload_capacity;
+
+    /* 블록 경계를 넘는 프레임 재조립 (이중 버퍼) */
+    MissileTelemetryFrame carry[2];
+    uint32_t carry_len;
+    int carry_index;
+
+    uint32_t frames_unpacked;
+    uint32_t frames_dropped;
+} FrameUnpacker;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+FramePacker* FramePacker_Create(int info_bits);
+void FramePacker_Destroy(FramePacker *packer);
+
+bool FramePacker_AddFrame(FramePacker *packer,
+                          const MissileTelemetryFrame *frame, uint8_t *info);
+bool FramePacker_AddRecord(FramePacker *packer, const uint8_t *record,
+                           uint32_t len, uint8_t *info);
+bool FramePacker_Flush(FramePacker *packer, uint8_t *info);
+bool FramePacker_IsBlockReady(FramePacker *packer);
+
+/* 고정 속도 링크: 송신 시각이 되면 빈 블록이라도 닫음 (완성된 블록은 이미 보낸 것으로 봄) */
+bool FramePacker_Close(FramePacker *packer, uint8_t *info);
+/* 닫힌 블록의 페이로드 뒤 남는 바이트 (0 패딩 자리) 와 그 자리에 쓰기 */
+uint32_t FramePacker_GetSpareBytes(const FramePacker *packer);
+bool FramePacker_WriteSpare(FramePacker *packer, uint8_t *info, uint32_t offset,
+                            const uint8_t *bytes, uint32_t len);
+
+FrameUnpacker* FrameUnpacker_Create(int info_bits);
+void FrameUnpacker_Destroy(FrameUnpacker *unpacker);
+
+const uint8_t* FrameUnpacker_UnpackPayload(FrameUnpacker *unpacker, uint8_t *decoded,
+                                           uint32_t *len, uint16_t *first_offset);
+int FrameUnpacker_Unpack(FrameUnpacker *unpacker, uint8_t *decoded,
+                         const MissileTelemetryFrame **views, int max_views);
+
+#endif
@@ -21,6 +21,12 @@
 
 #define IRIGFIX_COMMAND_HEADER 0xABCD
 
+/* 상향 링크 명령 프레임 (리틀 엔디언, 패딩 없음):
+ * [header u16][cmd_type u8][cmd_id u16][timestamp u32]
+ * [payload float × 3 (12)][crc u16 (CRC-16, 다항식 0xA001, 초기값 0, header ~ payload)] */
+#define IRIGFIX_COMMAND_WIRE_PAYLOAD 12
+#define IRIGFIX_COMMAND_WIRE_SIZE 23
+
 /* ============================================================
  * 명령 타입
  * ============================================================ */
@@ -91,14 +97,45 @@ typedef struct {
     
 } ControlState;
 
+/* ============================================================
+ * 상향 링크 스트림 역프레이머
+ *
+ * 임의로 잘린 수신 바이트열에서 헤더 (CD AB) 를 memchr 로 찾고, 고정
+ * 레이아웃을 수신 버퍼에서 바로 해석해 CRC / 명령 타입을 확인한다.
+ * 틀리면 한 바이트 뒤부터 다시 헤더를 찾는다 (재동기). 한 번의 호출로
+ * 버스트 안의 명령을 모두 콜백으로 넘기며, 끝에 걸친 부분 프레임
+ * (최대 22바이트) 만 다음 호출까지 보관한다.
+ * ============================================================ */
+
+typedef void (*GroundCommandFn)(void *context, const GroundControlCommand *cmd);
+
+typedef struct {
+    GroundCommandFn on_command;
+    void *context;
+
+    uint8_t carry[IRIGFIX_COMMAND_WIRE_SIZE];   /* 이전 호출 끝의 부분 프레임 */
+    uint32_t carry_len;
+    uint16_t crc_table[256];
+
+    /* 통계 */
+    uint64_t bytes_in;
+    uint64_t bytes_skipped;             /* 재동기로 버린 바이트 */
+    uint32_t commands;
+    uint32_t crc_errors;
+    uint32_t type_errors;               /* CRC 는 맞으나 모르는 명령 */
+} CommandDeframer;
+
 /* ============================================================
  * 함수 선언
  * ============================================================ */
 
+/* 구조체 그대로 memcpy (기존 경로, 컴파일러 패딩 포함) */
 bool GroundControl_ReceiveCommand(uint8_t *data, uint32_t len,
                                    GroundControlCommand *cmd);
 bool GroundControl_ProcessCommand(GroundControlCommand *cmd,
                                    ControlState *state);
+/* 검증이 끝난 명령 적용 (역프레이머 출력은 프레임 CRC 로 이미 검증됨) */
+bool GroundControl_ApplyCommand(const GroundControlCommand *cmd, ControlState *state);
 
 bool GroundControl_ValidateCommand(GroundControlCommand *cmd);
 bool GroundControl_ValidateCRC(GroundControlCommand *cmd);
@@ -112,4 +149,16 @@ void GroundControl_SetElevon(float angle);
 
 void GroundControl_CheckTimeout(ControlState *state);
 
+uint16_t GroundControl_CRC16(const uint8_t *data, uint32_t len);
+/* 지상측: 명령 → 23바이트 프레임 (header/crc 는 여기서 채움) */
+void GroundControl_EncodeCommand(const GroundControlCommand *cmd,
+                                 uint8_t out[IRIGFIX_COMMAND_WIRE_SIZE]);
+
+CommandDeframer* CommandDeframer_Create(GroundCommandFn on_command, void *context);
+void CommandDeframer_Destroy(CommandDeframer *deframer);
+void CommandDeframer_Reset(CommandDeframer *deframer);
+
+/* 수신 바이트 처리. 반환: 이번 호출에서 넘긴 명령 수 */
+int CommandDeframer_Push(CommandDeframer *deframer, const uint8_t *data, uint32_t len);
+
 #endif
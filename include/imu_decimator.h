@@ -0,0 +1,62 @@
+#ifndef IMU_DECIMATOR_H
+#define IMU_DECIMATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "missile_telemetry.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_IMU_OVERSAMPLE_RATE_HZ 16000
+#define PT_IMU_OUTPUT_RATE_HZ 1000
+#define PT_IMU_CIC_ORDER 3
+#define PT_IMU_CIC_DECIMATION 8             /* 16 kHz → 2 kHz */
+#define PT_IMU_FIR_DECIMATION 2             /* 2 kHz → 1 kHz */
+#define PT_IMU_FIR_TAPS 31                  /* 홀수 */
+#define PT_IMU_PASSBAND_HZ 350.0f
+
+#define PT_IMU_BURST_SAMPLES (PT_IMU_OVERSAMPLE_RATE_HZ / PT_IMU_OUTPUT_RATE_HZ)
+
+/* 6채널을 8레인 벡터로 처리 (2레인은 패딩) */
+#define IMU_DECIMATOR_LANES 8
+
+/* ============================================================
+ * 데시메이터 상태 (호출 간 유지)
+ * ============================================================ */
+
+typedef struct {
+    /* CIC: 적분기/콤 지연 (모듈로 2^32 연산) */
+    uint32_t integrator[PT_IMU_CIC_ORDER][IMU_DECIMATOR_LANES] __attribute__((aligned(32)));
+    uint32_t comb_delay[PT_IMU_CIC_ORDER][IMU_DECIMATOR_LANES] __attribute__((aligned(32)));
+    uint32_t cic_phase;
+
+    /* 보상 FIR: 지연선을 두 번 기록해 연속 창으로 읽음 */
+    float fir_taps[PT_IMU_FIR_TAPS];
+    float fir_history[2 * PT_IMU_FIR_TAPS][IMU_DECIMATOR_LANES] __attribute__((aligned(32)));
+    uint32_t fir_pos;
+    uint32_t fir_phase;
+
+    /* 출력 스케일 (CIC 이득 보정 × 공학 단위) */
+    float lane_scale[IMU_DECIMATOR_LANES] __attribute__((aligned(32)));
+
+    uint32_t samples_in;
+    uint32_t samples_out;
+} ImuDecimator;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+ImuDecimator* ImuDecimator_Create(void);
+void ImuDecimator_Destroy(ImuDecimator *dec);
+void ImuDecimator_Reset(ImuDecimator *dec);
+
+uint32_t ImuDecimator_Process(ImuDecimator *dec,
+                              const int16_t (*raw)[IRIGFIX_NUM_IMU_CHANNELS],
+                              uint32_t n,
+                              float (*out)[IRIGFIX_NUM_IMU_CHANNELS],
+                              uint32_t max_out);
+
+#endif
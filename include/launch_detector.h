@@ -0,0 +1,62 @@
+#ifndef LAUNCH_DETECTOR_H
+#define LAUNCH_DETECTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "telemetry_config.h"
+#include "telemetry_batch.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_LAUNCH_DETECTION_PERIOD_MS 100
+#define PT_LAUNCH_ACCEL_THRESHOLD_G 5.0f
+#define PT_LAUNCH_SUSTAINED_SAMPLES 10
+
+/* ConfigSet 파라미터 ID */
+#define LAUNCH_CONFIG_PARAM_THRESHOLD 2     /* float, g */
+#define LAUNCH_CONFIG_PARAM_SUSTAINED 5     /* int, 샘플 */
+
+/* ============================================================
+ * 발사 감지기 (인스턴스별 상태)
+ *
+ * |a|^2 > threshold^2 인 샘플이 sustained_samples 개 연속되면 발사로
+ * 확정한다. sqrtf 없이 제곱 크기를 비교하고, 블록 스캔은 8샘플
+ * 단위 벡터 비교로 처리한다. 발사 후에는 Reset 전까지 래치된다.
+ * ============================================================ */
+
+typedef struct {
+    float threshold_g;
+    float threshold_sq;
+    uint32_t sustained_samples;
+
+    uint32_t run_length;                /* 현재 연속 초과 샘플 수 */
+    uint64_t samples_seen;              /* Reset 이후 누적 샘플 수 */
+
+    bool launched;
+    uint64_t launch_index;              /* 연속 구간 첫 샘플 (누적 인덱스) */
+    uint64_t confirm_index;             /* 발사 확정 샘플 (누적 인덱스) */
+} LaunchDetector;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+LaunchDetector* LaunchDetector_Create(ConfigSet *config);
+void LaunchDetector_Destroy(LaunchDetector *det);
+void LaunchDetector_Reset(LaunchDetector *det);
+
+void LaunchDetector_Configure(LaunchDetector *det, float threshold_g,
+                              uint32_t sustained_samples);
+void LaunchDetector_ApplyConfig(LaunchDetector *det, ConfigSet *config);
+
+bool LaunchDetector_Update(LaunchDetector *det, float ax, float ay, float az);
+
+/* 반환: 발사 확정 샘플의 블록 내 위치, 미감지 (또는 이미 발사 상태) 시 -1 */
+int32_t LaunchDetector_ScanBlock(LaunchDetector *det, const float *ax,
+                                 const float *ay, const float *az, uint32_t n);
+int32_t LaunchDetector_ScanBatch(LaunchDetector *det, const TelemetryBatch *batch,
+                                 uint32_t start, uint32_t n);
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef LOG_PYRAMID_H
+#define LOG_PYRAMID_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "missile_telemetry.h"
+#include "telemetry_channels.h"
+#include "log_writer.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_ENABLE_LOG_PYRAMID 1
+#define PT_LOG_PYRAMID_FILENAME "flight_pyramid.tpy"
+#define PT_LOG_PYRAMID_MAX_POINTS 2000      /* 퀵룩 한 화면 기본 점 수 */
+
+/* ============================================================
+ * IRIGFIX_: 고정 - 감축 피라미드 파일 형식 (변경 금지)
+ *
+ * 로그 엔트리를 채널별로 10배씩 묶은 min/max/mean 단계 3개
+ * (10×, 100×, 1000×). 기록 중 증분 갱신하고 버킷이 찰 때마다 레코드
+ * 하나를 덧붙인다. 모든 필드는 리틀 엔디언.
+ *
+ * 파일 = [헤더 16][레코드 ...]      (레코드는 고정 크기, 단계가 섞여 있음)
+ * 헤더:   0 magic u32  4 version u16  6 levels u8  7 factor u8
+ *         8 channel_count u16  10 예약 u16  12 record_bytes u32
+ * 레코드: 0 level u8 (1..levels)  1 예약 u8[3]  4 samples u32
+ *         8 t_first u64  16 t_last u64
+ *        24 채널마다 min f32, max f32, mean f32
+ * samples = 버킷에 들어간 원본 엔트리 수 (마지막 부분 버킷은 작음).
+ * min/max/mean 은 NaN 을 제외한 값 (전부 NaN 이면 NaN).
+ * 같은 단계의 레코드는 시간 순서. 잘린 마지막 레코드는 무시한다.
+ * ============================================================ */
+
+#define IRIGFIX_PYRAMID_MAGIC 0x52595054    /* "TPYR" */
+#define IRIGFIX_PYRAMID_VERSION 1
+#define IRIGFIX_PYRAMID_LEVELS 3
+#define IRIGFIX_PYRAMID_FACTOR 10
+#define IRIGFIX_PYRAMID_HEADER_BYTES 16
+#define IRIGFIX_PYRAMID_RECORD_HEAD_BYTES 24
+#define IRIGFIX_PYRAMID_RECORD_BYTES \
+    (IRIGFIX_PYRAMID_RECORD_HEAD_BYTES + TELEMETRY_NUM_CHANNELS * 12)
+
+/* ============================================================
+ * 기록 측 (DataStorage 공개 경로에서 엔트리마다 호출)
+ * ============================================================ */
+
+typedef struct {
+    float min;
+    float max;
+    double sum;
+    uint32_t valid;                     /* NaN 이 아닌 값 수 */
+} PyramidAccum;
+
+typedef struct {
+    LogWriter *writer;                  /* 레코드 기록 스레드 (소유) */
+
+    PyramidAccum accum[IRIGFIX_PYRAMID_LEVELS][TELEMETRY_NUM_CHANNELS];
+    uint32_t fill[IRIGFIX_PYRAMID_LEVELS];      /* 채워진 하위 버킷 수 */
+    uint32_t samples[IRIGFIX_PYRAMID_LEVELS];   /* 원본 엔트리 수 */
+    uint64_t t_first[IRIGFIX_PYRAMID_LEVELS];
+    uint64_t t_last[IRIGFIX_PYRAMID_LEVELS];
+
+    uint8_t record[IRIGFIX_PYRAMID_RECORD_BYTES];
+    uint64_t entries;
+    uint32_t records[IRIGFIX_PYRAMID_LEVELS];
+    uint32_t records_dropped;           /* 기록 스레드 페이지 부족 */
+} LogPyramid;
+
+/* ============================================================
+ * 읽기 측 (퀵룩)
+ * ============================================================ */
+
+typedef struct {
+    uint64_t t_first;
+    uint64_t t_last;
+    uint32_t samples;
+    float min;
+    float max;
+    float mean;
+} PyramidPoint;
+
+typedef struct {
+    int fd;
+    const uint8_t *base;
+    uint64_t size;
+    uint32_t *records[IRIGFIX_PYRAMID_LEVELS];  /* 단계별 레코드 번호 (시간 순) */
+    uint32_t count[IRIGFIX_PYRAMID_LEVELS];
+} LogPyramidReader;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+LogPyramid* LogPyramid_Create(const char *filename);
+void LogPyramid_Destroy(LogPyramid *pyr);
+
+void LogPyramid_Add(LogPyramid *pyr, uint64_t timestamp_us,
+                    const MissileTelemetryFrame *frame);
+void LogPyramid_Finish(LogPyramid *pyr);
+
+LogPyramidReader* LogPyramidReader_Open(const char *filename);
+void LogPyramidReader_Close(LogPyramidReader *reader);
+
+uint32_t LogPyramidReader_Query(const LogPyramidReader *reader, int channel,
+                                uint64_t start_us, uint64_t end_us,
+                                uint32_t max_points, PyramidPoint *out,
+                                int *level);
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef LOG_QUERY_H
+#define LOG_QUERY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "telemetry_channels.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_LOG_QUERY_THREADS 4              /* 기본 병렬 청크 스레드 */
+#define PT_LOG_QUERY_CHUNK_INDEXES 64       /* 비행 로그 청크 = 색인 N개 (× PT_FLOG_INDEX_STRIDE 행) */
+#define PT_LOG_QUERY_LOOKAHEAD 4            /* 스레드당 출력 대기 청크 수 (메모리 상한) */
+#define PT_LOG_QUERY_MAX_NODES 64           /* 식 노드 수 상한 */
+
+/* ============================================================
+ * 로그 질의
+ *
+ * 필터 식: MissileTelemetryFrame 채널 이름 (채널 테이블) 과 숫자의
+ * 비교를 &&, ||, !, 괄호로 묶은 것.
+ *     temperature_c[3] > 85 && flight_mode == 2
+ *     !(battery_voltage >= 22.5) || accel_x_g > accel_y_g
+ * 비교: == != < <= > >=   (NaN 과의 비교는 != 만 참, C 와 같음)
+ *
+ * 입력: 비행 로그 컨테이너 (*.bin) 또는 열 저장 파일 (*.tmc).
+ * 파일을 청크로 나눠 스레드들이 병렬로 평가하고, 결과는 청크 순서대로
+ * 내보낸다. 열 저장 파일은 청크별 min/max 로 식이 참이 될 수 없는
+ * 청크를 본문을 읽지 않고 건너뛰며, 식과 출력에 쓰이는 열만 읽는다.
+ *
+ * 출력
+ *   CSV:    첫 줄 열 이름, 이후 일치한 행마다 한 줄
+ *   BINARY: 일치한 행마다 선택 열 값을 f64 리틀 엔디언으로 이어 붙임
+ * ============================================================ */
+
+typedef enum {
+    LOG_QUERY_FORMAT_CSV = 0,
+    LOG_QUERY_FORMAT_BINARY = 1,
+} LogQueryFormat;
+
+typedef enum {
+    LOG_QUERY_OP_EQ = 0,
+    LOG_QUERY_OP_NE,
+    LOG_QUERY_OP_LT,
+    LOG_QUERY_OP_LE,
+    LOG_QUERY_OP_GT,
+    LOG_QUERY_OP_GE,
+} LogQueryOp;
+
+typedef enum {
+    LOG_QUERY_NODE_CMP = 0,
+    LOG_QUERY_NODE_AND,
+    LOG_QUERY_NODE_OR,
+    LOG_QUERY_NODE_NOT,
+} LogQueryNodeKind;
+
+typedef struct {
+    int channel;                        /* -1 = 상수 */
+    double value;
+} LogQueryOperand;
+
+typedef struct {
+    LogQueryNodeKind kind;
+    LogQueryOp op;                      /* CMP */
+    LogQueryOperand a, b;               /* CMP */
+    int left, right;                    /* AND/OR (NOT 은 left 만) */
+} LogQueryNode;
+
+typedef struct {
+    LogQueryNode nodes[PT_LOG_QUERY_MAX_NODES];
+    int node_count;
+    int root;
+    bool uses[TELEMETRY_NUM_CHANNELS];  /* 식이 참조하는 채널 */
+} LogQueryExpr;
+
+typedef struct {
+    uint32_t threads;                   /* 0 = PT_LOG_QUERY_THREADS */
+    LogQueryFormat format;
+    const int *columns;                 /* 출력 채널 (NULL = 전체) */
+    int column_count;
+} LogQueryOptions;
+
+typedef struct {
+    uint32_t chunks_total;
+    uint32_t chunks_skipped;            /* min/max 로 건너뜀 */
+    uint64_t rows_scanned;
+    uint64_t rows_matched;
+} LogQueryStats;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+/* 식 파싱: 실패 시 false, err 에 위치와 이유 */
+bool LogQuery_Parse(const char *text, LogQueryExpr *expr, char *err, size_t err_len);
+
+/* values[c] 는 expr->uses[c] 인 채널만 채워져 있으면 됨 */
+bool LogQuery_Eval(const LogQueryExpr *expr, const double *values);
+
+/* 채널별 [min, max] 범위에서 식이 참일 수 있는지 (false 면 청크 건너뜀) */
+bool LogQuery_MayMatch(const LogQueryExpr *expr, const double *min, const double *max,
+                       const bool *has_stats);
+
+bool LogQuery_Run(const char *filename, const LogQueryExpr *expr,
+                  const LogQueryOptions *options, FILE *out, LogQueryStats *stats);
+
+#endif
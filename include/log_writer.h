@@ -0,0 +1,91 @@
+#ifndef LOG_WRITER_H
+#define LOG_WRITER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_LOG_WRITER_PAGE_SIZE (64 * 1024)     /* pwrite 단위 */
+#define PT_LOG_WRITER_NUM_PAGES 3               /* 삼중 버퍼 (최대 7) */
+#define PT_LOG_WRITER_SYNC_INTERVAL_MS 100      /* fdatasync 주기, 0 = 매 페이지 */
+#define PT_LOG_WRITER_FILENAME "flight_log.bin"
+
+#define LOG_WRITER_PAGE_ALIGN 4096
+#define LOG_WRITER_QUEUE_SIZE 8                 /* 2의 거듭제곱, > NUM_PAGES */
+
+/* ============================================================
+ * 페이지 / 단일 생산자-단일 소비자 큐
+ *
+ * 메인 루프 (생산자) 가 페이지를 채워 full 큐에 넣고, 기록 스레드
+ * (소비자) 가 pwrite 후 free 큐로 돌려준다. 두 큐 모두 락 없이
+ * head/tail 원자 변수만 사용한다.
+ * ============================================================ */
+
+typedef struct {
+    uint8_t *data;                      /* LOG_WRITER_PAGE_ALIGN 정렬 */
+    uint32_t len;
+    uint64_t file_offset;
+} LogWriterPage;
+
+typedef struct {
+    _Atomic uint32_t head;              /* 소비자 */
+    _Atomic uint32_t tail;              /* 생산자 */
+    uint32_t slots[LOG_WRITER_QUEUE_SIZE];
+} LogWriterQueue;
+
+/* 한 레코드를 이루는 조각 (헤더 + 페이로드 + 꼬리 등을 복사 없이 전달) */
+typedef struct {
+    const void *data;
+    uint32_t len;
+} LogWriterSpan;
+
+typedef struct {
+    int fd;
+    LogWriterPage pages[PT_LOG_WRITER_NUM_PAGES];
+    LogWriterQueue full_queue;
+    LogWriterQueue free_queue;
+
+    /* 생산자 측 */
+    int fill_page;                      /* -1 = 채우는 페이지 없음 */
+    uint64_t next_offset;
+
+    /* 기록 스레드 */
+    pthread_t thread;
+    sem_t wakeup;
+    _Atomic bool running;
+    _Atomic uint32_t sync_interval_ms;
+
+    /* 통계 */
+    _Atomic uint64_t bytes_written;
+    _Atomic uint32_t pages_written;
+    _Atomic uint32_t syncs;
+    _Atomic uint32_t write_errors;
+    uint64_t bytes_dropped;             /* 생산자 측: 빈 페이지 없음 */
+    uint32_t records_dropped;
+} LogWriter;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+LogWriter* LogWriter_Create(const char *filename, uint32_t sync_interval_ms);
+void LogWriter_Destroy(LogWriter *writer);
+
+bool LogWriter_Append(LogWriter *writer, const void *data, uint32_t len);
+bool LogWriter_AppendRecord(LogWriter *writer, const void *a, uint32_t a_len,
+                            const void *b, uint32_t b_len);
+bool LogWriter_AppendV(LogWriter *writer, const LogWriterSpan *spans, int count);
+bool LogWriter_AppendBlocking(LogWriter *writer, const LogWriterSpan *spans, int count);
+bool LogWriter_Flush(LogWriter *writer);
+void LogWriter_WaitIdle(LogWriter *writer);
+
+void LogWriter_SetSyncInterval(LogWriter *writer, uint32_t sync_interval_ms);
+uint64_t LogWriter_GetBytesWritten(LogWriter *writer);
+
+#endif
@@ -59,6 +59,8 @@ typedef struct {
     void *imu_handle;
     void *adc_handle;
     void *uart_handle;
+    void *launch_detector;              /* LaunchDetector (인스턴스별 상태) */
+    void *imu_decimator;                /* ImuDecimator (NULL 이면 단일 샘플 IMU) */
     
     MissileTelemetryFrame current_frame;
     uint8_t tx_buffer[16384];
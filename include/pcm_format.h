@@ -0,0 +1,100 @@
+#ifndef PCM_FORMAT_H
+#define PCM_FORMAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "missile_telemetry.h"
+#include "telemetry_channels.h"
+
+/* ============================================================
+ * IRIG 106 Chapter 4: PCM 마이너/메이저 프레임
+ * ============================================================ */
+
+/* IRIGFIX_: 고정 상수 (변경 금지) */
+#define IRIGFIX_PCM_SYNC_WORD 0xFE6B2840    /* 32비트 권장 프레임 동기 */
+#define IRIGFIX_PCM_SYNC_BYTES 4
+#define IRIGFIX_PCM_SFID_BYTES 1            /* 서브프레임 ID (0 ~ 메이저-1) */
+#define IRIGFIX_PCM_HEADER_BYTES (IRIGFIX_PCM_SYNC_BYTES + IRIGFIX_PCM_SFID_BYTES)
+#define IRIGFIX_PCM_MAX_MINOR_FRAMES 256    /* SFID 8비트 */
+
+/* PT_: 프로젝트 튜닝 */
+#define PT_PCM_SYNC_MAX_BIT_ERRORS 2
+
+/* ============================================================
+ * 포맷 기술
+ *
+ * decimation: 입력 프레임 (1 ms) 몇 개마다 한 번 샘플링하는지
+ *   decimation <  frames_per_minor → 슈퍼컴 (마이너 프레임당 여러 번)
+ *   decimation == frames_per_minor → 마이너 프레임당 1회
+ *   decimation >  frames_per_minor → 서브컴 (여러 마이너 프레임에 1회)
+ * 둘 중 하나가 다른 하나의 배수여야 한다.
+ * ============================================================ */
+
+typedef struct {
+    uint8_t channel;                    /* TelemetryChannels 인덱스 */
+    uint16_t decimation;
+} PCM_ChannelRate;
+
+typedef struct {
+    uint16_t frames_per_minor;
+    uint16_t num_channels;
+    const PCM_ChannelRate *channels;
+} PCM_FormatDesc;
+
+typedef struct {
+    uint16_t src_offset;                /* MissileTelemetryFrame 내 오프셋 */
+    uint16_t dst_offset;                /* 마이너 프레임 내 오프셋 */
+    uint8_t size;
+} PCM_Slot;
+
+typedef struct {
+    uint16_t frames_per_minor;
+    uint16_t minor_per_major;
+    uint32_t minor_frame_bytes;
+
+    /* 매 마이너 프레임 공통 슬롯 (샘플 번호별): fixed_start[s] ~ [s+1] */
+    PCM_Slot *fixed_slots;
+    uint32_t *fixed_start;
+
+    /* 서브컴 슬롯 (SFID별, 첫 샘플에서 채움): sub_start[m] ~ [m+1] */
+    PCM_Slot *sub_slots;
+    uint32_t *sub_start;
+} PCM_Layout;
+
+typedef struct {
+    PCM_Layout layout;
+    uint16_t current_sfid;
+    uint16_t current_sample;
+    uint32_t minor_frames_built;
+} PCM_Formatter;
+
+typedef struct {
+    PCM_Layout layout;
+    MissileTelemetryFrame held;         /* 서브컴 채널 샘플 유지값 */
+    int expected_sfid;
+    uint32_t minor_frames_decoded;
+    uint32_t sync_errors;
+    uint32_t sfid_errors;
+} PCM_Decommutator;
+
+extern const PCM_FormatDesc PCM_DefaultFormat;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+PCM_Formatter* PCM_Formatter_Create(const PCM_FormatDesc *desc);
+void PCM_Formatter_Destroy(PCM_Formatter *fmt);
+uint32_t PCM_Formatter_GetMinorFrameSize(PCM_Formatter *fmt);
+bool PCM_Formatter_PushFrame(PCM_Formatter *fmt,
+                             const MissileTelemetryFrame *frame,
+                             uint8_t *minor_frame);
+
+PCM_Decommutator* PCM_Decommutator_Create(const PCM_FormatDesc *desc);
+void PCM_Decommutator_Destroy(PCM_Decommutator *dec);
+int PCM_Decommutate(PCM_Decommutator *dec, const uint8_t *minor_frame,
+                    uint32_t len, MissileTelemetryFrame *out, int max_out);
+
+int PCM_FindSync(const uint8_t *stream, int len);
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "missile_telemetry.h"
+#include "frame_packer.h"
+#include "ldpc_codec.h"
+#include "soqpsk.h"
+#include "downlink_mux.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_REPLAY_LDPC_RATE LDPC_RATE_2_3
+#define PT_REPLAY_CARRIER_HZ 0.0f           /* 기저대역 */
+#define PT_REPLAY_SAMPLE_RATE_HZ 40.0e6f
+#define PT_REPLAY_SAMPLES_PER_SYMBOL 4
+#define PT_REPLAY_VIDEO_POOL_FRAMES 8       /* 로그 영상 → 다중화기 대기 (PT_MUX_VIDEO_QUEUE 이상) */
+
+/* ============================================================
+ * 기록 재생 송신 체인
+ *
+ * 저장된 비행 로그의 텔레메트리 프레임을 센서 대신 원천으로 사용해
+ * 프레임 패킹 → LDPC 부호화 → 랜덤화 → SOQPSK 변조를 그대로 통과시킨다.
+ * speed = 0 이면 CPU 가 허용하는 최대 속도, 그 외에는 기록 타임스탬프
+ * 기준 실시간의 speed 배로 맞춘다 (앞서면 대기, 뒤처지면 지연 기록).
+ *
+ * bit_hash 는 랜덤화된 코드워드 비트의 FNV-1a 해시로, 같은 로그와
+ * 설정이면 항상 같으므로 송신 체인 회귀 시험 기준값으로 쓴다.
+ *
+ * video = true 이면 고정 속도 링크 모드: 블록을 꽉 채워 보내는 대신
+ * 기록 시각 기준 코드워드 슬롯마다 DownlinkMux 로 블록을 만들고, 로그의
+ * 카메라 패킷을 여유 자리에 싣는다. 정보 블록은 지상측 언패커/재조립기로
+ * 되돌려 텔레메트리/영상 수신 수를 함께 보고한다.
+ * ============================================================ */
+
+typedef struct {
+    double speed;                       /* 0 = 최대 속도, 1 = 실시간, 10 = 10배 */
+    LDPC_CodeRate rate;
+    int samples_per_symbol;
+    uint32_t max_frames;                /* 0 = 전체 */
+    bool modulate;                      /* false = 변조 생략 (부호화까지만) */
+    bool video;                         /* 고정 속도 링크 + 영상 다중화 */
+} ReplayOptions;
+
+typedef struct {
+    uint64_t frames;
+    uint64_t codewords;
+    uint64_t samples;
+    uint64_t log_span_us;               /* 첫 프레임 ~ 마지막 프레임 기록 시간 */
+    uint64_t elapsed_us;                /* 재생 소요 시간 */
+    uint64_t pack_us, encode_us, randomize_us, modulate_us;
+    uint64_t max_lag_us;                /* 목표 시각 대비 최대 지연 (speed > 0) */
+    double frames_per_s;
+    double info_bits_per_s;             /* 정보 비트 처리율 */
+    double realtime_factor;             /* log_span / elapsed */
+    uint64_t bit_hash;
+
+    /* video 모드 */
+    uint32_t video_frames_submitted;
+    uint32_t video_frames_sent;
+    uint32_t video_frames_dropped;      /* 마감 초과 + 밀려남 */
+    uint32_t video_frames_received;     /* 지상측 재조립 완료 */
+    uint64_t video_bytes;
+    uint64_t telemetry_frames_received;
+    uint64_t telemetry_latency_max_us;
+} ReplayReport;
+
+typedef struct {
+    ReplayOptions options;
+    FramePacker *packer;
+    LDPC_Encoder *encoder;
+    SOQPSK_Modulator *modulator;
+
+    /* video 모드 */
+    DownlinkMux *mux;
+    DownlinkDemux *demux;
+    FrameUnpacker *unpacker;
+    CameraFramePool *video_pool;
+
+    uint8_t *info;                      /* K 비트 (비트당 1바이트) */
+    uint8_t *codeword;                  /* N 비트 */
+    uint8_t *randomized;
+    float_complex *samples;             /* N × samples_per_symbol */
+
+    ReplayReport report;
+} ReplayPipeline;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+void Replay_DefaultOptions(ReplayOptions *options);
+
+ReplayPipeline* Replay_Create(const ReplayOptions *options);
+void Replay_Destroy(ReplayPipeline *replay);
+
+/* 프레임 하나를 송신 체인에 넣음 (블록이 차면 부호화/변조까지) */
+void Replay_PushFrame(ReplayPipeline *replay, const MissileTelemetryFrame *frame);
+/* 남은 부분 블록을 패딩해 내보냄 */
+void Replay_Finish(ReplayPipeline *replay);
+
+/* 비행 로그 파일 전체 재생 */
+bool Replay_RunFile(ReplayPipeline *replay, const char *filename, ReplayReport *report);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef SENSOR_ACQUISITION_H
+#define SENSOR_ACQUISITION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "missile_telemetry.h"
+#include "telemetry_batch.h"
+#include "imu_decimator.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_IMU_ACCEL_FULL_SCALE_G 100.0f
+#define PT_IMU_GYRO_FULL_SCALE_DPS 2000.0f
+#define PT_PRESSURE_FULL_SCALE_PSI 10000.0f
+#define PT_THERMISTOR_R_FULL_SCALE 10000.0f /* ADC 풀스케일 저항 (Ω) */
+#define PT_THERMISTOR_MAX_TEMP_C 200.0f     /* 이 이상은 단락으로 보고 클램프 */
+#define PT_THERMISTOR_LUT_BITS 12           /* 4097 엔트리, 선형 보간 */
+
+/* Steinhart-Hart 계수 (10 kΩ NTC) */
+#define PT_THERMISTOR_SH_A 0.001129148f
+#define PT_THERMISTOR_SH_B 0.000234125f
+#define PT_THERMISTOR_SH_C 0.0000000876741f
+
+#define THERMISTOR_LUT_SIZE ((1 << PT_THERMISTOR_LUT_BITS) + 1)
+#define THERMISTOR_LUT_SHIFT (16 - PT_THERMISTOR_LUT_BITS)
+
+/* ============================================================
+ * DMA 블록 원시 샘플 (샘플 단위 인터리브)
+ * ============================================================ */
+
+typedef struct {
+    int16_t imu[IRIGFIX_NUM_IMU_CHANNELS];          /* ax ay az gx gy gz */
+    uint16_t pressure[IRIGFIX_NUM_PRESSURE_CHANNELS];
+    uint16_t temperature[IRIGFIX_NUM_TEMP_CHANNELS];
+} SensorRawSample;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+void Sensor_Init(void);
+float Sensor_ThermistorToCelsius(uint16_t adc);
+float Sensor_GetThermistorMaxError(void);
+
+uint32_t Sensor_ConvertBlock(const SensorRawSample *raw, uint32_t n,
+                             TelemetryBatch *batch, uint32_t start);
+
+void MissileTM_ReadSensorsOversampled(MissileTelemetrySystem *sys, ImuDecimator *dec);
+
+#endif
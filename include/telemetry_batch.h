@@ -0,0 +1,71 @@
+#ifndef TELEMETRY_BATCH_H
+#define TELEMETRY_BATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "missile_telemetry.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_TELEMETRY_BATCH_SIZE 64          /* 배치당 샘플 수 (8의 배수) */
+#define TELEMETRY_BATCH_ALIGN 64            /* 캐시 라인 / 벡터 정렬 */
+
+/* ============================================================
+ * 내부 처리용 정렬 SoA 배치
+ *
+ * MissileTelemetryFrame 은 packed 와이어 형식이라 필드가 비정렬이다.
+ * 처리 단계는 채널별로 연속·정렬된 이 배치를 사용하고, 전송/저장할
+ * 때만 TelemetryBatch_ToWire 로 packed 형식으로 변환한다.
+ * ============================================================ */
+
+#define BATCH_COLUMN __attribute__((aligned(TELEMETRY_BATCH_ALIGN)))
+
+typedef struct {
+    uint32_t count;
+
+    uint32_t frame_counter[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    uint64_t timestamp_us[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+
+    float accel_x_g[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    float accel_y_g[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    float accel_z_g[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    float gyro_x_dps[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    float gyro_y_dps[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    float gyro_z_dps[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+
+    float pressure_psi[IRIGFIX_NUM_PRESSURE_CHANNELS][PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    float temperature_c[IRIGFIX_NUM_TEMP_CHANNELS][PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+
+    float guidance_cmd[IRIGFIX_NUM_GUIDANCE_CHANNELS][PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    float actuator_pos[IRIGFIX_NUM_GUIDANCE_CHANNELS][PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    uint8_t flight_mode[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+
+    double latitude[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    double longitude[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    float altitude_m[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+
+    float battery_voltage[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    uint16_t system_status[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+    uint16_t crc16[PT_TELEMETRY_BATCH_SIZE] BATCH_COLUMN;
+
+} TelemetryBatch;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+TelemetryBatch* TelemetryBatch_Create(void);
+void TelemetryBatch_Destroy(TelemetryBatch *batch);
+void TelemetryBatch_Clear(TelemetryBatch *batch);
+
+bool TelemetryBatch_IsFull(const TelemetryBatch *batch);
+bool TelemetryBatch_Append(TelemetryBatch *batch, const MissileTelemetryFrame *frame);
+
+uint32_t TelemetryBatch_FromWire(TelemetryBatch *batch,
+                                 const MissileTelemetryFrame *frames, uint32_t n);
+uint32_t TelemetryBatch_ToWire(const TelemetryBatch *batch, uint32_t start,
+                               MissileTelemetryFrame *frames, uint32_t n);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef TELEMETRY_CHANNELS_H
+#define TELEMETRY_CHANNELS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "missile_telemetry.h"
+
+/* ============================================================
+ * MissileTelemetryFrame 채널 테이블
+ *
+ * 프레임의 각 스칼라 필드 (배열은 원소 단위) 를 이름/오프셋/크기/타입
+ * 으로 기술한다. PCM 포맷터, 압축 코덱, 내보내기/질의 도구가 공용으로
+ * 사용한다.
+ * ============================================================ */
+
+#define TELEMETRY_NUM_CHANNELS \
+    (2 + IRIGFIX_NUM_IMU_CHANNELS + IRIGFIX_NUM_PRESSURE_CHANNELS + \
+     IRIGFIX_NUM_TEMP_CHANNELS + 2 * IRIGFIX_NUM_GUIDANCE_CHANNELS + 7)
+
+typedef enum {
+    CHANNEL_TYPE_U8 = 0,
+    CHANNEL_TYPE_U16 = 1,
+    CHANNEL_TYPE_U32 = 2,
+    CHANNEL_TYPE_U64 = 3,
+    CHANNEL_TYPE_F32 = 4,
+    CHANNEL_TYPE_F64 = 5,
+} TelemetryChannelType;
+
+typedef struct {
+    const char *name;                   /* 예: "temperature_c[3]" */
+    uint16_t offset;                    /* 프레임 내 바이트 오프셋 */
+    uint8_t size;                       /* 바이트 크기 */
+    TelemetryChannelType type;
+} TelemetryChannelDesc;
+
+extern const TelemetryChannelDesc TelemetryChannels[TELEMETRY_NUM_CHANNELS];
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+int TelemetryChannels_Find(const char *name);
+double TelemetryChannels_GetValue(const MissileTelemetryFrame *frame, int channel);
+bool TelemetryChannels_IsFloat(int channel);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef TELEMETRY_CODEC_H
+#define TELEMETRY_CODEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "missile_telemetry.h"
+#include "telemetry_channels.h"
+
+/* ============================================================
+ * PT_: 프로젝트 튜닝
+ * ============================================================ */
+
+#define PT_CODEC_ENABLE 1
+#define PT_CODEC_KEYFRAME_INTERVAL 100      /* 100 ms 마다 키프레임 */
+
+/* ============================================================
+ * IRIGFIX_: 고정 - 레코드 형식 (변경 금지)
+ *
+ * 레코드 = [마커][플래그][순번][본문 길이 u16 LE][XOR 검사] + 본문
+ * 본문   = 8채널 그룹마다 [폭 7비트][값 8개 × 폭 비트] (LSB 우선)
+ * 값     = 이전 샘플과의 차분 (채널 비트폭 모듈로) 의 지그재그
+ * ============================================================ */
+
+#define IRIGFIX_CODEC_MARKER 0xC5
+#define IRIGFIX_CODEC_FLAG_KEYFRAME 0x80
+#define IRIGFIX_CODEC_HEADER_BYTES 6
+#define IRIGFIX_CODEC_GROUP_SIZE 8
+#define IRIGFIX_CODEC_WIDTH_BITS 7
+
+#define TELEMETRY_CODEC_NUM_GROUPS \
+    ((TELEMETRY_NUM_CHANNELS + IRIGFIX_CODEC_GROUP_SIZE - 1) / IRIGFIX_CODEC_GROUP_SIZE)
+#define TELEMETRY_CODEC_PADDED_CHANNELS \
+    (TELEMETRY_CODEC_NUM_GROUPS * IRIGFIX_CODEC_GROUP_SIZE)
+
+/* 최악: 모든 그룹이 폭 64 (키프레임에서 64비트 채널이 섞인 그룹) */
+#define TELEMETRY_CODEC_MAX_BODY_BYTES \
+    ((TELEMETRY_CODEC_NUM_GROUPS * \
+      (IRIGFIX_CODEC_WIDTH_BITS + IRIGFIX_CODEC_GROUP_SIZE * 64) + 7) / 8)
+#define TELEMETRY_CODEC_MAX_RECORD_BYTES \
+    (IRIGFIX_CODEC_HEADER_BYTES + TELEMETRY_CODEC_MAX_BODY_BYTES)
+
+/* ============================================================
+ * 코덱 상태
+ * ============================================================ */
+
+typedef struct {
+    /* 채널별 이전 값 (채널 비트폭으로 마스크된 원시 비트) */
+    uint64_t prev[TELEMETRY_CODEC_PADDED_CHANNELS] __attribute__((aligned(64)));
+    uint64_t mask[TELEMETRY_CODEC_PADDED_CHANNELS] __attribute__((aligned(64)));
+
+    uint32_t keyframe_interval;
+    uint32_t frames_since_keyframe;
+    uint8_t sequence;
+    bool synced;                        /* 디코더: 키프레임 수신 후 true */
+
+    uint32_t records;
+    uint32_t raw_bytes;
+    uint32_t coded_bytes;
+    uint32_t records_skipped;           /* 디코더: 동기 상실 중 버린 레코드 */
+} TelemetryCodec;
+
+/* ============================================================
+ * 함수 선언
+ * ============================================================ */
+
+TelemetryCodec* TelemetryCodec_Create(uint32_t keyframe_interval);
+void TelemetryCodec_Destroy(TelemetryCodec *codec);
+void TelemetryCodec_ForceKeyframe(TelemetryCodec *codec);
+
+int TelemetryCodec_Encode(TelemetryCodec *codec,
+                          const MissileTelemetryFrame *frame,
+                          uint8_t *out, uint32_t capacity);
+
+bool TelemetryCodec_Decode(TelemetryCodec *codec, const uint8_t *in,
+                           uint32_t len, uint32_t *consumed,
+                           MissileTelemetryFrame *frame);
+int TelemetryCodec_DecodeStream(TelemetryCodec *codec, const uint8_t *in,
+                                uint32_t len, uint32_t *consumed,
+                                MissileTelemetryFrame *frames, int max_frames);
+
+#endif
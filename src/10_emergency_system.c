@@ -7,6 +7,28 @@
  * 긴급 정지 및 자폭 시스템 구현
  * ============================================================ */
 
+static BlackBox *g_black_box = NULL;
+
+void EmergencySystem_SetBlackBox(BlackBox *bb)
+{
+    g_black_box = bb;
+}
+
+/* 안전 조치 직후, 정지 루프에 들어가기 전에 최근 구간 기록 */
+static void flush_black_box(void)
+{
+    if (!g_black_box) return;
+    
+    BlackBoxReport report;
+    if (BlackBox_Flush(g_black_box, &report)) {
+        printf("[EMERGENCY] 블랙박스 기록: 엔트리 %u개, %u us (%s)\n",
+               report.entries, report.total_us,
+               report.within_deadline ? "제한 이내" : "제한 초과");
+    } else {
+        printf("[EMERGENCY] 블랙박스 기록 실패\n");
+    }
+}
+
 EmergencyState* EmergencySystem_Init(void)
 {
     EmergencyState *state = malloc(sizeof(EmergencyState));
@@ -81,6 +103,8 @@ void EmergencySystem_Terminate(void)
     printf("[EMERGENCY] 낙하산 배포...\n");
     printf("[EMERGENCY] Safe Mode 진입\n");
     
+    flush_black_box();
+    
     while (1) {
         /* Safe Mode 유지 */
     }
@@ -89,6 +113,7 @@ void EmergencySystem_Terminate(void)
 void EmergencySystem_SelfDestruct(void)
 {
     printf("[EMERGENCY] 자폭 시스템 활성화...\n");
+    flush_black_box();
     printf("[EMERGENCY] %d ms 대기 중...\n", PT_SELF_DESTRUCT_CHARGE_DELAY_MS);
     printf("[EMERGENCY] 폭발!!!\n");
     
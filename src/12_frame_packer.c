@@ -0,0 +1,297 @@
+#include "frame_packer.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * 텔레메트리 프레임 → LDPC 정보 블록 패킹 구현
+ *
+ * LDPC_Encode 의 info 는 비트당 1바이트 (0/1) 이므로 프레임 바이트를
+ * 중간 버퍼 없이 바로 비트로 펼쳐서 기록한다. 블록에 다 들어가지
+ * 않는 프레임은 다음 블록으로 이월된다.
+ * ============================================================ */
+
+#define FRAME_SIZE ((uint32_t)sizeof(MissileTelemetryFrame))
+
+static void write_bytes_as_bits(uint8_t *bits, const uint8_t *bytes, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        uint8_t b = bytes[i];
+        for (int k = 0; k < 8; k++) {
+            bits[i * 8 + k] = (b >> (7 - k)) & 1;
+        }
+    }
+}
+
+static void write_u16_as_bits(uint8_t *bits, uint16_t value)
+{
+    uint8_t bytes[2] = { (uint8_t)(value >> 8), (uint8_t)value };
+    write_bytes_as_bits(bits, bytes, 2);
+}
+
+static void close_block(FramePacker *packer, uint8_t *info)
+{
+    /* 남은 비트는 0 패딩 */
+    uint32_t used_bits = (IRIGFIX_PACKER_HEADER_BYTES + packer->payload_len) * 8;
+    memset(info + used_bits, 0, packer->info_bits - used_bits);
+
+    write_u16_as_bits(info, packer->first_frame_offset);
+    write_u16_as_bits(info + 16, (uint16_t)packer->payload_len);
+
+    packer->block_ready = true;
+    packer->blocks_packed++;
+}
+
+static void open_block(FramePacker *packer)
+{
+    packer->payload_len = 0;
+    packer->block_ready = false;
+
+    if (packer->frame_offset == 0) {
+        packer->first_frame_offset = 0;
+    } else {
+        uint32_t remaining = packer->record_len - packer->frame_offset;
+        packer->first_frame_offset = (remaining < packer->payload_capacity)
+                                     ? (uint16_t)remaining
+                                     : IRIGFIX_PACKER_NO_FRAME_START;
+    }
+}
+
+FramePacker* FramePacker_Create(int info_bits)
+{
+    if (info_bits < (IRIGFIX_PACKER_HEADER_BYTES + 1) * 8) return NULL;
+
+    FramePacker *packer = malloc(sizeof(FramePacker));
+    if (!packer) return NULL;
+
+    packer->info_bits = info_bits;
+    packer->payload_capacity = info_bits / 8 - IRIGFIX_PACKER_HEADER_BYTES;
+    packer->frame_offset = 0;
+    packer->record_len = 0;
+    packer->frames_packed = 0;
+    packer->blocks_packed = 0;
+    open_block(packer);
+
+    return packer;
+}
+
+void FramePacker_Destroy(FramePacker *packer)
+{
+    if (packer) free(packer);
+}
+
+bool FramePacker_AddFrame(FramePacker *packer,
+                          const MissileTelemetryFrame *frame, uint8_t *info)
+{
+    return FramePacker_AddRecord(packer, (const uint8_t *)frame, FRAME_SIZE, info);
+}
+
+bool FramePacker_AddRecord(FramePacker *packer, const uint8_t *record,
+                           uint32_t len, uint8_t *info)
+{
+    if (!packer || !record || !info || len == 0) return false;
+
+    /* 이전 블록은 호출자가 이미 인코딩했다고 본다 */
+    if (packer->block_ready) {
+        open_block(packer);
+    }
+
+    packer->record_len = len;
+
+    uint32_t space = packer->payload_capacity - packer->payload_len;
+    uint32_t remaining = len - packer->frame_offset;
+    uint32_t n = (remaining < space) ? remaining : space;
+
+    uint8_t *dst = info + (IRIGFIX_PACKER_HEADER_BYTES + packer->payload_len) * 8;
+    write_bytes_as_bits(dst, record + packer->frame_offset, n);
+
+    packer->payload_len += n;
+    packer->frame_offset += n;
+
+    bool done = (packer->frame_offset == len);
+    if (done) {
+        packer->frame_offset = 0;
+        packer->frames_packed++;
+    }
+
+    if (packer->payload_len == packer->payload_capacity) {
+        close_block(packer, info);
+    }
+
+    return done;
+}
+
+bool FramePacker_Flush(FramePacker *packer, uint8_t *info)
+{
+    if (!packer || !info) return false;
+    if (packer->block_ready) return true;
+    if (packer->payload_len == 0) return false;
+
+    close_block(packer, info);
+    return true;
+}
+
+bool FramePacker_IsBlockReady(FramePacker *packer)
+{
+    if (!packer) return false;
+    return packer->block_ready;
+}
+
+bool FramePacker_Close(FramePacker *packer, uint8_t *info)
+{
+    if (!packer || !info) return false;
+
+    if (packer->block_ready) {
+        open_block(packer);
+    }
+    close_block(packer, info);
+    return true;
+}
+
+uint32_t FramePacker_GetSpareBytes(const FramePacker *packer)
+{
+    if (!packer || !packer->block_ready) return 0;
+    return packer->payload_capacity - packer->payload_len;
+}
+
+/* 여유 자리는 수신측 FrameUnpacker 가 무시하므로 다른 데이터를 실을 수 있다 */
+bool FramePacker_WriteSpare(FramePacker *packer, uint8_t *info, uint32_t offset,
+                            const uint8_t *bytes, uint32_t len)
+{
+    if (!packer || !info || !bytes) return false;
+    if (offset + len > FramePacker_GetSpareBytes(packer)) return false;
+
+    uint32_t start = IRIGFIX_PACKER_HEADER_BYTES + packer->payload_len + offset;
+    write_bytes_as_bits(info + start * 8, bytes, len);
+    return true;
+}
+
+/* ============================================================
+ * 수신측 언패킹
+ * ============================================================ */
+
+FrameUnpacker* FrameUnpacker_Create(int info_bits)
+{
+    if (info_bits < (IRIGFIX_PACKER_HEADER_BYTES + 1) * 8) return NULL;
+
+    FrameUnpacker *unpacker = malloc(sizeof(FrameUnpacker));
+    if (!unpacker) return NULL;
+
+    unpacker->info_bits = info_bits;
+    unpacker->payload_capacity = info_bits / 8 - IRIGFIX_PACKER_HEADER_BYTES;
+    unpacker->carry_len = 0;
+    unpacker->carry_index = 0;
+    unpacker->frames_unpacked = 0;
+    unpacker->frames_dropped = 0;
+
+    return unpacker;
+}
+
+void FrameUnpacker_Destroy(FrameUnpacker *unpacker)
+{
+    if (unpacker) free(unpacker);
+}
+
+/* 비트당 1바이트 버퍼를 같은 버퍼의 앞쪽에 바이트로 압축
+ * (쓰기 위치 i 는 항상 읽기 위치 8i 이하이므로 제자리 변환 가능) */
+static void compact_bits_in_place(uint8_t *buf, uint32_t nbytes)
+{
+    for (uint32_t i = 0; i < nbytes; i++) {
+        const uint8_t *b = buf + i * 8;
+        buf[i] = (uint8_t)((b[0] << 7) | (b[1] << 6) | (b[2] << 5) | (b[3] << 4) |
+                           (b[4] << 3) | (b[5] << 2) | (b[6] << 1) | b[7]);
+    }
+}
+
+static void emit_view(FrameUnpacker *unpacker, const MissileTelemetryFrame *frame,
+                      const MissileTelemetryFrame **views, int max_views, int *count)
+{
+    if (*count < max_views) {
+        views[(*count)++] = frame;
+        unpacker->frames_unpacked++;
+    } else {
+        unpacker->frames_dropped++;
+    }
+}
+
+const uint8_t* FrameUnpacker_UnpackPayload(FrameUnpacker *unpacker, uint8_t *decoded,
+                                           uint32_t *len, uint16_t *first_offset)
+{
+    if (!unpacker || !decoded || !len || !first_offset) return NULL;
+
+    compact_bits_in_place(decoded, unpacker->info_bits / 8);
+
+    *first_offset = (uint16_t)((decoded[0] << 8) | decoded[1]);
+    *len = (uint32_t)((decoded[2] << 8) | decoded[3]);
+
+    if (*len > unpacker->payload_capacity) return NULL;
+    return decoded + IRIGFIX_PACKER_HEADER_BYTES;
+}
+
+int FrameUnpacker_Unpack(FrameUnpacker *unpacker, uint8_t *decoded,
+                         const MissileTelemetryFrame **views, int max_views)
+{
+    if (!unpacker || !decoded || !views) return 0;
+
+    uint16_t first;
+    uint32_t len;
+    const uint8_t *payload = FrameUnpacker_UnpackPayload(unpacker, decoded,
+                                                         &len, &first);
+
+    if (!payload) {
+        /* 헤더 손상: 이월 프레임도 신뢰할 수 없음 */
+        if (unpacker->carry_len > 0) unpacker->frames_dropped++;
+        unpacker->carry_len = 0;
+        return 0;
+    }
+
+    int count = 0;
+    uint32_t pos = 0;
+
+    /* 이전 블록에서 넘어온 프레임 이어붙이기 */
+    if (unpacker->carry_len > 0) {
+        uint32_t need = FRAME_SIZE - unpacker->carry_len;
+        /* 패커는 남은 바이트가 블록을 정확히 채울 때도 NO_FRAME_START 를 쓴다 */
+        bool continues = (first == IRIGFIX_PACKER_NO_FRAME_START)
+                         ? (need >= len)
+                         : (first == need && need <= len);
+
+        if (continues) {
+            uint32_t take = (need < len) ? need : len;
+            uint8_t *dst = (uint8_t *)&unpacker->carry[unpacker->carry_index];
+            memcpy(dst + unpacker->carry_len, payload, take);
+            unpacker->carry_len += take;
+            pos = take;
+
+            if (unpacker->carry_len == FRAME_SIZE) {
+                emit_view(unpacker, &unpacker->carry[unpacker->carry_index],
+                          views, max_views, &count);
+                unpacker->carry_len = 0;
+                unpacker->carry_index ^= 1;
+            } else {
+                return count;
+            }
+        } else {
+            /* 중간 코드워드 손실 → 이월 프레임 폐기 */
+            unpacker->carry_len = 0;
+            unpacker->frames_dropped++;
+        }
+    }
+
+    if (first == IRIGFIX_PACKER_NO_FRAME_START) return count;
+    pos = first;
+
+    /* 블록 안에 완전히 들어있는 프레임은 복호 버퍼를 직접 가리킴 */
+    while (pos + FRAME_SIZE <= len) {
+        emit_view(unpacker, (const MissileTelemetryFrame *)(payload + pos),
+                  views, max_views, &count);
+        pos += FRAME_SIZE;
+    }
+
+    if (pos < len) {
+        uint8_t *dst = (uint8_t *)&unpacker->carry[unpacker->carry_index];
+        unpacker->carry_len = len - pos;
+        memcpy(dst, payload + pos, unpacker->carry_len);
+    }
+
+    return count;
+}
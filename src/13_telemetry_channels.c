@@ -0,0 +1,91 @@
+#include "telemetry_channels.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ============================================================
+ * 채널 테이블 정의
+ * ============================================================ */
+
+#define CH(name, field, type) \
+    { name, offsetof(MissileTelemetryFrame, field), \
+      sizeof(((MissileTelemetryFrame *)0)->field), type }
+
+#define CH4(base, field, type) \
+    CH(base "[0]", field[0], type), CH(base "[1]", field[1], type), \
+    CH(base "[2]", field[2], type), CH(base "[3]", field[3], type)
+
+#define CH8(base, field, type) \
+    CH4(base, field, type), \
+    CH(base "[4]", field[4], type), CH(base "[5]", field[5], type), \
+    CH(base "[6]", field[6], type), CH(base "[7]", field[7], type)
+
+#define CH16(base, field, type) \
+    CH8(base, field, type), \
+    CH(base "[8]", field[8], type), CH(base "[9]", field[9], type), \
+    CH(base "[10]", field[10], type), CH(base "[11]", field[11], type), \
+    CH(base "[12]", field[12], type), CH(base "[13]", field[13], type), \
+    CH(base "[14]", field[14], type), CH(base "[15]", field[15], type)
+
+const TelemetryChannelDesc TelemetryChannels[TELEMETRY_NUM_CHANNELS] = {
+    CH("frame_counter", frame_counter, CHANNEL_TYPE_U32),
+    CH("timestamp_us", timestamp_us, CHANNEL_TYPE_U64),
+
+    CH("accel_x_g", accel_x_g, CHANNEL_TYPE_F32),
+    CH("accel_y_g", accel_y_g, CHANNEL_TYPE_F32),
+    CH("accel_z_g", accel_z_g, CHANNEL_TYPE_F32),
+    CH("gyro_x_dps", gyro_x_dps, CHANNEL_TYPE_F32),
+    CH("gyro_y_dps", gyro_y_dps, CHANNEL_TYPE_F32),
+    CH("gyro_z_dps", gyro_z_dps, CHANNEL_TYPE_F32),
+
+    CH4("pressure_psi", pressure_psi, CHANNEL_TYPE_F32),
+    CH8("temperature_c", temperature_c, CHANNEL_TYPE_F32),
+    CH16("guidance_cmd", guidance_cmd, CHANNEL_TYPE_F32),
+    CH16("actuator_pos", actuator_pos, CHANNEL_TYPE_F32),
+
+    CH("flight_mode", flight_mode, CHANNEL_TYPE_U8),
+    CH("latitude", latitude, CHANNEL_TYPE_F64),
+    CH("longitude", longitude, CHANNEL_TYPE_F64),
+    CH("altitude_m", altitude_m, CHANNEL_TYPE_F32),
+    CH("battery_voltage", battery_voltage, CHANNEL_TYPE_F32),
+    CH("system_status", system_status, CHANNEL_TYPE_U16),
+    CH("crc16", crc16, CHANNEL_TYPE_U16),
+};
+
+int TelemetryChannels_Find(const char *name)
+{
+    if (!name) return -1;
+
+    for (int i = 0; i < TELEMETRY_NUM_CHANNELS; i++) {
+        if (strcmp(TelemetryChannels[i].name, name) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+double TelemetryChannels_GetValue(const MissileTelemetryFrame *frame, int channel)
+{
+    if (!frame || channel < 0 || channel >= TELEMETRY_NUM_CHANNELS) return 0.0;
+
+    const TelemetryChannelDesc *ch = &TelemetryChannels[channel];
+    const uint8_t *src = (const uint8_t *)frame + ch->offset;
+
+    switch (ch->type) {
+        case CHANNEL_TYPE_U8:  { uint8_t v;  memcpy(&v, src, 1); return v; }
+        case CHANNEL_TYPE_U16: { uint16_t v; memcpy(&v, src, 2); return v; }
+        case CHANNEL_TYPE_U32: { uint32_t v; memcpy(&v, src, 4); return v; }
+        case CHANNEL_TYPE_U64: { uint64_t v; memcpy(&v, src, 8); return (double)v; }
+        case CHANNEL_TYPE_F32: { float v;    memcpy(&v, src, 4); return v; }
+        case CHANNEL_TYPE_F64: { double v;   memcpy(&v, src, 8); return v; }
+    }
+
+    return 0.0;
+}
+
+bool TelemetryChannels_IsFloat(int channel)
+{
+    if (channel < 0 || channel >= TELEMETRY_NUM_CHANNELS) return false;
+    return TelemetryChannels[channel].type == CHANNEL_TYPE_F32 ||
+           TelemetryChannels[channel].type == CHANNEL_TYPE_F64;
+}
@@ -0,0 +1,382 @@
+#include "pcm_format.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * IRIG 106 Chapter 4 PCM 포맷터 / 디커뮤테이터 구현
+ *
+ * 마이너 프레임 = [동기 32비트][SFID][공통 워드...][서브컴 워드...][0 패딩]
+ * 워드는 MSB 우선으로 전송한다.
+ * ============================================================ */
+
+#define CHANNEL_COUNT(arr) ((uint16_t)(sizeof(arr) / sizeof((arr)[0])))
+
+/* 기본 포맷: 2 ms 마이너 프레임, IMU/유도는 1 kHz, 온도/GPS 는 5~10 Hz */
+static const PCM_ChannelRate default_channels[] = {
+    {  0, 1 },   /* frame_counter */
+    {  1, 1 },   /* timestamp_us */
+    {  2, 1 }, {  3, 1 }, {  4, 1 },            /* accel */
+    {  5, 1 }, {  6, 1 }, {  7, 1 },            /* gyro */
+    {  8, 2 }, {  9, 2 }, { 10, 2 }, { 11, 2 }, /* pressure */
+    { 12, 200 }, { 13, 200 }, { 14, 200 }, { 15, 200 },  /* temperature */
+    { 16, 200 }, { 17, 200 }, { 18, 200 }, { 19, 200 },
+    { 20, 1 }, { 21, 1 }, { 22, 1 }, { 23, 1 },  /* guidance_cmd */
+    { 24, 1 }, { 25, 1 }, { 26, 1 }, { 27, 1 },
+    { 28, 1 }, { 29, 1 }, { 30, 1 }, { 31, 1 },
+    { 32, 1 }, { 33, 1 }, { 34, 1 }, { 35, 1 },
+    { 36, 1 }, { 37, 1 }, { 38, 1 }, { 39, 1 },  /* actuator_pos */
+    { 40, 1 }, { 41, 1 }, { 42, 1 }, { 43, 1 },
+    { 44, 1 }, { 45, 1 }, { 46, 1 }, { 47, 1 },
+    { 48, 1 }, { 49, 1 }, { 50, 1 }, { 51, 1 },
+    { 52, 10 },  /* flight_mode */
+    { 53, 200 }, { 54, 200 },  /* latitude, longitude */
+    { 55, 100 }, /* altitude_m */
+    { 56, 200 }, /* battery_voltage */
+    { 57, 10 },  /* system_status */
+};
+
+const PCM_FormatDesc PCM_DefaultFormat = {
+    .frames_per_minor = 2,
+    .num_channels = CHANNEL_COUNT(default_channels),
+    .channels = default_channels,
+};
+
+/* ============================================================
+ * 레이아웃 생성 (포맷터/디커뮤테이터 공용)
+ * ============================================================ */
+
+static uint32_t gcd_u32(uint32_t a, uint32_t b)
+{
+    while (b) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+static void layout_free(PCM_Layout *layout)
+{
+    free(layout->fixed_slots);
+    free(layout->fixed_start);
+    free(layout->sub_slots);
+    free(layout->sub_start);
+}
+
+static bool layout_build(PCM_Layout *layout, const PCM_FormatDesc *desc)
+{
+    memset(layout, 0, sizeof(PCM_Layout));
+    if (!desc || !desc->channels || desc->frames_per_minor == 0) return false;
+    if (desc->num_channels > 256) return false;
+
+    uint32_t fpm = desc->frames_per_minor;
+    uint32_t major = 1;
+    uint32_t fixed_count = 0;
+    uint32_t fixed_bytes = IRIGFIX_PCM_HEADER_BYTES;
+
+    for (uint16_t i = 0; i < desc->num_channels; i++) {
+        const PCM_ChannelRate *ch = &desc->channels[i];
+        if (ch->channel >= TELEMETRY_NUM_CHANNELS || ch->decimation == 0) return false;
+
+        if (ch->decimation <= fpm) {
+            if (fpm % ch->decimation != 0) return false;
+            fixed_count += fpm / ch->decimation;
+            fixed_bytes += TelemetryChannels[ch->channel].size * (fpm / ch->decimation);
+        } else {
+            if (ch->decimation % fpm != 0) return false;
+            uint32_t depth = ch->decimation / fpm;
+            major = major / gcd_u32(major, depth) * depth;
+            if (major > IRIGFIX_PCM_MAX_MINOR_FRAMES) return false;
+        }
+    }
+
+    layout->frames_per_minor = (uint16_t)fpm;
+    layout->minor_per_major = (uint16_t)major;
+
+    /* 서브컴 위상 배정: 가장 덜 찬 마이너 프레임 열에 채움 */
+    uint32_t load[IRIGFIX_PCM_MAX_MINOR_FRAMES];
+    uint16_t phase[256];
+    uint32_t sub_count = 0;
+
+    for (uint32_t m = 0; m < major; m++) load[m] = fixed_bytes;
+
+    for (uint16_t i = 0; i < desc->num_channels; i++) {
+        const PCM_ChannelRate *ch = &desc->channels[i];
+        if (ch->decimation <= fpm) continue;
+
+        uint32_t depth = ch->decimation / fpm;
+        uint32_t size = TelemetryChannels[ch->channel].size;
+        uint32_t best_phase = 0;
+        uint32_t best_cost = UINT32_MAX;
+
+        for (uint32_t p = 0; p < depth; p++) {
+            uint32_t cost = 0;
+            for (uint32_t m = p; m < major; m += depth) {
+                if (load[m] > cost) cost = load[m];
+            }
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_phase = p;
+            }
+        }
+
+        for (uint32_t m = best_phase; m < major; m += depth) {
+            load[m] += size;
+            sub_count++;
+        }
+        phase[i] = (uint16_t)best_phase;
+    }
+
+    layout->minor_frame_bytes = fixed_bytes;
+    for (uint32_t m = 0; m < major; m++) {
+        if (load[m] > layout->minor_frame_bytes) layout->minor_frame_bytes = load[m];
+    }
+
+    layout->fixed_slots = malloc((fixed_count + 1) * sizeof(PCM_Slot));
+    layout->fixed_start = calloc(fpm + 1, sizeof(uint32_t));
+    layout->sub_slots = malloc((sub_count + 1) * sizeof(PCM_Slot));
+    layout->sub_start = calloc(major + 1, sizeof(uint32_t));
+    if (!layout->fixed_slots || !layout->fixed_start ||
+        !layout->sub_slots || !layout->sub_start) {
+        layout_free(layout);
+        return false;
+    }
+
+    /* 공통 슬롯: 샘플 번호 순으로 정렬 */
+    uint32_t n = 0;
+    uint32_t cursor = IRIGFIX_PCM_HEADER_BYTES;
+    for (uint32_t s = 0; s < fpm; s++) {
+        layout->fixed_start[s] = n;
+        for (uint16_t i = 0; i < desc->num_channels; i++) {
+            const PCM_ChannelRate *ch = &desc->channels[i];
+            if (ch->decimation > fpm || s % ch->decimation != 0) continue;
+
+            const TelemetryChannelDesc *tc = &TelemetryChannels[ch->channel];
+            layout->fixed_slots[n].src_offset = tc->offset;
+            layout->fixed_slots[n].dst_offset = (uint16_t)cursor;
+            layout->fixed_slots[n].size = tc->size;
+            cursor += tc->size;
+            n++;
+        }
+    }
+    layout->fixed_start[fpm] = n;
+
+    /* 서브컴 슬롯: SFID 별 */
+    n = 0;
+    for (uint32_t m = 0; m < major; m++) {
+        layout->sub_start[m] = n;
+        cursor = fixed_bytes;
+        for (uint16_t i = 0; i < desc->num_channels; i++) {
+            const PCM_ChannelRate *ch = &desc->channels[i];
+            if (ch->decimation <= fpm) continue;
+
+            uint32_t depth = ch->decimation / fpm;
+            if (m % depth != phase[i]) continue;
+
+            const TelemetryChannelDesc *tc = &TelemetryChannels[ch->channel];
+            layout->sub_slots[n].src_offset = tc->offset;
+            layout->sub_slots[n].dst_offset = (uint16_t)cursor;
+            layout->sub_slots[n].size = tc->size;
+            cursor += tc->size;
+            n++;
+        }
+    }
+    layout->sub_start[major] = n;
+
+    return true;
+}
+
+/* 호스트 순서 ↔ MSB 우선 워드 복사 (대칭) */
+static inline void copy_word_swapped(uint8_t *dst, const uint8_t *src, uint8_t size)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (uint8_t i = 0; i < size; i++) {
+        dst[i] = src[size - 1 - i];
+    }
+#else
+    memcpy(dst, src, size);
+#endif
+}
+
+/* ============================================================
+ * 포맷터 (송신측)
+ * ============================================================ */
+
+PCM_Formatter* PCM_Formatter_Create(const PCM_FormatDesc *desc)
+{
+    PCM_Formatter *fmt = malloc(sizeof(PCM_Formatter));
+    if (!fmt) return NULL;
+
+    if (!layout_build(&fmt->layout, desc)) {
+        free(fmt);
+        return NULL;
+    }
+
+    fmt->current_sfid = 0;
+    fmt->current_sample = 0;
+    fmt->minor_frames_built = 0;
+
+    return fmt;
+}
+
+void PCM_Formatter_Destroy(PCM_Formatter *fmt)
+{
+    if (fmt) {
+        layout_free(&fmt->layout);
+        free(fmt);
+    }
+}
+
+uint32_t PCM_Formatter_GetMinorFrameSize(PCM_Formatter *fmt)
+{
+    if (!fmt) return 0;
+    return fmt->layout.minor_frame_bytes;
+}
+
+bool PCM_Formatter_PushFrame(PCM_Formatter *fmt,
+                             const MissileTelemetryFrame *frame,
+                             uint8_t *minor_frame)
+{
+    if (!fmt || !frame || !minor_frame) return false;
+
+    const PCM_Layout *L = &fmt->layout;
+    const uint8_t *src = (const uint8_t *)frame;
+
+    if (fmt->current_sample == 0) {
+        minor_frame[0] = (uint8_t)(IRIGFIX_PCM_SYNC_WORD >> 24);
+        minor_frame[1] = (uint8_t)(IRIGFIX_PCM_SYNC_WORD >> 16);
+        minor_frame[2] = (uint8_t)(IRIGFIX_PCM_SYNC_WORD >> 8);
+        minor_frame[3] = (uint8_t)(IRIGFIX_PCM_SYNC_WORD);
+        minor_frame[4] = (uint8_t)fmt->current_sfid;
+        memset(minor_frame + IRIGFIX_PCM_HEADER_BYTES, 0,
+               L->minor_frame_bytes - IRIGFIX_PCM_HEADER_BYTES);
+
+        for (uint32_t i = L->sub_start[fmt->current_sfid];
+             i < L->sub_start[fmt->current_sfid + 1]; i++) {
+            const PCM_Slot *slot = &L->sub_slots[i];
+            copy_word_swapped(minor_frame + slot->dst_offset,
+                              src + slot->src_offset, slot->size);
+        }
+    }
+
+    for (uint32_t i = L->fixed_start[fmt->current_sample];
+         i < L->fixed_start[fmt->current_sample + 1]; i++) {
+        const PCM_Slot *slot = &L->fixed_slots[i];
+        copy_word_swapped(minor_frame + slot->dst_offset,
+                          src + slot->src_offset, slot->size);
+    }
+
+    fmt->current_sample++;
+    if (fmt->current_sample < L->frames_per_minor) {
+        return false;
+    }
+
+    fmt->current_sample = 0;
+    fmt->current_sfid++;
+    if (fmt->current_sfid >= L->minor_per_major) {
+        fmt->current_sfid = 0;
+    }
+    fmt->minor_frames_built++;
+
+    return true;
+}
+
+/* ============================================================
+ * 디커뮤테이터 (지상국)
+ * ============================================================ */
+
+PCM_Decommutator* PCM_Decommutator_Create(const PCM_FormatDesc *desc)
+{
+    PCM_Decommutator *dec = malloc(sizeof(PCM_Decommutator));
+    if (!dec) return NULL;
+
+    if (!layout_build(&dec->layout, desc)) {
+        free(dec);
+        return NULL;
+    }
+
+    memset(&dec->held, 0, sizeof(MissileTelemetryFrame));
+    dec->expected_sfid = -1;
+    dec->minor_frames_decoded = 0;
+    dec->sync_errors = 0;
+    dec->sfid_errors = 0;
+
+    return dec;
+}
+
+void PCM_Decommutator_Destroy(PCM_Decommutator *dec)
+{
+    if (dec) {
+        layout_free(&dec->layout);
+        free(dec);
+    }
+}
+
+static int sync_bit_errors(const uint8_t *p)
+{
+    uint32_t word = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                    ((uint32_t)p[2] << 8) | p[3];
+    return __builtin_popcount(word ^ IRIGFIX_PCM_SYNC_WORD);
+}
+
+int PCM_Decommutate(PCM_Decommutator *dec, const uint8_t *minor_frame,
+                    uint32_t len, MissileTelemetryFrame *out, int max_out)
+{
+    if (!dec || !minor_frame || !out) return 0;
+
+    const PCM_Layout *L = &dec->layout;
+    if (len < L->minor_frame_bytes) return 0;
+
+    if (sync_bit_errors(minor_frame) > PT_PCM_SYNC_MAX_BIT_ERRORS) {
+        dec->sync_errors++;
+        dec->expected_sfid = -1;
+        return 0;
+    }
+
+    uint32_t sfid = minor_frame[IRIGFIX_PCM_SYNC_BYTES];
+    if (sfid >= L->minor_per_major) {
+        dec->sfid_errors++;
+        dec->expected_sfid = -1;
+        return 0;
+    }
+    if (dec->expected_sfid >= 0 && (uint32_t)dec->expected_sfid != sfid) {
+        dec->sfid_errors++;
+    }
+    dec->expected_sfid = (int)((sfid + 1) % L->minor_per_major);
+
+    uint8_t *held = (uint8_t *)&dec->held;
+
+    for (uint32_t i = L->sub_start[sfid]; i < L->sub_start[sfid + 1]; i++) {
+        const PCM_Slot *slot = &L->sub_slots[i];
+        copy_word_swapped(held + slot->src_offset,
+                          minor_frame + slot->dst_offset, slot->size);
+    }
+
+    int count = 0;
+    for (uint32_t s = 0; s < L->frames_per_minor; s++) {
+        for (uint32_t i = L->fixed_start[s]; i < L->fixed_start[s + 1]; i++) {
+            const PCM_Slot *slot = &L->fixed_slots[i];
+            copy_word_swapped(held + slot->src_offset,
+                              minor_frame + slot->dst_offset, slot->size);
+        }
+        if (count < max_out) {
+            out[count++] = dec->held;
+        }
+    }
+
+    dec->minor_frames_decoded++;
+    return count;
+}
+
+int PCM_FindSync(const uint8_t *stream, int len)
+{
+    if (!stream) return -1;
+
+    for (int i = 0; i + IRIGFIX_PCM_SYNC_BYTES <= len; i++) {
+        if (sync_bit_errors(stream + i) <= PT_PCM_SYNC_MAX_BIT_ERRORS) {
+            return i;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,328 @@
+#include "telemetry_codec.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * 텔레메트리 무손실 압축 코덱 구현
+ *
+ * 채널별 차분 → 지그재그 → 8채널 그룹 단위 가변 폭 비트 패킹.
+ * 그룹 내 8개 값이 같은 폭을 가지므로 디코더는 그룹마다 고정 길이
+ * 루프 + 8레인 벡터 연산으로 풀 수 있다.
+ * ============================================================ */
+
+typedef uint64_t v8u64 __attribute__((vector_size(64)));
+
+static void init_masks(TelemetryCodec *codec)
+{
+    for (int i = 0; i < TELEMETRY_CODEC_PADDED_CHANNELS; i++) {
+        if (i < TELEMETRY_NUM_CHANNELS && TelemetryChannels[i].size < 8) {
+            codec->mask[i] = (1ULL << (TelemetryChannels[i].size * 8)) - 1;
+        } else if (i < TELEMETRY_NUM_CHANNELS) {
+            codec->mask[i] = ~0ULL;
+        } else {
+            codec->mask[i] = 0;         /* 패딩 채널 */
+        }
+    }
+}
+
+TelemetryCodec* TelemetryCodec_Create(uint32_t keyframe_interval)
+{
+    TelemetryCodec *codec = aligned_alloc(64, sizeof(TelemetryCodec));
+    if (!codec) return NULL;
+
+    memset(codec, 0, sizeof(TelemetryCodec));
+    init_masks(codec);
+    codec->keyframe_interval = keyframe_interval ? keyframe_interval
+                                                 : PT_CODEC_KEYFRAME_INTERVAL;
+    codec->frames_since_keyframe = codec->keyframe_interval;  /* 첫 레코드는 키프레임 */
+    codec->synced = false;
+
+    return codec;
+}
+
+void TelemetryCodec_Destroy(TelemetryCodec *codec)
+{
+    if (codec) free(codec);
+}
+
+void TelemetryCodec_ForceKeyframe(TelemetryCodec *codec)
+{
+    if (!codec) return;
+    codec->frames_since_keyframe = codec->keyframe_interval;
+}
+
+/* ============================================================
+ * 비트 입출력 (LSB 우선)
+ * ============================================================ */
+
+typedef struct {
+    uint8_t *buf;
+    uint32_t pos;                       /* 바이트 */
+    uint64_t acc;
+    int nbits;
+} BitWriter;
+
+static inline void bw_put(BitWriter *bw, uint64_t value, int width)
+{
+    while (width > 0) {
+        int take = (width > 32) ? 32 : width;
+        uint64_t part = value & ((1ULL << take) - 1);
+        bw->acc |= part << bw->nbits;
+        bw->nbits += take;
+        value >>= take;
+        width -= take;
+
+        while (bw->nbits >= 8) {
+            bw->buf[bw->pos++] = (uint8_t)bw->acc;
+            bw->acc >>= 8;
+            bw->nbits -= 8;
+        }
+    }
+}
+
+static inline void bw_flush(BitWriter *bw)
+{
+    if (bw->nbits > 0) {
+        bw->buf[bw->pos++] = (uint8_t)bw->acc;
+        bw->acc = 0;
+        bw->nbits = 0;
+    }
+}
+
+static inline uint64_t read_bits_slow(const uint8_t *buf, uint32_t bitpos, int width)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < width; i++) {
+        uint32_t b = bitpos + i;
+        value |= (uint64_t)((buf[b >> 3] >> (b & 7)) & 1) << i;
+    }
+    return value;
+}
+
+static inline uint64_t load_le64(const uint8_t *p)
+{
+    uint64_t v;
+    memcpy(&v, p, 8);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline int bit_width(uint64_t v)
+{
+    return v ? 64 - __builtin_clzll(v) : 0;
+}
+
+_Static_assert(TELEMETRY_CODEC_MAX_BODY_BYTES <= 0xFFFF,
+               "codec body length must fit the u16 length field");
+
+/* 플래그/순번/길이 + 본문 XOR (헤더 손상으로 인한 오동기 방지) */
+static uint8_t record_check(const uint8_t *record, uint32_t body_len)
+{
+    uint8_t check = (uint8_t)(record[1] ^ record[2] ^ record[3] ^ record[4]);
+    const uint8_t *body = record + IRIGFIX_CODEC_HEADER_BYTES;
+    for (uint32_t i = 0; i < body_len; i++) check ^= body[i];
+    return check;
+}
+
+/* ============================================================
+ * 인코더 (탑재체)
+ * ============================================================ */
+
+int TelemetryCodec_Encode(TelemetryCodec *codec,
+                          const MissileTelemetryFrame *frame,
+                          uint8_t *out, uint32_t capacity)
+{
+    if (!codec || !frame || !out) return -1;
+    if (capacity < TELEMETRY_CODEC_MAX_RECORD_BYTES) return -1;
+
+    bool keyframe = (codec->frames_since_keyframe >= codec->keyframe_interval);
+    if (keyframe) {
+        memset(codec->prev, 0, sizeof(codec->prev));
+        codec->frames_since_keyframe = 0;
+    }
+    codec->frames_since_keyframe++;
+
+    /* 채널 값 → 지그재그 차분 */
+    uint64_t zz[TELEMETRY_CODEC_PADDED_CHANNELS] = {0};
+    const uint8_t *src = (const uint8_t *)frame;
+
+    for (int i = 0; i < TELEMETRY_NUM_CHANNELS; i++) {
+        const TelemetryChannelDesc *ch = &TelemetryChannels[i];
+        uint64_t v = 0;
+        memcpy(&v, src + ch->offset, ch->size);
+
+        int shift = 64 - ch->size * 8;
+        uint64_t d = (v - codec->prev[i]) & codec->mask[i];
+        int64_t sd = (int64_t)(d << shift) >> shift;
+        zz[i] = ((uint64_t)sd << 1) ^ (uint64_t)(sd >> 63);
+
+        codec->prev[i] = v;
+    }
+
+    BitWriter bw = { out + IRIGFIX_CODEC_HEADER_BYTES, 0, 0, 0 };
+
+    for (int g = 0; g < TELEMETRY_CODEC_NUM_GROUPS; g++) {
+        const uint64_t *z = &zz[g * IRIGFIX_CODEC_GROUP_SIZE];
+        uint64_t any = 0;
+        for (int k = 0; k < IRIGFIX_CODEC_GROUP_SIZE; k++) any |= z[k];
+
+        int width = bit_width(any);
+        bw_put(&bw, (uint64_t)width, IRIGFIX_CODEC_WIDTH_BITS);
+        for (int k = 0; k < IRIGFIX_CODEC_GROUP_SIZE; k++) {
+            bw_put(&bw, z[k], width);
+        }
+    }
+    bw_flush(&bw);
+
+    out[0] = IRIGFIX_CODEC_MARKER;
+    out[1] = keyframe ? IRIGFIX_CODEC_FLAG_KEYFRAME : 0;
+    out[2] = codec->sequence++;
+    out[3] = (uint8_t)bw.pos;
+    out[4] = (uint8_t)(bw.pos >> 8);
+    out[5] = record_check(out, bw.pos);
+
+    codec->records++;
+    codec->raw_bytes += sizeof(MissileTelemetryFrame);
+    codec->coded_bytes += IRIGFIX_CODEC_HEADER_BYTES + bw.pos;
+
+    return (int)(IRIGFIX_CODEC_HEADER_BYTES + bw.pos);
+}
+
+/* ============================================================
+ * 디코더 (지상국)
+ * ============================================================ */
+
+static bool decode_body(TelemetryCodec *codec, const uint8_t *body, uint32_t body_len)
+{
+    uint32_t bitpos = 0;
+    uint32_t total_bits = body_len * 8;
+
+    for (int g = 0; g < TELEMETRY_CODEC_NUM_GROUPS; g++) {
+        if (bitpos + IRIGFIX_CODEC_WIDTH_BITS > total_bits) return false;
+        int width = (int)read_bits_slow(body, bitpos, IRIGFIX_CODEC_WIDTH_BITS);
+        bitpos += IRIGFIX_CODEC_WIDTH_BITS;
+
+        if (width > 64) return false;
+        if (bitpos + (uint32_t)width * IRIGFIX_CODEC_GROUP_SIZE > total_bits) return false;
+
+        uint64_t z[IRIGFIX_CODEC_GROUP_SIZE] __attribute__((aligned(64)));
+
+        if (width == 0) {
+            memset(z, 0, sizeof(z));
+        } else if (width <= 56 &&
+                   (bitpos + (uint32_t)width * (IRIGFIX_CODEC_GROUP_SIZE - 1)) / 8 + 8 <= body_len) {
+            /* 빠른 경로: 64비트 비정렬 로드 한 번으로 값 하나 추출 */
+            uint64_t m = (1ULL << width) - 1;
+            for (int k = 0; k < IRIGFIX_CODEC_GROUP_SIZE; k++) {
+                uint32_t b = bitpos + (uint32_t)(k * width);
+                z[k] = (load_le64(body + (b >> 3)) >> (b & 7)) & m;
+            }
+        } else {
+            for (int k = 0; k < IRIGFIX_CODEC_GROUP_SIZE; k++) {
+                z[k] = read_bits_slow(body, bitpos + (uint32_t)(k * width), width);
+            }
+        }
+        bitpos += (uint32_t)width * IRIGFIX_CODEC_GROUP_SIZE;
+
+        /* 8레인: 지그재그 복원 + 이전 값 누적 + 채널 폭 마스크 */
+        v8u64 vz, vp, vm;
+        memcpy(&vz, z, sizeof(vz));
+        memcpy(&vp, &codec->prev[g * IRIGFIX_CODEC_GROUP_SIZE], sizeof(vp));
+        memcpy(&vm, &codec->mask[g * IRIGFIX_CODEC_GROUP_SIZE], sizeof(vm));
+
+        v8u64 d = (vz >> 1) ^ (-(vz & 1));
+        vp = (vp + d) & vm;
+
+        memcpy(&codec->prev[g * IRIGFIX_CODEC_GROUP_SIZE], &vp, sizeof(vp));
+    }
+
+    return true;
+}
+
+static void scatter_frame(const TelemetryCodec *codec, MissileTelemetryFrame *frame)
+{
+    uint8_t *dst = (uint8_t *)frame;
+    for (int i = 0; i < TELEMETRY_NUM_CHANNELS; i++) {
+        const TelemetryChannelDesc *ch = &TelemetryChannels[i];
+        memcpy(dst + ch->offset, &codec->prev[i], ch->size);
+    }
+}
+
+bool TelemetryCodec_Decode(TelemetryCodec *codec, const uint8_t *in,
+                           uint32_t len, uint32_t *consumed,
+                           MissileTelemetryFrame *frame)
+{
+    if (!codec || !in || !consumed || !frame) return false;
+    *consumed = 0;
+
+    if (len < IRIGFIX_CODEC_HEADER_BYTES) return false;
+
+    if (in[0] != IRIGFIX_CODEC_MARKER) {
+        *consumed = 1;                  /* 재동기: 다음 바이트부터 마커 탐색 */
+        return false;
+    }
+
+    uint32_t body_len = (uint32_t)in[3] | ((uint32_t)in[4] << 8);
+    if (body_len > TELEMETRY_CODEC_MAX_BODY_BYTES) {
+        *consumed = 1;                  /* 손상된 길이: 재동기 */
+        return false;
+    }
+    if (len < IRIGFIX_CODEC_HEADER_BYTES + body_len) return false;
+
+    const uint8_t *body = in + IRIGFIX_CODEC_HEADER_BYTES;
+    if (record_check(in, body_len) != in[5]) {
+        *consumed = 1;
+        return false;
+    }
+
+    *consumed = IRIGFIX_CODEC_HEADER_BYTES + body_len;
+
+    bool keyframe = (in[1] & IRIGFIX_CODEC_FLAG_KEYFRAME) != 0;
+    if (keyframe) {
+        memset(codec->prev, 0, sizeof(codec->prev));
+        codec->synced = true;
+    } else if (!codec->synced || in[2] != codec->sequence) {
+        /* 레코드 손실 → 다음 키프레임까지 예측 불가 */
+        codec->synced = false;
+        codec->records_skipped++;
+        return false;
+    }
+    codec->sequence = (uint8_t)(in[2] + 1);
+
+    if (!decode_body(codec, body, body_len)) {
+        codec->synced = false;
+        return false;
+    }
+
+    scatter_frame(codec, frame);
+
+    codec->records++;
+    codec->raw_bytes += sizeof(MissileTelemetryFrame);
+    codec->coded_bytes += *consumed;
+
+    return true;
+}
+
+int TelemetryCodec_DecodeStream(TelemetryCodec *codec, const uint8_t *in,
+                                uint32_t len, uint32_t *consumed,
+                                MissileTelemetryFrame *frames, int max_frames)
+{
+    if (!codec || !in || !consumed || !frames) return 0;
+
+    uint32_t pos = 0;
+    int count = 0;
+
+    while (count < max_frames && pos < len) {
+        uint32_t used = 0;
+        if (TelemetryCodec_Decode(codec, in + pos, len - pos, &used, &frames[count])) {
+            count++;
+        }
+        if (used == 0) break;           /* 불완전 레코드: 다음 블록과 이어서 */
+        pos += used;
+    }
+
+    *consumed = pos;
+    return count;
+}
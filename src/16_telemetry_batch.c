@@ -0,0 +1,144 @@
+#include "telemetry_batch.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * SoA 배치 ↔ packed 와이어 프레임 변환 구현
+ *
+ * packed 구조체 필드 접근은 컴파일러가 비정렬 로드/스토어로 처리하므로
+ * 프레임당 한 번만 순회하면서 각 열의 같은 인덱스에 기록한다.
+ * ============================================================ */
+
+TelemetryBatch* TelemetryBatch_Create(void)
+{
+    TelemetryBatch *batch = aligned_alloc(TELEMETRY_BATCH_ALIGN, sizeof(TelemetryBatch));
+    if (!batch) return NULL;
+
+    memset(batch, 0, sizeof(TelemetryBatch));
+    return batch;
+}
+
+void TelemetryBatch_Destroy(TelemetryBatch *batch)
+{
+    if (batch) free(batch);
+}
+
+void TelemetryBatch_Clear(TelemetryBatch *batch)
+{
+    if (!batch) return;
+    batch->count = 0;
+}
+
+bool TelemetryBatch_IsFull(const TelemetryBatch *batch)
+{
+    if (!batch) return true;
+    return batch->count >= PT_TELEMETRY_BATCH_SIZE;
+}
+
+static inline void unpack_frame(TelemetryBatch *b, uint32_t i,
+                                const MissileTelemetryFrame *f)
+{
+    b->frame_counter[i] = f->frame_counter;
+    b->timestamp_us[i] = f->timestamp_us;
+
+    b->accel_x_g[i] = f->accel_x_g;
+    b->accel_y_g[i] = f->accel_y_g;
+    b->accel_z_g[i] = f->accel_z_g;
+    b->gyro_x_dps[i] = f->gyro_x_dps;
+    b->gyro_y_dps[i] = f->gyro_y_dps;
+    b->gyro_z_dps[i] = f->gyro_z_dps;
+
+    for (int c = 0; c < IRIGFIX_NUM_PRESSURE_CHANNELS; c++) {
+        b->pressure_psi[c][i] = f->pressure_psi[c];
+    }
+    for (int c = 0; c < IRIGFIX_NUM_TEMP_CHANNELS; c++) {
+        b->temperature_c[c][i] = f->temperature_c[c];
+    }
+    for (int c = 0; c < IRIGFIX_NUM_GUIDANCE_CHANNELS; c++) {
+        b->guidance_cmd[c][i] = f->guidance_cmd[c];
+        b->actuator_pos[c][i] = f->actuator_pos[c];
+    }
+    b->flight_mode[i] = f->flight_mode;
+
+    b->latitude[i] = f->latitude;
+    b->longitude[i] = f->longitude;
+    b->altitude_m[i] = f->altitude_m;
+
+    b->battery_voltage[i] = f->battery_voltage;
+    b->system_status[i] = f->system_status;
+    b->crc16[i] = f->crc16;
+}
+
+static inline void pack_frame(const TelemetryBatch *b, uint32_t i,
+                              MissileTelemetryFrame *f)
+{
+    f->frame_counter = b->frame_counter[i];
+    f->timestamp_us = b->timestamp_us[i];
+
+    f->accel_x_g = b->accel_x_g[i];
+    f->accel_y_g = b->accel_y_g[i];
+    f->accel_z_g = b->accel_z_g[i];
+    f->gyro_x_dps = b->gyro_x_dps[i];
+    f->gyro_y_dps = b->gyro_y_dps[i];
+    f->gyro_z_dps = b->gyro_z_dps[i];
+
+    for (int c = 0; c < IRIGFIX_NUM_PRESSURE_CHANNELS; c++) {
+        f->pressure_psi[c] = b->pressure_psi[c][i];
+    }
+    for (int c = 0; c < IRIGFIX_NUM_TEMP_CHANNELS; c++) {
+        f->temperature_c[c] = b->temperature_c[c][i];
+    }
+    for (int c = 0; c < IRIGFIX_NUM_GUIDANCE_CHANNELS; c++) {
+        f->guidance_cmd[c] = b->guidance_cmd[c][i];
+        f->actuator_pos[c] = b->actuator_pos[c][i];
+    }
+    f->flight_mode = b->flight_mode[i];
+
+    f->latitude = b->latitude[i];
+    f->longitude = b->longitude[i];
+    f->altitude_m = b->altitude_m[i];
+
+    f->battery_voltage = b->battery_voltage[i];
+    f->system_status = b->system_status[i];
+    f->crc16 = b->crc16[i];
+}
+
+bool TelemetryBatch_Append(TelemetryBatch *batch, const MissileTelemetryFrame *frame)
+{
+    if (!batch || !frame || batch->count >= PT_TELEMETRY_BATCH_SIZE) return false;
+
+    unpack_frame(batch, batch->count, frame);
+    batch->count++;
+
+    return true;
+}
+
+uint32_t TelemetryBatch_FromWire(TelemetryBatch *batch,
+                                 const MissileTelemetryFrame *frames, uint32_t n)
+{
+    if (!batch || !frames) return 0;
+
+    uint32_t space = PT_TELEMETRY_BATCH_SIZE - batch->count;
+    if (n > space) n = space;
+
+    for (uint32_t k = 0; k < n; k++) {
+        unpack_frame(batch, batch->count + k, &frames[k]);
+    }
+    batch->count += n;
+
+    return n;
+}
+
+uint32_t TelemetryBatch_ToWire(const TelemetryBatch *batch, uint32_t start,
+                               MissileTelemetryFrame *frames, uint32_t n)
+{
+    if (!batch || !frames || start >= batch->count) return 0;
+
+    if (n > batch->count - start) n = batch->count - start;
+
+    for (uint32_t k = 0; k < n; k++) {
+        pack_frame(batch, start + k, &frames[k]);
+    }
+
+    return n;
+}
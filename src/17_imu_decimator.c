@@ -0,0 +1,173 @@
+#include "imu_decimator.h"
+#include "sensor_acquisition.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* ============================================================
+ * 오버샘플링 IMU 데시메이션 구현
+ *
+ * 16 kHz 원시 샘플 → CIC (N=3, R=8) → 2 kHz → 보상 FIR (↓2) → 1 kHz
+ * 6개 채널을 8레인 벡터 한 개로 묶어 모든 채널을 동시에 처리한다.
+ * ============================================================ */
+
+typedef uint32_t v8u32 __attribute__((vector_size(32)));
+typedef int32_t v8i32 __attribute__((vector_size(32)));
+typedef float v8f __attribute__((vector_size(32)));
+
+/* CIC 정규화 진폭 응답 (입력 샘플률 기준) */
+static double cic_response(double f)
+{
+    double x = M_PI * f / PT_IMU_OVERSAMPLE_RATE_HZ;
+    if (fabs(x) < 1e-12) return 1.0;
+
+    double h = sin(x * PT_IMU_CIC_DECIMATION) / (PT_IMU_CIC_DECIMATION * sin(x));
+    return pow(fabs(h), PT_IMU_CIC_ORDER);
+}
+
+/* 주파수 샘플링 + Hamming 창: 통과대역은 CIC 드룹의 역수, 그 위는 0 */
+static void design_compensator(float *taps)
+{
+    const int L = PT_IMU_FIR_TAPS;
+    const int M = (L - 1) / 2;
+    const double fs = (double)PT_IMU_OVERSAMPLE_RATE_HZ / PT_IMU_CIC_DECIMATION;
+
+    double Hd[PT_IMU_FIR_TAPS / 2 + 1];
+    for (int k = 0; k <= M; k++) {
+        double f = (double)k * fs / L;
+        Hd[k] = (f <= PT_IMU_PASSBAND_HZ) ? 1.0 / cic_response(f) : 0.0;
+    }
+
+    double sum = 0.0;
+    for (int n = 0; n < L; n++) {
+        double h = Hd[0];
+        for (int k = 1; k <= M; k++) {
+            h += 2.0 * Hd[k] * cos(2.0 * M_PI * k * (n - M) / L);
+        }
+        h /= L;
+        h *= 0.54 - 0.46 * cos(2.0 * M_PI * n / (L - 1));
+        taps[n] = (float)h;
+        sum += h;
+    }
+
+    /* DC 이득 1 */
+    for (int n = 0; n < L; n++) {
+        taps[n] = (float)(taps[n] / sum);
+    }
+}
+
+ImuDecimator* ImuDecimator_Create(void)
+{
+    ImuDecimator *dec = aligned_alloc(32, sizeof(ImuDecimator));
+    if (!dec) return NULL;
+
+    memset(dec, 0, sizeof(ImuDecimator));
+    design_compensator(dec->fir_taps);
+
+    const float cic_gain = powf((float)PT_IMU_CIC_DECIMATION, PT_IMU_CIC_ORDER);
+    const float accel_scale = PT_IMU_ACCEL_FULL_SCALE_G / 32768.0f / cic_gain;
+    const float gyro_scale = PT_IMU_GYRO_FULL_SCALE_DPS / 32768.0f / cic_gain;
+
+    for (int c = 0; c < IMU_DECIMATOR_LANES; c++) {
+        dec->lane_scale[c] = (c < 3) ? accel_scale : (c < 6) ? gyro_scale : 0.0f;
+    }
+
+    return dec;
+}
+
+void ImuDecimator_Destroy(ImuDecimator *dec)
+{
+    if (dec) free(dec);
+}
+
+void ImuDecimator_Reset(ImuDecimator *dec)
+{
+    if (!dec) return;
+
+    memset(dec->integrator, 0, sizeof(dec->integrator));
+    memset(dec->comb_delay, 0, sizeof(dec->comb_delay));
+    memset(dec->fir_history, 0, sizeof(dec->fir_history));
+    dec->cic_phase = 0;
+    dec->fir_pos = 0;
+    dec->fir_phase = 0;
+}
+
+uint32_t ImuDecimator_Process(ImuDecimator *dec,
+                              const int16_t (*raw)[IRIGFIX_NUM_IMU_CHANNELS],
+                              uint32_t n,
+                              float (*out)[IRIGFIX_NUM_IMU_CHANNELS],
+                              uint32_t max_out)
+{
+    if (!dec || !raw || !out) return 0;
+
+    v8u32 integ[PT_IMU_CIC_ORDER];
+    v8u32 delay[PT_IMU_CIC_ORDER];
+    memcpy(integ, dec->integrator, sizeof(integ));
+    memcpy(delay, dec->comb_delay, sizeof(delay));
+
+    v8f scale;
+    memcpy(&scale, dec->lane_scale, sizeof(scale));
+
+    uint32_t produced = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        v8u32 x = {0};
+        for (int c = 0; c < IRIGFIX_NUM_IMU_CHANNELS; c++) {
+            x[c] = (uint32_t)(int32_t)raw[i][c];
+        }
+
+        /* 적분기 (입력 샘플률) */
+        integ[0] += x;
+        for (int s = 1; s < PT_IMU_CIC_ORDER; s++) {
+            integ[s] += integ[s - 1];
+        }
+
+        if (++dec->cic_phase < PT_IMU_CIC_DECIMATION) continue;
+        dec->cic_phase = 0;
+
+        /* 콤 (CIC 출력률) */
+        v8u32 y = integ[PT_IMU_CIC_ORDER - 1];
+        for (int s = 0; s < PT_IMU_CIC_ORDER; s++) {
+            v8u32 t = y - delay[s];
+            delay[s] = y;
+            y = t;
+        }
+
+        v8f sample = __builtin_convertvector((v8i32)y, v8f) * scale;
+
+        /* FIR 지연선 (이중 기록) */
+        memcpy(dec->fir_history[dec->fir_pos], &sample, sizeof(sample));
+        memcpy(dec->fir_history[dec->fir_pos + PT_IMU_FIR_TAPS], &sample, sizeof(sample));
+        dec->fir_pos = (dec->fir_pos + 1) % PT_IMU_FIR_TAPS;
+
+        if (++dec->fir_phase < PT_IMU_FIR_DECIMATION) continue;
+        dec->fir_phase = 0;
+
+        /* 가장 오래된 샘플부터 연속 창: history[pos .. pos+TAPS) */
+        v8f acc = {0};
+        for (int k = 0; k < PT_IMU_FIR_TAPS; k++) {
+            v8f h;
+            memcpy(&h, dec->fir_history[dec->fir_pos + k], sizeof(h));
+            acc += h * dec->fir_taps[PT_IMU_FIR_TAPS - 1 - k];
+        }
+
+        if (produced < max_out) {
+            for (int c = 0; c < IRIGFIX_NUM_IMU_CHANNELS; c++) {
+                out[produced][c] = acc[c];
+            }
+            produced++;
+        }
+    }
+
+    memcpy(dec->integrator, integ, sizeof(integ));
+    memcpy(dec->comb_delay, delay, sizeof(delay));
+
+    dec->samples_in += n;
+    dec->samples_out += produced;
+
+    return produced;
+}
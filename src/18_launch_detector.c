@@ -0,0 +1,150 @@
+#include "launch_detector.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * 발사 감지기 구현
+ *
+ * 발사 전 구간 (대부분의 샘플) 은 8샘플 마스크가 0 이므로 비교 한 번으로
+ * 넘어가고, 전부 초과인 경우도 연속 길이만 8 증가시킨다. 섞인 경우에만
+ * 샘플 단위로 확인해 정확한 발사 인덱스를 얻는다.
+ * ============================================================ */
+
+typedef float v8f __attribute__((vector_size(32)));
+typedef int32_t v8i __attribute__((vector_size(32)));
+
+#define SCAN_LANES 8
+
+LaunchDetector* LaunchDetector_Create(ConfigSet *config)
+{
+    LaunchDetector *det = malloc(sizeof(LaunchDetector));
+    if (!det) return NULL;
+
+    memset(det, 0, sizeof(LaunchDetector));
+    LaunchDetector_Configure(det, PT_LAUNCH_ACCEL_THRESHOLD_G,
+                             PT_LAUNCH_SUSTAINED_SAMPLES);
+    LaunchDetector_ApplyConfig(det, config);
+
+    return det;
+}
+
+void LaunchDetector_Destroy(LaunchDetector *det)
+{
+    if (det) free(det);
+}
+
+void LaunchDetector_Reset(LaunchDetector *det)
+{
+    if (!det) return;
+
+    det->run_length = 0;
+    det->samples_seen = 0;
+    det->launched = false;
+    det->launch_index = 0;
+    det->confirm_index = 0;
+}
+
+void LaunchDetector_Configure(LaunchDetector *det, float threshold_g,
+                              uint32_t sustained_samples)
+{
+    if (!det) return;
+
+    if (threshold_g > 0.0f) {
+        det->threshold_g = threshold_g;
+        det->threshold_sq = threshold_g * threshold_g;
+    }
+    if (sustained_samples > 0) {
+        det->sustained_samples = sustained_samples;
+    }
+}
+
+void LaunchDetector_ApplyConfig(LaunchDetector *det, ConfigSet *config)
+{
+    if (!det || !config) return;
+
+    /* 등록되지 않은 파라미터는 0 을 반환 → Configure 가 무시 */
+    float threshold = TelemetryConfig_GetFloat(config, LAUNCH_CONFIG_PARAM_THRESHOLD);
+    int32_t sustained = TelemetryConfig_GetInt(config, LAUNCH_CONFIG_PARAM_SUSTAINED);
+
+    LaunchDetector_Configure(det, threshold,
+                             sustained > 0 ? (uint32_t)sustained : 0);
+}
+
+/* 초과 샘플 하나 반영, 확정되면 true */
+static inline bool step(LaunchDetector *det, bool over)
+{
+    if (!over) {
+        det->run_length = 0;
+    } else if (++det->run_length >= det->sustained_samples) {
+        det->launched = true;
+        det->confirm_index = det->samples_seen;
+        det->launch_index = det->samples_seen + 1 - det->run_length;
+    }
+    det->samples_seen++;
+    return det->launched;
+}
+
+bool LaunchDetector_Update(LaunchDetector *det, float ax, float ay, float az)
+{
+    if (!det) return false;
+    if (det->launched) return true;
+
+    return step(det, ax * ax + ay * ay + az * az > det->threshold_sq);
+}
+
+int32_t LaunchDetector_ScanBlock(LaunchDetector *det, const float *ax,
+                                 const float *ay, const float *az, uint32_t n)
+{
+    if (!det || !ax || !ay || !az || det->launched) return -1;
+
+    v8f thr = { det->threshold_sq, det->threshold_sq, det->threshold_sq,
+                det->threshold_sq, det->threshold_sq, det->threshold_sq,
+                det->threshold_sq, det->threshold_sq };
+    uint32_t i = 0;
+
+    for (; i + SCAN_LANES <= n; i += SCAN_LANES) {
+        v8f x, y, z;
+        memcpy(&x, ax + i, sizeof(x));
+        memcpy(&y, ay + i, sizeof(y));
+        memcpy(&z, az + i, sizeof(z));
+
+        v8i over = (x * x + y * y + z * z) > thr;
+
+        uint32_t mask = 0;
+        for (int k = 0; k < SCAN_LANES; k++) {
+            mask |= (uint32_t)(over[k] & 1) << k;
+        }
+
+        if (mask == 0) {
+            det->run_length = 0;
+            det->samples_seen += SCAN_LANES;
+        } else if (mask == 0xFF &&
+                   det->run_length + SCAN_LANES < det->sustained_samples) {
+            det->run_length += SCAN_LANES;
+            det->samples_seen += SCAN_LANES;
+        } else {
+            for (int k = 0; k < SCAN_LANES; k++) {
+                if (step(det, (mask >> k) & 1)) return (int32_t)(i + k);
+            }
+        }
+    }
+
+    for (; i < n; i++) {
+        if (step(det, ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i] > det->threshold_sq)) {
+            return (int32_t)i;
+        }
+    }
+
+    return -1;
+}
+
+int32_t LaunchDetector_ScanBatch(LaunchDetector *det, const TelemetryBatch *batch,
+                                 uint32_t start, uint32_t n)
+{
+    if (!batch || start >= batch->count) return -1;
+    if (n > batch->count - start) n = batch->count - start;
+
+    return LaunchDetector_ScanBlock(det, batch->accel_x_g + start,
+                                    batch->accel_y_g + start,
+                                    batch->accel_z_g + start, n);
+}
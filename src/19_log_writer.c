@@ -0,0 +1,362 @@
+#include "log_writer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+/* ============================================================
+ * 비동기 로그 기록 스레드 구현
+ *
+ * 메인 루프는 memcpy 와 원자 변수 갱신만 한다. 빈 페이지가 없으면
+ * 기다리지 않고 레코드를 버린다 (records_dropped). 가득 찬 페이지는
+ * 한 번의 pwrite 로 기록되며, Flush 로 부분 페이지를 내보내기 전까지
+ * 파일 오프셋도 페이지 크기 정렬을 유지한다.
+ * ============================================================ */
+
+#define QUEUE_MASK (LOG_WRITER_QUEUE_SIZE - 1)
+
+_Static_assert((LOG_WRITER_QUEUE_SIZE & QUEUE_MASK) == 0,
+               "LOG_WRITER_QUEUE_SIZE must be a power of two");
+_Static_assert(PT_LOG_WRITER_NUM_PAGES < LOG_WRITER_QUEUE_SIZE,
+               "PT_LOG_WRITER_NUM_PAGES must be smaller than LOG_WRITER_QUEUE_SIZE");
+
+static void queue_init(LogWriterQueue *q)
+{
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+}
+
+static void queue_push(LogWriterQueue *q, uint32_t page)
+{
+    /* 페이지 수 < 큐 크기 이므로 넘칠 수 없음 */
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    q->slots[tail & QUEUE_MASK] = page;
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+}
+
+static bool queue_pop(LogWriterQueue *q, uint32_t *page)
+{
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    if (head == atomic_load_explicit(&q->tail, memory_order_acquire)) return false;
+
+    *page = q->slots[head & QUEUE_MASK];
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return true;
+}
+
+static uint32_t queue_count(LogWriterQueue *q)
+{
+    return atomic_load_explicit(&q->tail, memory_order_acquire) -
+           atomic_load_explicit(&q->head, memory_order_relaxed);
+}
+
+static uint64_t now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/* ============================================================
+ * 기록 스레드 (소비자)
+ * ============================================================ */
+
+static bool write_page(LogWriter *writer, const LogWriterPage *page)
+{
+    uint32_t done = 0;
+
+    while (done < page->len) {
+        ssize_t n = pwrite(writer->fd, page->data + done, page->len - done,
+                           (off_t)(page->file_offset + done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        done += (uint32_t)n;
+    }
+
+    return true;
+}
+
+static void* writer_thread(void *arg)
+{
+    LogWriter *writer = (LogWriter *)arg;
+    uint64_t last_sync = now_ms();
+    bool dirty = false;
+
+    for (;;) {
+        bool running = atomic_load(&writer->running);
+        uint32_t index;
+
+        while (queue_pop(&writer->full_queue, &index)) {
+            LogWriterPage *page = &writer->pages[index];
+
+            if (write_page(writer, page)) {
+                atomic_fetch_add(&writer->bytes_written, page->len);
+                atomic_fetch_add(&writer->pages_written, 1);
+                dirty = true;
+            } else {
+                atomic_fetch_add(&writer->write_errors, 1);
+            }
+
+            page->len = 0;
+            queue_push(&writer->free_queue, index);
+
+            uint32_t interval = atomic_load(&writer->sync_interval_ms);
+            if (dirty && now_ms() - last_sync >= interval) {
+                fdatasync(writer->fd);
+                atomic_fetch_add(&writer->syncs, 1);
+                last_sync = now_ms();
+                dirty = false;
+            }
+        }
+
+        if (!running) break;
+
+        /* 새 페이지 또는 동기화 주기까지 대기 */
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        uint32_t interval = atomic_load(&writer->sync_interval_ms);
+        uint64_t wait_ns = (uint64_t)(interval ? interval : 1) * 1000000ULL;
+        deadline.tv_sec += (time_t)(wait_ns / 1000000000ULL);
+        deadline.tv_nsec += (long)(wait_ns % 1000000000ULL);
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        if (sem_timedwait(&writer->wakeup, &deadline) != 0 && dirty) {
+            fdatasync(writer->fd);
+            atomic_fetch_add(&writer->syncs, 1);
+            last_sync = now_ms();
+            dirty = false;
+        }
+    }
+
+    if (dirty) {
+        fdatasync(writer->fd);
+        atomic_fetch_add(&writer->syncs, 1);
+    }
+
+    return NULL;
+}
+
+/* ============================================================
+ * 생성 / 해제
+ * ============================================================ */
+
+LogWriter* LogWriter_Create(const char *filename, uint32_t sync_interval_ms)
+{
+    if (!filename) return NULL;
+
+    LogWriter *writer = malloc(sizeof(LogWriter));
+    if (!writer) return NULL;
+    memset(writer, 0, sizeof(LogWriter));
+
+    writer->fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (writer->fd < 0) {
+        free(writer);
+        return NULL;
+    }
+
+    queue_init(&writer->full_queue);
+    queue_init(&writer->free_queue);
+
+    for (uint32_t i = 0; i < PT_LOG_WRITER_NUM_PAGES; i++) {
+        writer->pages[i].data = aligned_alloc(LOG_WRITER_PAGE_ALIGN,
+                                              PT_LOG_WRITER_PAGE_SIZE);
+        if (!writer->pages[i].data) {
+            for (uint32_t k = 0; k < i; k++) free(writer->pages[k].data);
+            close(writer->fd);
+            free(writer);
+            return NULL;
+        }
+        memset(writer->pages[i].data, 0, PT_LOG_WRITER_PAGE_SIZE);  /* 첫 접근 페이지 폴트 방지 */
+        writer->pages[i].len = 0;
+        queue_push(&writer->free_queue, i);
+    }
+
+    writer->fill_page = -1;
+    writer->next_offset = 0;
+    atomic_init(&writer->running, true);
+    atomic_init(&writer->sync_interval_ms, sync_interval_ms);
+
+    if (sem_init(&writer->wakeup, 0, 0) != 0 ||
+        pthread_create(&writer->thread, NULL, writer_thread, writer) != 0) {
+        for (uint32_t i = 0; i < PT_LOG_WRITER_NUM_PAGES; i++) free(writer->pages[i].data);
+        close(writer->fd);
+        free(writer);
+        return NULL;
+    }
+
+    return writer;
+}
+
+void LogWriter_Destroy(LogWriter *writer)
+{
+    if (!writer) return;
+
+    LogWriter_Flush(writer);
+
+    atomic_store(&writer->running, false);
+    sem_post(&writer->wakeup);
+    pthread_join(writer->thread, NULL);
+
+    sem_destroy(&writer->wakeup);
+    close(writer->fd);
+    for (uint32_t i = 0; i < PT_LOG_WRITER_NUM_PAGES; i++) free(writer->pages[i].data);
+    free(writer);
+}
+
+/* ============================================================
+ * 생산자 (메인 루프) - 블로킹 없음
+ * ============================================================ */
+
+static void submit_fill_page(LogWriter *writer)
+{
+    LogWriterPage *page = &writer->pages[writer->fill_page];
+    page->file_offset = writer->next_offset;
+    writer->next_offset += page->len;
+
+    queue_push(&writer->full_queue, (uint32_t)writer->fill_page);
+    writer->fill_page = -1;
+    sem_post(&writer->wakeup);
+}
+
+static uint32_t fill_space(LogWriter *writer)
+{
+    if (writer->fill_page < 0) return 0;
+    return PT_LOG_WRITER_PAGE_SIZE - writer->pages[writer->fill_page].len;
+}
+
+static void copy_in(LogWriter *writer, const uint8_t *src, uint32_t len)
+{
+    while (len > 0) {
+        if (writer->fill_page < 0) {
+            uint32_t index = 0;
+            if (!queue_pop(&writer->free_queue, &index)) return;  /* 사전에 개수 확인됨 */
+            writer->fill_page = (int)index;
+        }
+
+        LogWriterPage *page = &writer->pages[writer->fill_page];
+        uint32_t space = PT_LOG_WRITER_PAGE_SIZE - page->len;
+        uint32_t n = (len < space) ? len : space;
+
+        memcpy(page->data + page->len, src, n);
+        page->len += n;
+        src += n;
+        len -= n;
+
+        if (page->len == PT_LOG_WRITER_PAGE_SIZE) {
+            submit_fill_page(writer);
+        }
+    }
+}
+
+bool LogWriter_AppendV(LogWriter *writer, const LogWriterSpan *spans, int count)
+{
+    if (!writer || (!spans && count > 0)) return false;
+
+    uint64_t total = 0;
+    for (int i = 0; i < count; i++) {
+        if (!spans[i].data && spans[i].len) return false;
+        total += spans[i].len;
+    }
+
+    /* 레코드가 통째로 들어갈 페이지가 없으면 일부만 쓰지 않고 버림 */
+    uint64_t space = fill_space(writer) +
+                     (uint64_t)queue_count(&writer->free_queue) * PT_LOG_WRITER_PAGE_SIZE;
+    if (total > space) {
+        writer->bytes_dropped += total;
+        writer->records_dropped++;
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        copy_in(writer, (const uint8_t *)spans[i].data, spans[i].len);
+    }
+    return true;
+}
+
+/*
+ * 종료 경로 전용: 페이지 여유보다 큰 레코드 (비행 로그 색인 등) 도 빈 페이지를
+ * 기다리며 나눠 넣는다 (블로킹). 반환: 기록 스레드 오류 없이 모두 기록됨
+ */
+bool LogWriter_AppendBlocking(LogWriter *writer, const LogWriterSpan *spans, int count)
+{
+    if (!writer || (!spans && count > 0)) return false;
+
+    uint32_t errors = atomic_load(&writer->write_errors);
+
+    for (int i = 0; i < count; i++) {
+        const uint8_t *src = (const uint8_t *)spans[i].data;
+        uint32_t len = spans[i].len;
+        if (!src && len) return false;
+
+        while (len > 0) {
+            uint64_t space = fill_space(writer) +
+                             (uint64_t)queue_count(&writer->free_queue) * PT_LOG_WRITER_PAGE_SIZE;
+            if (space == 0) {
+                LogWriter_WaitIdle(writer);
+                continue;
+            }
+
+            uint32_t n = (len < space) ? len : (uint32_t)space;
+            copy_in(writer, src, n);
+            src += n;
+            len -= n;
+        }
+    }
+
+    LogWriter_Flush(writer);
+    LogWriter_WaitIdle(writer);
+    return atomic_load(&writer->write_errors) == errors;
+}
+
+bool LogWriter_AppendRecord(LogWriter *writer, const void *a, uint32_t a_len,
+                            const void *b, uint32_t b_len)
+{
+    LogWriterSpan spans[2] = { { a, a_len }, { b, b_len } };
+    return LogWriter_AppendV(writer, spans, 2);
+}
+
+bool LogWriter_Append(LogWriter *writer, const void *data, uint32_t len)
+{
+    return LogWriter_AppendRecord(writer, data, len, NULL, 0);
+}
+
+bool LogWriter_Flush(LogWriter *writer)
+{
+    if (!writer) return false;
+
+    if (writer->fill_page >= 0 && writer->pages[writer->fill_page].len > 0) {
+        submit_fill_page(writer);
+    }
+    return true;
+}
+
+/* 제출된 페이지가 모두 기록될 때까지 대기 (종료 경로 전용, 블로킹) */
+void LogWriter_WaitIdle(LogWriter *writer)
+{
+    if (!writer) return;
+
+    uint32_t held = (writer->fill_page >= 0) ? 1 : 0;
+    while (queue_count(&writer->free_queue) + held < PT_LOG_WRITER_NUM_PAGES) {
+        sem_post(&writer->wakeup);
+        usleep(1000);
+    }
+}
+
+void LogWriter_SetSyncInterval(LogWriter *writer, uint32_t sync_interval_ms)
+{
+    if (!writer) return;
+    atomic_store(&writer->sync_interval_ms, sync_interval_ms);
+}
+
+uint64_t LogWriter_GetBytesWritten(LogWriter *writer)
+{
+    if (!writer) return 0;
+    return atomic_load(&writer->bytes_written);
+}
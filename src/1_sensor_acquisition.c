@@ -1,27 +1,207 @@
 #include "missile_telemetry.h"
+#include "sensor_acquisition.h"
+#include "launch_detector.h"
 #include <math.h>
 #include <string.h>
 
-void MissileTM_ReadSensors(MissileTelemetrySystem *sys)
+typedef float v8f __attribute__((vector_size(32)));
+
+/* ============================================================
+ * 서미스터 변환 테이블
+ *
+ * 16비트 ADC 코드를 상위 PT_THERMISTOR_LUT_BITS 비트로 색인하고 하위
+ * 비트로 선형 보간한다. 단락 (저항 ~0) 구간은 PT_THERMISTOR_MAX_TEMP_C
+ * 에 해당하는 코드로 클램프하므로 ADC 0 에서도 -inf 가 나오지 않는다.
+ * ============================================================ */
+
+static float g_thermistor_lut[THERMISTOR_LUT_SIZE];
+static float g_thermistor_max_error_c = 0.0f;
+static bool g_sensor_initialized = false;
+
+static float steinhart_hart_celsius(uint32_t adc)
+{
+    float R = adc * PT_THERMISTOR_R_FULL_SCALE / 65535.0f;
+    float lnR = logf(R);
+
+    float A = PT_THERMISTOR_SH_A;
+    float B = PT_THERMISTOR_SH_B;
+    float C = PT_THERMISTOR_SH_C;
+
+    float T_kelvin = 1.0f / (A + B*lnR + C*lnR*lnR*lnR);
+    return T_kelvin - 273.15f;
+}
+
+void Sensor_Init(void)
+{
+    if (g_sensor_initialized) return;
+
+    /* 유효 범위 하한 코드 탐색 (온도는 코드에 대해 단조 감소) */
+    uint32_t min_code = 1;
+    while (min_code < 65535 &&
+           steinhart_hart_celsius(min_code) > PT_THERMISTOR_MAX_TEMP_C) {
+        min_code++;
+    }
+
+    for (uint32_t k = 0; k < THERMISTOR_LUT_SIZE; k++) {
+        uint32_t code = k << THERMISTOR_LUT_SHIFT;
+        if (code > 65535) code = 65535;
+        if (code < min_code) code = min_code;
+        g_thermistor_lut[k] = steinhart_hart_celsius(code);
+    }
+
+    g_sensor_initialized = true;
+
+    /* 보간 오차 상한 (유효 범위 전체 검사) */
+    float max_err = 0.0f;
+    for (uint32_t code = min_code; code <= 65535; code++) {
+        float err = fabsf(Sensor_ThermistorToCelsius((uint16_t)code) -
+                          steinhart_hart_celsius(code));
+        if (err > max_err) max_err = err;
+    }
+    g_thermistor_max_error_c = max_err;
+}
+
+float Sensor_ThermistorToCelsius(uint16_t adc)
+{
+    if (!g_sensor_initialized) Sensor_Init();
+
+    uint32_t idx = adc >> THERMISTOR_LUT_SHIFT;
+    float frac = (adc & ((1u << THERMISTOR_LUT_SHIFT) - 1)) *
+                 (1.0f / (1u << THERMISTOR_LUT_SHIFT));
+    float t0 = g_thermistor_lut[idx];
+    float t1 = g_thermistor_lut[idx + 1];
+
+    return t0 + (t1 - t0) * frac;
+}
+
+float Sensor_GetThermistorMaxError(void)
+{
+    if (!g_sensor_initialized) Sensor_Init();
+    return g_thermistor_max_error_c;
+}
+
+/* ============================================================
+ * DMA 블록 일괄 변환 → SoA 배치
+ * ============================================================ */
+
+static inline void store_scaled_i16(float *dst, const SensorRawSample *raw,
+                                    int channel, float scale)
+{
+    v8f x;
+    for (int k = 0; k < 8; k++) x[k] = (float)raw[k].imu[channel];
+    v8f y = x * scale;
+    memcpy(dst, &y, sizeof(y));
+}
+
+static inline void store_scaled_u16(float *dst, const uint16_t *src, size_t stride,
+                                    float scale)
+{
+    v8f x;
+    for (int k = 0; k < 8; k++) x[k] = (float)src[k * stride];
+    v8f y = x * scale;
+    memcpy(dst, &y, sizeof(y));
+}
+
+static inline void store_thermistor(float *dst, const uint16_t *src, size_t stride)
+{
+    v8f t0, t1, frac;
+    for (int k = 0; k < 8; k++) {
+        uint16_t adc = src[k * stride];
+        uint32_t idx = adc >> THERMISTOR_LUT_SHIFT;
+        t0[k] = g_thermistor_lut[idx];
+        t1[k] = g_thermistor_lut[idx + 1];
+        frac[k] = (float)(adc & ((1u << THERMISTOR_LUT_SHIFT) - 1));
+    }
+    v8f y = t0 + (t1 - t0) * (frac * (1.0f / (1u << THERMISTOR_LUT_SHIFT)));
+    memcpy(dst, &y, sizeof(y));
+}
+
+uint32_t Sensor_ConvertBlock(const SensorRawSample *raw, uint32_t n,
+                             TelemetryBatch *batch, uint32_t start)
+{
+    if (!raw || !batch || start >= PT_TELEMETRY_BATCH_SIZE) return 0;
+    if (!g_sensor_initialized) Sensor_Init();
+
+    if (n > PT_TELEMETRY_BATCH_SIZE - start) n = PT_TELEMETRY_BATCH_SIZE - start;
+
+    const float accel_scale = PT_IMU_ACCEL_FULL_SCALE_G / 32768.0f;
+    const float gyro_scale = PT_IMU_GYRO_FULL_SCALE_DPS / 32768.0f;
+    const float pressure_scale = PT_PRESSURE_FULL_SCALE_PSI / 65535.0f;
+    const size_t stride = sizeof(SensorRawSample) / sizeof(uint16_t);
+
+    uint32_t i = 0;
+
+    /* 8샘플 단위 벡터 경로 */
+    for (; i + 8 <= n; i += 8) {
+        const SensorRawSample *r = &raw[i];
+        uint32_t j = start + i;
+
+        store_scaled_i16(&batch->accel_x_g[j], r, 0, accel_scale);
+        store_scaled_i16(&batch->accel_y_g[j], r, 1, accel_scale);
+        store_scaled_i16(&batch->accel_z_g[j], r, 2, accel_scale);
+        store_scaled_i16(&batch->gyro_x_dps[j], r, 3, gyro_scale);
+        store_scaled_i16(&batch->gyro_y_dps[j], r, 4, gyro_scale);
+        store_scaled_i16(&batch->gyro_z_dps[j], r, 5, gyro_scale);
+
+        for (int c = 0; c < IRIGFIX_NUM_PRESSURE_CHANNELS; c++) {
+            store_scaled_u16(&batch->pressure_psi[c][j], &r->pressure[c], stride,
+                             pressure_scale);
+        }
+        for (int c = 0; c < IRIGFIX_NUM_TEMP_CHANNELS; c++) {
+            store_thermistor(&batch->temperature_c[c][j], &r->temperature[c], stride);
+        }
+    }
+
+    /* 나머지 샘플 */
+    for (; i < n; i++) {
+        const SensorRawSample *r = &raw[i];
+        uint32_t j = start + i;
+
+        batch->accel_x_g[j] = r->imu[0] * accel_scale;
+        batch->accel_y_g[j] = r->imu[1] * accel_scale;
+        batch->accel_z_g[j] = r->imu[2] * accel_scale;
+        batch->gyro_x_dps[j] = r->imu[3] * gyro_scale;
+        batch->gyro_y_dps[j] = r->imu[4] * gyro_scale;
+        batch->gyro_z_dps[j] = r->imu[5] * gyro_scale;
+
+        for (int c = 0; c < IRIGFIX_NUM_PRESSURE_CHANNELS; c++) {
+            batch->pressure_psi[c][j] = r->pressure[c] * pressure_scale;
+        }
+        for (int c = 0; c < IRIGFIX_NUM_TEMP_CHANNELS; c++) {
+            batch->temperature_c[c][j] = Sensor_ThermistorToCelsius(r->temperature[c]);
+        }
+    }
+
+    if (batch->count < start + n) batch->count = start + n;
+
+    return n;
+}
+
+/* ============================================================
+ * 단일 샘플 수집 (1 ms)
+ * ============================================================ */
+
+static void read_imu_single(MissileTelemetrySystem *sys)
 {
-    if (!sys) return;
-    
     /* IMU 데이터 읽기 */
     int16_t imu_raw[6] = {0};
     
-    float accel_scale = 100.0f / 32768.0f;
+    float accel_scale = PT_IMU_ACCEL_FULL_SCALE_G / 32768.0f;
     sys->current_frame.accel_x_g = imu_raw[0] * accel_scale;
     sys->current_frame.accel_y_g = imu_raw[1] * accel_scale;
     sys->current_frame.accel_z_g = imu_raw[2] * accel_scale;
     
-    float gyro_scale = 2000.0f / 32768.0f;
+    float gyro_scale = PT_IMU_GYRO_FULL_SCALE_DPS / 32768.0f;
     sys->current_frame.gyro_x_dps = imu_raw[3] * gyro_scale;
     sys->current_frame.gyro_y_dps = imu_raw[4] * gyro_scale;
     sys->current_frame.gyro_z_dps = imu_raw[5] * gyro_scale;
-    
+}
+
+static void read_slow_sensors(MissileTelemetrySystem *sys)
+{
     /* 압력 센서 */
     uint16_t pressure_adc[4] = {0};
-    float pressure_scale = 10000.0f / 65535.0f;
+    float pressure_scale = PT_PRESSURE_FULL_SCALE_PSI / 65535.0f;
     for (int i = 0; i < 4; i++) {
         sys->current_frame.pressure_psi[i] = pressure_adc[i] * pressure_scale;
     }
@@ -29,15 +209,7 @@ void MissileTM_ReadSensors(MissileTelemetrySystem *sys)
     /* 온도 센서 */
     uint16_t temp_adc[8] = {0};
     for (int i = 0; i < 8; i++) {
-        float R = temp_adc[i] * 10000.0f / 65535.0f;
-        float lnR = logf(R);
-        
-        float A = 0.001129148f;
-        float B = 0.000234125f;
-        float C = 0.0000000876741f;
-        
-        float T_kelvin = 1.0f / (A + B*lnR + C*lnR*lnR*lnR);
-        sys->current_frame.temperature_c[i] = T_kelvin - 273.15f;
+        sys->current_frame.temperature_c[i] = Sensor_ThermistorToCelsius(temp_adc[i]);
     }
     
     /* 유도 명령 */
@@ -53,27 +225,41 @@ void MissileTM_ReadSensors(MissileTelemetrySystem *sys)
     sys->current_frame.frame_counter++;
 }
 
-bool MissileTM_DetectLaunch(MissileTelemetrySystem *sys)
+void MissileTM_ReadSensors(MissileTelemetrySystem *sys)
 {
-    if (!sys) return false;
+    if (!sys) return;
     
-    float ax = sys->current_frame.accel_x_g;
-    float ay = sys->current_frame.accel_y_g;
-    float az = sys->current_frame.accel_z_g;
-    float mag = sqrtf(ax*ax + ay*ay + az*az);
+    read_imu_single(sys);
+    read_slow_sensors(sys);
+}
+
+void MissileTM_ReadSensorsOversampled(MissileTelemetrySystem *sys, ImuDecimator *dec)
+{
+    if (!sys || !dec) return;
     
-    const float LAUNCH_THRESHOLD = 5.0f;
-    static int counter = 0;
+    /* IMU 버스트 읽기 (PT_IMU_OVERSAMPLE_RATE_HZ, 1 ms 분량) */
+    int16_t imu_burst[PT_IMU_BURST_SAMPLES][IRIGFIX_NUM_IMU_CHANNELS] = {{0}};
+    float imu_out[1][IRIGFIX_NUM_IMU_CHANNELS];
     
-    if (mag > LAUNCH_THRESHOLD) {
-        counter++;
-        if (counter >= 10) {
-            counter = 0;
-            return true;
-        }
-    } else {
-        counter = 0;
+    if (ImuDecimator_Process(dec, (const int16_t (*)[IRIGFIX_NUM_IMU_CHANNELS])imu_burst,
+                             PT_IMU_BURST_SAMPLES, imu_out, 1) == 1) {
+        sys->current_frame.accel_x_g = imu_out[0][0];
+        sys->current_frame.accel_y_g = imu_out[0][1];
+        sys->current_frame.accel_z_g = imu_out[0][2];
+        sys->current_frame.gyro_x_dps = imu_out[0][3];
+        sys->current_frame.gyro_y_dps = imu_out[0][4];
+        sys->current_frame.gyro_z_dps = imu_out[0][5];
     }
     
-    return false;
+    read_slow_sensors(sys);
+}
+
+bool MissileTM_DetectLaunch(MissileTelemetrySystem *sys)
+{
+    if (!sys || !sys->launch_detector) return false;
+    
+    return LaunchDetector_Update((LaunchDetector *)sys->launch_detector,
+                                 sys->current_frame.accel_x_g,
+                                 sys->current_frame.accel_y_g,
+                                 sys->current_frame.accel_z_g);
 }
@@ -0,0 +1,631 @@
+#include "flight_log.h"
+#include "telemetry_channels.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/* ============================================================
+ * 비행 로그 컨테이너 (Chapter 10 형식 패킷) 구현
+ *
+ * 패킷 조립은 헤더와 고정 본문만 FlightLogPacket 에 만들고 카메라 같은
+ * 큰 본문은 포인터로 두므로, 기록 스레드나 FILE 에 그대로 넘기면 된다.
+ * 읽기 측은 헤더 체크섬 + 본문 CRC32 로 패킷 단위 무결성을 확인한다.
+ * ============================================================ */
+
+/* ============================================================
+ * 리틀 엔디언 입출력 / CRC32
+ * ============================================================ */
+
+static inline void put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put_le32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static inline void put_le64(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static inline uint16_t get_le16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint64_t get_le64(const uint8_t *p)
+{
+    return (uint64_t)get_le32(p) | ((uint64_t)get_le32(p + 4) << 32);
+}
+
+static uint32_t crc32_table[256];
+static pthread_once_t crc32_once = PTHREAD_ONCE_INIT;  /* 기록 스레드/질의 워커 동시 최초 호출 */
+
+static void crc32_init(void)
+{
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        }
+        crc32_table[i] = c;
+    }
+}
+
+/* crc = 이전 결과 (처음은 0) 를 넘겨 여러 조각을 이어서 계산 */
+uint32_t FlightLog_CRC32(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+    pthread_once(&crc32_once, crc32_init);
+
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++) {
+        crc = crc32_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static uint16_t header_checksum(const uint8_t *h)
+{
+    uint16_t sum = 0;
+    for (int i = 0; i < IRIGFIX_FLOG_HEADER_BYTES - 2; i += 2) {
+        sum = (uint16_t)(sum + get_le16(h + i));
+    }
+    return sum;
+}
+
+/* packed 프레임 ↔ 리틀 엔디언 채널 값 */
+static void frame_to_le(uint8_t *dst, const MissileTelemetryFrame *frame)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    memcpy(dst, frame, sizeof(MissileTelemetryFrame));
+#else
+    const uint8_t *src = (const uint8_t *)frame;
+    for (int i = 0; i < TELEMETRY_NUM_CHANNELS; i++) {
+        const TelemetryChannelDesc *ch = &TelemetryChannels[i];
+        for (uint32_t k = 0; k < ch->size; k++) {
+            dst[ch->offset + k] = src[ch->offset + ch->size - 1 - k];
+        }
+    }
+#endif
+}
+
+static void frame_from_le(MissileTelemetryFrame *frame, const uint8_t *src)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    memcpy(frame, src, sizeof(MissileTelemetryFrame));
+#else
+    uint8_t *dst = (uint8_t *)frame;
+    for (int i = 0; i < TELEMETRY_NUM_CHANNELS; i++) {
+        const TelemetryChannelDesc *ch = &TelemetryChannels[i];
+        for (uint32_t k = 0; k < ch->size; k++) {
+            dst[ch->offset + k] = src[ch->offset + ch->size - 1 - k];
+        }
+    }
+#endif
+}
+
+static inline uint32_t float_bits(float f)
+{
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+static inline float bits_float(uint32_t u)
+{
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+/* ============================================================
+ * 패킷 조립
+ * ============================================================ */
+
+void FlightLogState_Init(FlightLogState *state)
+{
+    if (!state) return;
+    memset(state, 0, sizeof(FlightLogState));
+}
+
+void FlightLogState_Free(FlightLogState *state)
+{
+    if (!state) return;
+    if (state->index_bytes) free(state->index_bytes);
+    memset(state, 0, sizeof(FlightLogState));
+}
+
+/* head 에 고정 본문 (prefix_len) 이 이미 기록되어 있다고 보고 헤더/꼬리 완성 */
+static void finish_packet(const FlightLogState *state, FlightLogPacket *pkt,
+                          uint16_t channel, uint8_t type, uint64_t time_us,
+                          uint32_t prefix_len, const uint8_t *payload,
+                          uint32_t payload_len)
+{
+    uint32_t data_len = prefix_len + payload_len;
+    uint32_t pad = (4 - (data_len & 3)) & 3;
+
+    pkt->head_len = IRIGFIX_FLOG_HEADER_BYTES + prefix_len;
+    pkt->payload = payload;
+    pkt->payload_len = payload_len;
+    pkt->channel_id = channel;
+    pkt->data_type = type;
+    pkt->time_us = time_us & IRIGFIX_FLOG_TIME_MASK;
+    pkt->packet_len = IRIGFIX_FLOG_HEADER_BYTES + data_len + pad + IRIGFIX_FLOG_CRC_BYTES;
+
+    uint8_t *h = pkt->head;
+    put_le16(h + 0, IRIGFIX_FLOG_SYNC);
+    put_le16(h + 2, channel);
+    put_le32(h + 4, pkt->packet_len);
+    put_le32(h + 8, data_len);
+    h[12] = IRIGFIX_FLOG_VERSION;
+    h[13] = state->sequence[channel];
+    h[14] = 0;
+    h[15] = type;
+    for (int i = 0; i < 6; i++) h[16 + i] = (uint8_t)(pkt->time_us >> (8 * i));
+    put_le16(h + 22, header_checksum(h));
+
+    memset(pkt->tail, 0, pad);
+    uint32_t crc = FlightLog_CRC32(0, h + IRIGFIX_FLOG_HEADER_BYTES, prefix_len);
+    crc = FlightLog_CRC32(crc, payload, payload_len);
+    crc = FlightLog_CRC32(crc, pkt->tail, pad);
+    put_le32(pkt->tail + pad, crc);
+    pkt->tail_len = pad + IRIGFIX_FLOG_CRC_BYTES;
+}
+
+void FlightLog_BuildSetup(const FlightLogState *state, FlightLogPacket *pkt)
+{
+    if (!state || !pkt) return;
+
+    uint8_t *b = pkt->head + IRIGFIX_FLOG_HEADER_BYTES;
+    put_le32(b + 0, IRIGFIX_FLOG_VERSION);
+    put_le32(b + 4, (uint32_t)sizeof(MissileTelemetryFrame));
+    put_le32(b + 8, TELEMETRY_NUM_CHANNELS);
+    put_le32(b + 12, PT_FLOG_INDEX_STRIDE);
+
+    finish_packet(state, pkt, IRIGFIX_FLOG_CHANNEL_SETUP, IRIGFIX_FLOG_TYPE_SETUP,
+                  0, IRIGFIX_FLOG_SETUP_BYTES, NULL, 0);
+}
+
+void FlightLog_BuildTelemetry(const FlightLogState *state, FlightLogPacket *pkt,
+                              const LogEntry *entry)
+{
+    if (!state || !pkt || !entry) return;
+
+    uint8_t *b = pkt->head + IRIGFIX_FLOG_HEADER_BYTES;
+    put_le32(b + 0, entry->entry_id);
+    put_le32(b + 4, entry->camera_frame_id);
+    put_le32(b + 8, entry->camera_data ? entry->camera_data_size : 0);
+    b[12] = entry->last_command_type;
+    b[13] = b[14] = b[15] = 0;
+    put_le32(b + 16, float_bits(entry->last_thrust_cmd));
+    frame_to_le(b + IRIGFIX_FLOG_TM_PREFIX_BYTES, &entry->telemetry);
+
+    finish_packet(state, pkt, IRIGFIX_FLOG_CHANNEL_TELEMETRY, IRIGFIX_FLOG_TYPE_TELEMETRY,
+                  entry->timestamp_us, IRIGFIX_FLOG_TM_BODY_BYTES, NULL, 0);
+}
+
+void FlightLog_BuildCamera(const FlightLogState *state, FlightLogPacket *pkt,
+                           uint64_t time_us, uint32_t frame_id,
+                           const uint8_t *data, uint32_t size)
+{
+    if (!state || !pkt) return;
+
+    uint8_t *b = pkt->head + IRIGFIX_FLOG_HEADER_BYTES;
+    put_le32(b + 0, frame_id);
+    put_le32(b + 4, size);
+
+    finish_packet(state, pkt, IRIGFIX_FLOG_CHANNEL_CAMERA, IRIGFIX_FLOG_TYPE_CAMERA,
+                  time_us, IRIGFIX_FLOG_CAM_PREFIX_BYTES, data, data ? size : 0);
+}
+
+void FlightLog_BuildIndex(const FlightLogState *state, FlightLogPacket *pkt,
+                          uint64_t time_us)
+{
+    if (!state || !pkt) return;
+
+    finish_packet(state, pkt, IRIGFIX_FLOG_CHANNEL_SETUP, IRIGFIX_FLOG_TYPE_INDEX,
+                  time_us, 0, state->index_bytes,
+                  state->index_count * IRIGFIX_FLOG_INDEX_ENTRY_BYTES);
+}
+
+/* 증분 저장 경계: 지금까지의 텔레메트리 수와 이 패킷의 오프셋 */
+void FlightLog_BuildCommit(const FlightLogState *state, FlightLogPacket *pkt,
+                           uint64_t time_us)
+{
+    if (!state || !pkt) return;
+
+    uint8_t *b = pkt->head + IRIGFIX_FLOG_HEADER_BYTES;
+    put_le64(b + 0, state->telemetry_packets);
+    put_le64(b + 8, state->offset);
+
+    finish_packet(state, pkt, IRIGFIX_FLOG_CHANNEL_SETUP, IRIGFIX_FLOG_TYPE_COMMIT,
+                  time_us, IRIGFIX_FLOG_COMMIT_BYTES, NULL, 0);
+}
+
+bool FlightLog_Commit(FlightLogState *state, const FlightLogPacket *pkt)
+{
+    if (!state || !pkt) return false;
+
+    bool ok = true;
+
+    if (pkt->channel_id == IRIGFIX_FLOG_CHANNEL_TELEMETRY) {
+        if (state->telemetry_packets % PT_FLOG_INDEX_STRIDE == 0) {
+            if (state->index_count == state->index_capacity) {
+                uint32_t cap = state->index_capacity ? state->index_capacity * 2 : 256;
+                uint8_t *grown = realloc(state->index_bytes,
+                                         (size_t)cap * IRIGFIX_FLOG_INDEX_ENTRY_BYTES);
+                if (grown) {
+                    state->index_bytes = grown;
+                    state->index_capacity = cap;
+                }
+            }
+            if (state->index_count < state->index_capacity) {
+                uint8_t *e = state->index_bytes +
+                             (size_t)state->index_count * IRIGFIX_FLOG_INDEX_ENTRY_BYTES;
+                put_le64(e, pkt->time_us);
+                put_le64(e + 8, state->offset);
+                state->index_count++;
+            } else {
+                ok = false;             /* 색인 항목 하나 누락 (읽기는 순차 탐색으로 보완) */
+            }
+        }
+        state->telemetry_packets++;
+    }
+
+    state->sequence[pkt->channel_id]++;
+    state->offset += pkt->packet_len;
+    return ok;
+}
+
+void FlightLog_BuildTrailer(uint8_t *out, uint64_t index_offset)
+{
+    if (!out) return;
+
+    put_le64(out, index_offset);
+    put_le32(out + 8, IRIGFIX_FLOG_TRAILER_MAGIC);
+    put_le32(out + 12, FlightLog_CRC32(0, out, 12));
+}
+
+bool FlightLog_WritePacket(FILE *file, FlightLogState *state, const FlightLogPacket *pkt)
+{
+    if (!file || !state || !pkt) return false;
+
+    if (fwrite(pkt->head, 1, pkt->head_len, file) != pkt->head_len) return false;
+    if (pkt->payload_len > 0 &&
+        fwrite(pkt->payload, 1, pkt->payload_len, file) != pkt->payload_len) return false;
+    if (fwrite(pkt->tail, 1, pkt->tail_len, file) != pkt->tail_len) return false;
+
+    FlightLog_Commit(state, pkt);
+    return true;
+}
+
+/* ============================================================
+ * 파싱
+ * ============================================================ */
+
+bool FlightLog_ParseHeader(const uint8_t *p, uint64_t avail, FlightLogPacketHeader *hdr)
+{
+    if (!p || !hdr || avail < IRIGFIX_FLOG_HEADER_BYTES) return false;
+
+    if (get_le16(p) != IRIGFIX_FLOG_SYNC) return false;
+    if (get_le16(p + 22) != header_checksum(p)) return false;
+
+    hdr->channel_id = get_le16(p + 2);
+    hdr->packet_len = get_le32(p + 4);
+    hdr->data_len = get_le32(p + 8);
+    hdr->sequence = p[13];
+    hdr->flags = p[14];
+    hdr->data_type = p[15];
+    hdr->time_us = 0;
+    for (int i = 0; i < 6; i++) hdr->time_us |= (uint64_t)p[16 + i] << (8 * i);
+
+    uint64_t expect = (uint64_t)IRIGFIX_FLOG_HEADER_BYTES +
+                      (((uint64_t)hdr->data_len + 3) & ~3ULL) + IRIGFIX_FLOG_CRC_BYTES;
+    if (hdr->packet_len != expect) return false;
+    if (hdr->packet_len > PT_FLOG_MAX_PACKET_BYTES) return false;
+    if (hdr->channel_id >= IRIGFIX_FLOG_NUM_CHANNELS) return false;
+
+    return true;
+}
+
+bool FlightLog_VerifyPacket(const uint8_t *p, uint64_t avail, FlightLogPacketHeader *hdr)
+{
+    if (!FlightLog_ParseHeader(p, avail, hdr)) return false;
+    if (avail < hdr->packet_len) return false;
+
+    uint32_t body_len = hdr->packet_len - IRIGFIX_FLOG_HEADER_BYTES - IRIGFIX_FLOG_CRC_BYTES;
+    uint32_t crc = FlightLog_CRC32(0, p + IRIGFIX_FLOG_HEADER_BYTES, body_len);
+
+    return crc == get_le32(p + hdr->packet_len - IRIGFIX_FLOG_CRC_BYTES);
+}
+
+/* 손상 구간 다음의 유효 헤더 위치 (재동기), 없으면 -1 */
+int64_t FlightLog_FindSync(const uint8_t *p, uint64_t len)
+{
+    if (!p) return -1;
+
+    FlightLogPacketHeader hdr;
+    for (uint64_t i = 0; i + IRIGFIX_FLOG_HEADER_BYTES <= len; i++) {
+        if (p[i] == (IRIGFIX_FLOG_SYNC & 0xFF) && p[i + 1] == (IRIGFIX_FLOG_SYNC >> 8) &&
+            FlightLog_ParseHeader(p + i, len - i, &hdr)) {
+            return (int64_t)i;
+        }
+    }
+    return -1;
+}
+
+bool FlightLog_ParseTrailer(const uint8_t *p, uint64_t *index_offset)
+{
+    if (!p || !index_offset) return false;
+
+    if (get_le32(p + 8) != IRIGFIX_FLOG_TRAILER_MAGIC) return false;
+    if (get_le32(p + 12) != FlightLog_CRC32(0, p, 12)) return false;
+
+    *index_offset = get_le64(p);
+    return true;
+}
+
+bool FlightLog_DecodeTelemetry(const FlightLogPacketHeader *hdr, const uint8_t *body,
+                               LogEntry *entry)
+{
+    if (!hdr || !body || !entry) return false;
+    if (hdr->data_type != IRIGFIX_FLOG_TYPE_TELEMETRY) return false;
+    if (hdr->data_len < IRIGFIX_FLOG_TM_BODY_BYTES) return false;
+
+    memset(entry, 0, sizeof(LogEntry));
+    entry->timestamp_us = hdr->time_us;
+    entry->entry_id = get_le32(body + 0);
+    entry->camera_frame_id = get_le32(body + 4);
+    entry->camera_data_size = get_le32(body + 8);
+    entry->last_command_type = body[12];
+    entry->last_thrust_cmd = bits_float(get_le32(body + 16));
+    frame_from_le(&entry->telemetry, body + IRIGFIX_FLOG_TM_PREFIX_BYTES);
+
+    return true;
+}
+
+bool FlightLog_DecodeCamera(const FlightLogPacketHeader *hdr, const uint8_t *body,
+                            uint32_t *frame_id, const uint8_t **data, uint32_t *size)
+{
+    if (!hdr || !body || !frame_id || !data || !size) return false;
+    if (hdr->data_type != IRIGFIX_FLOG_TYPE_CAMERA) return false;
+    if (hdr->data_len < IRIGFIX_FLOG_CAM_PREFIX_BYTES) return false;
+
+    *frame_id = get_le32(body + 0);
+    *size = get_le32(body + 4);
+    if (*size > hdr->data_len - IRIGFIX_FLOG_CAM_PREFIX_BYTES) return false;
+
+    *data = body + IRIGFIX_FLOG_CAM_PREFIX_BYTES;
+    return true;
+}
+
+bool FlightLog_DecodeCommit(const FlightLogPacketHeader *hdr, const uint8_t *body,
+                            uint64_t *telemetry_packets, uint64_t *commit_offset)
+{
+    if (!hdr || !body || !telemetry_packets || !commit_offset) return false;
+    if (hdr->data_type != IRIGFIX_FLOG_TYPE_COMMIT) return false;
+    if (hdr->data_len < IRIGFIX_FLOG_COMMIT_BYTES) return false;
+
+    *telemetry_packets = get_le64(body + 0);
+    *commit_offset = get_le64(body + 8);
+    return true;
+}
+
+uint32_t FlightLog_DecodeIndex(const FlightLogPacketHeader *hdr, const uint8_t *body,
+                               FlightLogIndexEntry *out, uint32_t max)
+{
+    if (!hdr || !body || hdr->data_type != IRIGFIX_FLOG_TYPE_INDEX) return 0;
+
+    uint32_t count = hdr->data_len / IRIGFIX_FLOG_INDEX_ENTRY_BYTES;
+    if (!out) return count;
+    if (count > max) count = max;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *e = body + (size_t)i * IRIGFIX_FLOG_INDEX_ENTRY_BYTES;
+        out[i].time_us = get_le64(e);
+        out[i].offset = get_le64(e + 8);
+    }
+    return count;
+}
+
+/* time_us 이하인 마지막 색인 항목 (이진 탐색), 없으면 -1 */
+int64_t FlightLog_IndexLookup(const FlightLogIndexEntry *index, uint32_t count,
+                              uint64_t time_us)
+{
+    if (!index || count == 0) return -1;
+
+    uint32_t lo = 0, hi = count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (index[mid].time_us <= time_us) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (int64_t)lo - 1;
+}
+
+/* ============================================================
+ * 파일 읽기
+ * ============================================================ */
+
+static bool read_packet_at(FlightLogReader *reader, uint64_t offset, uint64_t limit,
+                           FlightLogPacketHeader *hdr)
+{
+    if (offset + IRIGFIX_FLOG_HEADER_BYTES > limit) return false;
+    if (fseeko(reader->file, (off_t)offset, SEEK_SET) != 0) return false;
+
+    uint8_t head[IRIGFIX_FLOG_HEADER_BYTES];
+    if (fread(head, 1, sizeof(head), reader->file) != sizeof(head)) return false;
+    if (!FlightLog_ParseHeader(head, sizeof(head), hdr)) return false;
+    if (offset + hdr->packet_len > limit) return false;
+
+    if (hdr->packet_len > reader->packet_cap) {
+        uint8_t *grown = realloc(reader->packet_buf, hdr->packet_len);
+        if (!grown) return false;
+        reader->packet_buf = grown;
+        reader->packet_cap = hdr->packet_len;
+    }
+
+    memcpy(reader->packet_buf, head, sizeof(head));
+    uint32_t rest = hdr->packet_len - IRIGFIX_FLOG_HEADER_BYTES;
+    if (fread(reader->packet_buf + IRIGFIX_FLOG_HEADER_BYTES, 1, rest, reader->file) != rest) {
+        return false;
+    }
+
+    return FlightLog_VerifyPacket(reader->packet_buf, hdr->packet_len, hdr);
+}
+
+static bool load_footer(FlightLogReader *reader)
+{
+    if (reader->file_size < IRIGFIX_FLOG_TRAILER_BYTES) return false;
+
+    uint64_t trailer_pos = reader->file_size - IRIGFIX_FLOG_TRAILER_BYTES;
+    uint8_t trailer[IRIGFIX_FLOG_TRAILER_BYTES];
+    uint64_t index_offset;
+
+    if (fseeko(reader->file, (off_t)trailer_pos, SEEK_SET) != 0) return false;
+    if (fread(trailer, 1, sizeof(trailer), reader->file) != sizeof(trailer)) return false;
+    if (!FlightLog_ParseTrailer(trailer, &index_offset)) return false;
+
+    FlightLogPacketHeader hdr;
+    if (!read_packet_at(reader, index_offset, trailer_pos, &hdr)) return false;
+    if (hdr.data_type != IRIGFIX_FLOG_TYPE_INDEX) return false;
+
+    const uint8_t *body = reader->packet_buf + IRIGFIX_FLOG_HEADER_BYTES;
+    uint32_t count = FlightLog_DecodeIndex(&hdr, body, NULL, 0);
+    if (count > 0) {
+        reader->index = malloc((size_t)count * sizeof(FlightLogIndexEntry));
+        if (!reader->index) return false;
+        reader->index_count = FlightLog_DecodeIndex(&hdr, body, reader->index, count);
+    }
+
+    reader->data_end = index_offset;
+    reader->has_footer = true;
+    return true;
+}
+
+/* 트레일러 없음 (기록 중단): 마지막 유효 패킷까지 훑어서 색인 재구성 */
+static void scan_packets(FlightLogReader *reader)
+{
+    uint32_t capacity = 0;
+    uint32_t telemetry_packets = 0;
+    uint64_t pos = 0;
+    FlightLogPacketHeader hdr;
+
+    while (read_packet_at(reader, pos, reader->file_size, &hdr)) {
+        if (hdr.channel_id == IRIGFIX_FLOG_CHANNEL_TELEMETRY &&
+            telemetry_packets++ % PT_FLOG_INDEX_STRIDE == 0) {
+            if (reader->index_count == capacity) {
+                uint32_t cap = capacity ? capacity * 2 : 256;
+                FlightLogIndexEntry *grown = realloc(reader->index,
+                                                     (size_t)cap * sizeof(FlightLogIndexEntry));
+                if (!grown) break;
+                reader->index = grown;
+                capacity = cap;
+            }
+            reader->index[reader->index_count].time_us = hdr.time_us;
+            reader->index[reader->index_count].offset = pos;
+            reader->index_count++;
+        }
+        pos += hdr.packet_len;
+    }
+
+    reader->data_end = pos;
+}
+
+FlightLogReader* FlightLogReader_Open(const char *filename)
+{
+    if (!filename) return NULL;
+
+    FlightLogReader *reader = malloc(sizeof(FlightLogReader));
+    if (!reader) return NULL;
+    memset(reader, 0, sizeof(FlightLogReader));
+
+    reader->file = fopen(filename, "rb");
+    if (!reader->file) {
+        free(reader);
+        return NULL;
+    }
+
+    fseeko(reader->file, 0, SEEK_END);
+    reader->file_size = (uint64_t)ftello(reader->file);
+
+    /* 첫 패킷은 SETUP 이어야 함 */
+    FlightLogPacketHeader hdr;
+    if (!read_packet_at(reader, 0, reader->file_size, &hdr) ||
+        hdr.data_type != IRIGFIX_FLOG_TYPE_SETUP) {
+        FlightLogReader_Close(reader);
+        return NULL;
+    }
+
+    if (!load_footer(reader)) {
+        if (reader->index) free(reader->index);
+        reader->index = NULL;
+        reader->index_count = 0;
+        reader->has_footer = false;
+        scan_packets(reader);
+    }
+
+    reader->position = 0;
+    return reader;
+}
+
+void FlightLogReader_Close(FlightLogReader *reader)
+{
+    if (!reader) return;
+
+    if (reader->file) fclose(reader->file);
+    if (reader->index) free(reader->index);
+    if (reader->packet_buf) free(reader->packet_buf);
+    free(reader);
+}
+
+bool FlightLogReader_Next(FlightLogReader *reader, FlightLogPacketHeader *hdr,
+                          const uint8_t **body)
+{
+    if (!reader || !hdr || !body) return false;
+
+    if (!read_packet_at(reader, reader->position, reader->data_end, hdr)) return false;
+
+    *body = reader->packet_buf + IRIGFIX_FLOG_HEADER_BYTES;
+    reader->position += hdr->packet_len;
+    return true;
+}
+
+bool FlightLogReader_SeekTime(FlightLogReader *reader, uint64_t time_us)
+{
+    if (!reader) return false;
+
+    int64_t i = FlightLog_IndexLookup(reader->index, reader->index_count, time_us);
+    uint64_t pos = (i >= 0) ? reader->index[i].offset : 0;
+    FlightLogPacketHeader hdr;
+
+    /* 색인 간격 (최대 PT_FLOG_INDEX_STRIDE 패킷) 안에서 순차 탐색 */
+    while (read_packet_at(reader, pos, reader->data_end, &hdr)) {
+        if (hdr.channel_id == IRIGFIX_FLOG_CHANNEL_TELEMETRY && hdr.time_us >= time_us) {
+            reader->position = pos;
+            return true;
+        }
+        pos += hdr.packet_len;
+    }
+
+    reader->position = reader->data_end;
+    return false;
+}
+
+void FlightLogReader_Rewind(FlightLogReader *reader)
+{
+    if (reader) reader->position = 0;
+}
@@ -0,0 +1,316 @@
+#include "flight_log_map.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* ============================================================
+ * 메모리 매핑 비행 로그 리더 구현
+ * ============================================================ */
+
+static long page_size(void)
+{
+    long ps = sysconf(_SC_PAGESIZE);
+    return ps > 0 ? ps : 4096;
+}
+
+static void advise_range(const FlightLogMap *map, uint64_t offset, uint64_t len, int advice)
+{
+    uint64_t ps = (uint64_t)page_size();
+    uint64_t start = offset & ~(ps - 1);
+    uint64_t end = offset + len;
+    if (end > map->size) end = map->size;
+    if (end <= start) return;
+
+    madvise((void *)(map->base + start), end - start, advice);
+}
+
+/* 헤더만 확인 (본문 CRC 는 실제 사용하는 패킷에서만) */
+static bool header_at(const FlightLogMap *map, uint64_t offset, FlightLogPacketHeader *hdr)
+{
+    if (offset >= map->data_end) return false;
+    if (!FlightLog_ParseHeader(map->base + offset, map->data_end - offset, hdr)) return false;
+    return offset + hdr->packet_len <= map->data_end;
+}
+
+static bool load_footer(FlightLogMap *map)
+{
+    if (map->size < IRIGFIX_FLOG_TRAILER_BYTES) return false;
+
+    uint64_t trailer_pos = map->size - IRIGFIX_FLOG_TRAILER_BYTES;
+    uint64_t index_offset;
+    if (!FlightLog_ParseTrailer(map->base + trailer_pos, &index_offset)) return false;
+    if (index_offset >= trailer_pos) return false;
+
+    FlightLogPacketHeader hdr;
+    const uint8_t *p = map->base + index_offset;
+    if (!FlightLog_VerifyPacket(p, trailer_pos - index_offset, &hdr)) return false;
+    if (hdr.data_type != IRIGFIX_FLOG_TYPE_INDEX) return false;
+
+    const uint8_t *body = p + IRIGFIX_FLOG_HEADER_BYTES;
+    uint32_t count = FlightLog_DecodeIndex(&hdr, body, NULL, 0);
+    if (count > 0) {
+        map->index = malloc((size_t)count * sizeof(FlightLogIndexEntry));
+        if (!map->index) return false;
+        map->index_count = FlightLog_DecodeIndex(&hdr, body, map->index, count);
+    }
+
+    map->data_end = index_offset;
+    map->has_footer = true;
+    return true;
+}
+
+/* 트레일러 없음: 유효 패킷 끝까지 검증하며 색인 재구성 (전체 접근) */
+static void scan_packets(FlightLogMap *map)
+{
+    uint32_t capacity = 0;
+    uint64_t pos = 0;
+    FlightLogPacketHeader hdr;
+
+    advise_range(map, 0, map->size, MADV_SEQUENTIAL);
+
+    while (pos < map->size &&
+           FlightLog_VerifyPacket(map->base + pos, map->size - pos, &hdr)) {
+        if (hdr.channel_id == IRIGFIX_FLOG_CHANNEL_TELEMETRY) {
+            if (map->entry_count % PT_FLOG_INDEX_STRIDE == 0) {
+                if (map->index_count == capacity) {
+                    uint32_t cap = capacity ? capacity * 2 : 256;
+                    FlightLogIndexEntry *grown = realloc(map->index,
+                                                         (size_t)cap * sizeof(FlightLogIndexEntry));
+                    if (!grown) break;
+                    map->index = grown;
+                    capacity = cap;
+                }
+                map->index[map->index_count].time_us = hdr.time_us;
+                map->index[map->index_count].offset = pos;
+                map->index_count++;
+            }
+            map->entry_count++;
+        }
+        pos += hdr.packet_len;
+    }
+
+    map->data_end = pos;
+    advise_range(map, 0, map->size, MADV_RANDOM);
+}
+
+/* 마지막 색인 구간만 헤더를 따라가 전체 엔트리 수 계산 */
+static uint32_t count_entries(const FlightLogMap *map)
+{
+    if (map->index_count == 0) return 0;
+
+    uint32_t count = (map->index_count - 1) * PT_FLOG_INDEX_STRIDE;
+    uint64_t pos = map->index[map->index_count - 1].offset;
+    FlightLogPacketHeader hdr;
+
+    while (header_at(map, pos, &hdr)) {
+        if (hdr.channel_id == IRIGFIX_FLOG_CHANNEL_TELEMETRY) count++;
+        pos += hdr.packet_len;
+    }
+    return count;
+}
+
+FlightLogMap* FlightLogMap_Open(const char *filename)
+{
+    if (!filename) return NULL;
+
+    FlightLogMap *map = malloc(sizeof(FlightLogMap));
+    if (!map) return NULL;
+    memset(map, 0, sizeof(FlightLogMap));
+
+    map->fd = open(filename, O_RDONLY);
+    if (map->fd < 0) {
+        free(map);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(map->fd, &st) != 0 || st.st_size < IRIGFIX_FLOG_HEADER_BYTES) {
+        close(map->fd);
+        free(map);
+        return NULL;
+    }
+    map->size = (uint64_t)st.st_size;
+
+    void *base = mmap(NULL, map->size, PROT_READ, MAP_PRIVATE, map->fd, 0);
+    if (base == MAP_FAILED) {
+        close(map->fd);
+        free(map);
+        return NULL;
+    }
+    map->base = (const uint8_t *)base;
+    map->data_end = map->size;
+
+    /* 색인 기반 임의 접근이 기본: 카메라 데이터 미리 읽기 방지 */
+    advise_range(map, 0, map->size, MADV_RANDOM);
+
+    FlightLogPacketHeader hdr;
+    if (!FlightLog_VerifyPacket(map->base, map->size, &hdr) ||
+        hdr.data_type != IRIGFIX_FLOG_TYPE_SETUP) {
+        FlightLogMap_Close(map);
+        return NULL;
+    }
+
+    if (load_footer(map)) {
+        map->entry_count = count_entries(map);
+    } else {
+        if (map->index) free(map->index);
+        map->index = NULL;
+        map->index_count = 0;
+        map->data_end = map->size;
+        scan_packets(map);
+    }
+
+    return map;
+}
+
+void FlightLogMap_Close(FlightLogMap *map)
+{
+    if (!map) return;
+
+    if (map->base) munmap((void *)map->base, map->size);
+    if (map->fd >= 0) close(map->fd);
+    if (map->index) free(map->index);
+    free(map);
+}
+
+void FlightLogMap_Advise(FlightLogMap *map, FlightLogAccess pattern)
+{
+    if (!map) return;
+
+    int advice = MADV_RANDOM;
+    if (pattern == FLOG_ACCESS_SEQUENTIAL) advice = MADV_SEQUENTIAL;
+    if (pattern == FLOG_ACCESS_WILLNEED) advice = MADV_WILLNEED;
+
+    advise_range(map, 0, map->size, advice);
+}
+
+uint32_t FlightLogMap_GetEntryCount(const FlightLogMap *map)
+{
+    if (!map) return 0;
+    return map->entry_count;
+}
+
+bool FlightLogMap_GetEntry(const FlightLogMap *map, uint32_t index,
+                           FlightLogEntryView *view)
+{
+    if (!map || !view || index >= map->entry_count) return false;
+
+    uint32_t chunk = index / PT_FLOG_INDEX_STRIDE;
+    uint32_t skip = index % PT_FLOG_INDEX_STRIDE;
+    if (chunk >= map->index_count) return false;
+
+    uint64_t pos = map->index[chunk].offset;
+    FlightLogPacketHeader hdr;
+
+    /* 색인 구간 안에서 텔레메트리 패킷 skip 개 건너뜀 (헤더만 접근) */
+    for (;;) {
+        if (!header_at(map, pos, &hdr)) return false;
+        if (hdr.channel_id == IRIGFIX_FLOG_CHANNEL_TELEMETRY) {
+            if (skip == 0) break;
+            skip--;
+        }
+        pos += hdr.packet_len;
+    }
+
+    const uint8_t *p = map->base + pos;
+    if (!FlightLog_VerifyPacket(p, map->data_end - pos, &hdr) ||
+        hdr.data_len < IRIGFIX_FLOG_TM_BODY_BYTES) {
+        return false;
+    }
+
+    LogEntry entry;
+    const uint8_t *body = p + IRIGFIX_FLOG_HEADER_BYTES;
+    FlightLog_DecodeTelemetry(&hdr, body, &entry);
+
+    view->timestamp_us = entry.timestamp_us;
+    view->entry_id = entry.entry_id;
+    view->camera_frame_id = entry.camera_frame_id;
+    view->last_command_type = entry.last_command_type;
+    view->last_thrust_cmd = entry.last_thrust_cmd;
+    view->packet_offset = pos;
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    view->telemetry = (const MissileTelemetryFrame *)(body + IRIGFIX_FLOG_TM_PREFIX_BYTES);
+#else
+    view->storage = entry.telemetry;
+    view->telemetry = &view->storage;
+#endif
+
+    /* 같은 엔트리의 카메라 패킷은 바로 뒤에 기록됨 */
+    FlightLogPacketHeader next;
+    uint64_t next_pos = pos + hdr.packet_len;
+    view->camera_offset = (header_at(map, next_pos, &next) &&
+                           next.channel_id == IRIGFIX_FLOG_CHANNEL_CAMERA)
+                          ? next_pos : 0;
+
+    return true;
+}
+
+/* time_us 이상인 첫 엔트리, 없으면 -1 */
+int64_t FlightLogMap_FindTime(const FlightLogMap *map, uint64_t time_us)
+{
+    if (!map || map->entry_count == 0) return -1;
+
+    int64_t chunk = FlightLog_IndexLookup(map->index, map->index_count, time_us);
+    uint32_t i = (chunk > 0) ? (uint32_t)chunk * PT_FLOG_INDEX_STRIDE : 0;
+
+    uint64_t pos = map->index[chunk > 0 ? chunk : 0].offset;
+    FlightLogPacketHeader hdr;
+
+    while (header_at(map, pos, &hdr)) {
+        if (hdr.channel_id == IRIGFIX_FLOG_CHANNEL_TELEMETRY) {
+            if (hdr.time_us >= time_us) return i;
+            i++;
+        }
+        pos += hdr.packet_len;
+    }
+    return -1;
+}
+
+/* [start_us, end_us) 범위 엔트리: *first 부터 반환값 개수 (LogBuffer 질의와 같은 의미) */
+uint32_t FlightLogMap_QueryRange(const FlightLogMap *map, uint64_t start_us,
+                                 uint64_t end_us, uint32_t *first)
+{
+    if (!map || !first) return 0;
+
+    int64_t lo = FlightLogMap_FindTime(map, start_us);
+    *first = (lo >= 0) ? (uint32_t)lo : map->entry_count;
+    if (end_us <= start_us) return 0;
+
+    int64_t hi = FlightLogMap_FindTime(map, end_us);
+    uint32_t end = (hi >= 0) ? (uint32_t)hi : map->entry_count;
+
+    return end - *first;
+}
+
+bool FlightLogMap_GetCamera(const FlightLogMap *map, const FlightLogEntryView *view,
+                            const uint8_t **data, uint32_t *size)
+{
+    if (!map || !view || !data || !size || view->camera_offset == 0) return false;
+
+    FlightLogPacketHeader hdr;
+    if (!header_at(map, view->camera_offset, &hdr)) return false;
+
+    /* 접두부 8바이트만 읽고 페이로드는 비동기 미리 읽기만 요청 */
+    const uint8_t *body = map->base + view->camera_offset + IRIGFIX_FLOG_HEADER_BYTES;
+    uint32_t frame_id;
+    if (!FlightLog_DecodeCamera(&hdr, body, &frame_id, data, size) ||
+        frame_id != view->camera_frame_id) {
+        return false;
+    }
+
+    advise_range(map, (uint64_t)(*data - map->base), *size, MADV_WILLNEED);
+    return true;
+}
+
+bool FlightLogMap_VerifyCamera(const FlightLogMap *map, const FlightLogEntryView *view)
+{
+    if (!map || !view || view->camera_offset == 0) return false;
+
+    FlightLogPacketHeader hdr;
+    return FlightLog_VerifyPacket(map->base + view->camera_offset,
+                                  map->data_end - view->camera_offset, &hdr);
+}
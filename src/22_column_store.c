@@ -0,0 +1,599 @@
+#include "column_store.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/* ============================================================
+ * 열 저장 내보내기 / 읽기 구현
+ *
+ * 행 단위 LogEntry (약 250바이트) 를 채널 테이블 기준으로 전치한다.
+ * 한 채널만 보는 분석은 그 열의 청크만 읽으면 되고, 청크별 min/max 는
+ * 디렉터리에 있으므로 본문을 읽지 않고도 청크를 건너뛸 수 있다.
+ * 변환은 열 단위로 독립이라 스레드들이 열을 하나씩 가져가 처리한다.
+ * ============================================================ */
+
+/* ============================================================
+ * 리틀 엔디언 입출력
+ * ============================================================ */
+
+static inline void put_le(uint8_t *p, uint64_t v, int size)
+{
+    for (int i = 0; i < size; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static inline uint64_t get_le(const uint8_t *p, int size)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < size; i++) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+static inline void put_f64(uint8_t *p, double d)
+{
+    uint64_t v;
+    memcpy(&v, &d, 8);
+    put_le(p, v, 8);
+}
+
+static inline double get_f64(const uint8_t *p)
+{
+    uint64_t v = get_le(p, 8);
+    double d;
+    memcpy(&d, &v, 8);
+    return d;
+}
+
+static inline int bit_width(uint64_t v)
+{
+    return v ? 64 - __builtin_clzll(v) : 0;
+}
+
+/* 채널 원시 비트 → 값 */
+static inline double raw_to_double(TelemetryChannelType type, uint64_t bits)
+{
+    switch (type) {
+        case CHANNEL_TYPE_F32: { uint32_t b = (uint32_t)bits; float f; memcpy(&f, &b, 4); return f; }
+        case CHANNEL_TYPE_F64: { double d; memcpy(&d, &bits, 8); return d; }
+        default: return (double)bits;
+    }
+}
+
+static inline uint64_t size_mask(int size)
+{
+    return (size < 8) ? (1ULL << (size * 8)) - 1 : ~0ULL;
+}
+
+/* ============================================================
+ * 청크 인코딩
+ * ============================================================ */
+
+typedef struct {
+    uint8_t *buf;
+    uint32_t pos;
+    uint64_t acc;
+    int nbits;
+} BitWriter;
+
+static inline void bw_put(BitWriter *bw, uint64_t value, int width)
+{
+    while (width > 0) {
+        int take = (width > 32) ? 32 : width;
+        bw->acc |= (value & ((1ULL << take) - 1)) << bw->nbits;
+        bw->nbits += take;
+        value >>= take;
+        width -= take;
+
+        while (bw->nbits >= 8) {
+            bw->buf[bw->pos++] = (uint8_t)bw->acc;
+            bw->acc >>= 8;
+            bw->nbits -= 8;
+        }
+    }
+}
+
+static inline void bw_flush(BitWriter *bw)
+{
+    if (bw->nbits > 0) {
+        bw->buf[bw->pos++] = (uint8_t)bw->acc;
+        bw->acc = 0;
+        bw->nbits = 0;
+    }
+}
+
+static inline uint64_t zigzag_delta(uint64_t v, uint64_t prev, int size)
+{
+    int shift = 64 - size * 8;
+    uint64_t d = (v - prev) & size_mask(size);
+    int64_t sd = (int64_t)(d << shift) >> shift;
+    return ((uint64_t)sd << 1) ^ (uint64_t)(sd >> 63);
+}
+
+/* 한 청크를 out 에 인코딩, 반환: 본문 바이트 수 */
+static uint32_t encode_chunk(const TelemetryChannelDesc *ch, const uint64_t *vals,
+                             uint32_t rows, bool compress, uint8_t *out,
+                             ColumnChunkInfo *info)
+{
+    double lo = NAN, hi = NAN;
+    for (uint32_t i = 0; i < rows; i++) {
+        double v = raw_to_double(ch->type, vals[i]);
+        if (isnan(v)) continue;
+        if (isnan(lo) || v < lo) lo = v;
+        if (isnan(hi) || v > hi) hi = v;
+    }
+    info->min = lo;
+    info->max = hi;
+    info->row_count = rows;
+    info->width = 0;
+
+    uint32_t raw_len = rows * ch->size;
+
+    if (compress && rows > 0) {
+        uint64_t any = 0;
+        for (uint32_t i = 1; i < rows; i++) {
+            any |= zigzag_delta(vals[i], vals[i - 1], ch->size);
+        }
+        int width = bit_width(any);
+        uint32_t delta_len = 8 + (uint32_t)(((uint64_t)width * (rows - 1) + 7) / 8);
+
+        if (delta_len < raw_len) {
+            put_le(out, vals[0], 8);
+            BitWriter bw = { out + 8, 0, 0, 0 };
+            for (uint32_t i = 1; i < rows; i++) {
+                bw_put(&bw, zigzag_delta(vals[i], vals[i - 1], ch->size), width);
+            }
+            bw_flush(&bw);
+
+            info->encoding = IRIGFIX_COLUMN_ENC_DELTA;
+            info->width = (uint8_t)width;
+            info->data_len = 8 + bw.pos;
+            return info->data_len;
+        }
+    }
+
+    for (uint32_t i = 0; i < rows; i++) {
+        put_le(out + (size_t)i * ch->size, vals[i], ch->size);
+    }
+    info->encoding = IRIGFIX_COLUMN_ENC_RAW;
+    info->data_len = raw_len;
+    return raw_len;
+}
+
+/* ============================================================
+ * 병렬 내보내기
+ * ============================================================ */
+
+typedef struct {
+    uint8_t *data;                      /* 청크 본문 연속 */
+    uint64_t data_len;
+    ColumnChunkInfo *chunks;
+    uint32_t chunk_count;
+    bool compress;
+    bool ok;
+} ColumnJob;
+
+typedef struct {
+    const LogEntry **rows;              /* 시간 순서 행 포인터 */
+    uint32_t row_count;
+    uint32_t chunk_rows;
+    ColumnJob *jobs;
+    _Atomic int next_column;
+} ExportContext;
+
+static void export_column(ExportContext *ctx, int c)
+{
+    const TelemetryChannelDesc *ch = &TelemetryChannels[c];
+    ColumnJob *job = &ctx->jobs[c];
+    uint32_t n = ctx->row_count;
+    uint32_t chunk_count = (n + ctx->chunk_rows - 1) / ctx->chunk_rows;
+
+    uint64_t *vals = malloc(((size_t)n + 1) * sizeof(uint64_t));
+    job->chunks = malloc(((size_t)chunk_count + 1) * sizeof(ColumnChunkInfo));
+    /* DELTA 는 이득이 있을 때만 쓰므로 RAW 크기가 상한 */
+    job->data = malloc((size_t)n * ch->size + 1);
+    if (!vals || !job->chunks || !job->data) {
+        if (vals) free(vals);
+        return;
+    }
+
+    /* 전치: 행마다 이 채널의 바이트만 읽음 */
+    for (uint32_t i = 0; i < n; i++) {
+        uint64_t v = 0;
+        memcpy(&v, (const uint8_t *)&ctx->rows[i]->telemetry + ch->offset, ch->size);
+        vals[i] = v;
+    }
+
+    uint64_t pos = 0;
+    for (uint32_t k = 0; k < chunk_count; k++) {
+        uint32_t first = k * ctx->chunk_rows;
+        uint32_t rows = (n - first < ctx->chunk_rows) ? n - first : ctx->chunk_rows;
+
+        job->chunks[k].offset = pos;
+        pos += encode_chunk(ch, vals + first, rows, job->compress,
+                            job->data + pos, &job->chunks[k]);
+    }
+
+    job->data_len = pos;
+    job->chunk_count = chunk_count;
+    job->ok = true;
+    free(vals);
+}
+
+static void* export_worker(void *arg)
+{
+    ExportContext *ctx = (ExportContext *)arg;
+
+    for (;;) {
+        int c = atomic_fetch_add(&ctx->next_column, 1);
+        if (c >= TELEMETRY_NUM_CHANNELS) break;
+        export_column(ctx, c);
+    }
+    return NULL;
+}
+
+static bool write_store(FILE *file, const ExportContext *ctx)
+{
+    uint8_t header[IRIGFIX_COLUMN_HEADER_BYTES] = {0};
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header)) return false;
+
+    /* 열 본문: 청크 오프셋을 파일 기준으로 바꾸면서 기록 */
+    uint64_t offset = IRIGFIX_COLUMN_HEADER_BYTES;
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+        ColumnJob *job = &ctx->jobs[c];
+        if (job->data_len > 0 && fwrite(job->data, 1, job->data_len, file) != job->data_len) {
+            return false;
+        }
+        for (uint32_t k = 0; k < job->chunk_count; k++) {
+            job->chunks[k].offset += offset;
+        }
+        offset += job->data_len;
+    }
+
+    /* 디렉터리: 열 항목 전부, 이어서 청크 표 */
+    uint64_t directory_offset = offset;
+    uint64_t table_offset = directory_offset +
+                            (uint64_t)TELEMETRY_NUM_CHANNELS * IRIGFIX_COLUMN_ENTRY_BYTES;
+
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+        const TelemetryChannelDesc *ch = &TelemetryChannels[c];
+        const ColumnJob *job = &ctx->jobs[c];
+        uint8_t entry[IRIGFIX_COLUMN_ENTRY_BYTES] = {0};
+
+        strncpy((char *)entry, ch->name, IRIGFIX_COLUMN_NAME_BYTES - 1);
+        entry[32] = (uint8_t)ch->type;
+        entry[33] = ch->size;
+        entry[34] = job->compress ? IRIGFIX_COLUMN_ENC_DELTA : IRIGFIX_COLUMN_ENC_RAW;
+        put_le(entry + 36, job->chunk_count, 4);
+        put_le(entry + 40, table_offset, 8);
+        if (fwrite(entry, 1, sizeof(entry), file) != sizeof(entry)) return false;
+
+        table_offset += (uint64_t)job->chunk_count * IRIGFIX_COLUMN_CHUNK_ENTRY_BYTES;
+    }
+
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+        const ColumnJob *job = &ctx->jobs[c];
+        for (uint32_t k = 0; k < job->chunk_count; k++) {
+            const ColumnChunkInfo *info = &job->chunks[k];
+            uint8_t entry[IRIGFIX_COLUMN_CHUNK_ENTRY_BYTES] = {0};
+
+            put_le(entry + 0, info->offset, 8);
+            put_le(entry + 8, info->data_len, 4);
+            put_le(entry + 12, info->row_count, 4);
+            put_f64(entry + 16, info->min);
+            put_f64(entry + 24, info->max);
+            entry[32] = info->encoding;
+            entry[33] = info->width;
+            if (fwrite(entry, 1, sizeof(entry), file) != sizeof(entry)) return false;
+        }
+    }
+
+    /* 디렉터리까지 다 쓴 뒤 헤더 완성 */
+    put_le(header + 0, IRIGFIX_COLUMN_MAGIC, 4);
+    put_le(header + 4, IRIGFIX_COLUMN_VERSION, 4);
+    put_le(header + 8, TELEMETRY_NUM_CHANNELS, 4);
+    put_le(header + 12, ctx->chunk_rows, 4);
+    put_le(header + 16, ctx->row_count, 8);
+    put_le(header + 24, directory_offset, 8);
+
+    if (fseek(file, 0, SEEK_SET) != 0) return false;
+    return fwrite(header, 1, sizeof(header), file) == sizeof(header);
+}
+
+bool ColumnStore_Export(LogBuffer *log, const char *filename,
+                        const ColumnExportOptions *options)
+{
+    if (!log || !filename) return false;
+
+    uint32_t chunk_rows = (options && options->chunk_rows) ? options->chunk_rows
+                                                           : PT_COLUMN_CHUNK_ROWS;
+    uint32_t threads = (options && options->threads) ? options->threads
+                                                     : PT_COLUMN_EXPORT_THREADS;
+    if (threads > TELEMETRY_NUM_CHANNELS) threads = TELEMETRY_NUM_CHANNELS;
+
+    ExportContext ctx;
+    ctx.row_count = DataStorage_GetEntryCount(log);
+    ctx.chunk_rows = chunk_rows;
+    atomic_init(&ctx.next_column, 0);
+
+    ctx.rows = malloc(((size_t)ctx.row_count + 1) * sizeof(LogEntry *));
+    ctx.jobs = calloc(TELEMETRY_NUM_CHANNELS, sizeof(ColumnJob));
+    if (!ctx.rows || !ctx.jobs) {
+        if (ctx.rows) free(ctx.rows);
+        if (ctx.jobs) free(ctx.jobs);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < ctx.row_count; i++) {
+        ctx.rows[i] = DataStorage_ReadEntryChrono(log, i);
+    }
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+        bool compress = options ? options->compress : false;
+        if (options && options->compress_column) compress = options->compress_column[c];
+        ctx.jobs[c].compress = compress;
+    }
+
+    /* 스레드 생성에 실패하면 호출 스레드가 남은 열을 처리 */
+    pthread_t tids[TELEMETRY_NUM_CHANNELS];
+    uint32_t started = 0;
+    for (uint32_t t = 1; t < threads; t++) {
+        if (pthread_create(&tids[started], NULL, export_worker, &ctx) == 0) started++;
+    }
+    export_worker(&ctx);
+    for (uint32_t t = 0; t < started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+
+    bool ok = true;
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+        if (!ctx.jobs[c].ok) ok = false;
+    }
+
+    if (ok) {
+        FILE *file = fopen(filename, "wb");
+        ok = file && write_store(file, &ctx);
+        if (file && fclose(file) != 0) ok = false;
+    }
+
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+        if (ctx.jobs[c].data) free(ctx.jobs[c].data);
+        if (ctx.jobs[c].chunks) free(ctx.jobs[c].chunks);
+    }
+    free(ctx.jobs);
+    free(ctx.rows);
+    return ok;
+}
+
+/* ============================================================
+ * 읽기
+ * ============================================================ */
+
+static bool read_at(ColumnStore *store, void *buf, size_t len, uint64_t offset)
+{
+    uint8_t *p = (uint8_t *)buf;
+    size_t done = 0;
+
+    while (done < len) {
+        ssize_t n = pread(store->fd, p + done, len - done, (off_t)(offset + done));
+        if (n <= 0) return false;
+        done += (size_t)n;
+    }
+    store->bytes_read += len;
+    return true;
+}
+
+static bool load_directory(ColumnStore *store, uint64_t directory_offset, uint64_t file_size)
+{
+    uint64_t entries_len = (uint64_t)store->column_count * IRIGFIX_COLUMN_ENTRY_BYTES;
+    if (directory_offset + entries_len > file_size) return false;
+
+    uint8_t *entries = malloc(entries_len);
+    store->columns = calloc(store->column_count, sizeof(ColumnInfo));
+    if (!entries || !store->columns) {
+        if (entries) free(entries);
+        return false;
+    }
+    if (!read_at(store, entries, entries_len, directory_offset)) {
+        free(entries);
+        return false;
+    }
+
+    bool ok = true;
+    for (uint32_t c = 0; ok && c < store->column_count; c++) {
+        const uint8_t *e = entries + (size_t)c * IRIGFIX_COLUMN_ENTRY_BYTES;
+        ColumnInfo *col = &store->columns[c];
+
+        memcpy(col->name, e, IRIGFIX_COLUMN_NAME_BYTES);
+        col->name[IRIGFIX_COLUMN_NAME_BYTES - 1] = '\0';
+        col->type = (TelemetryChannelType)e[32];
+        col->size = e[33];
+        col->encoding = e[34];
+        col->chunk_count = (uint32_t)get_le(e + 36, 4);
+        uint64_t table_offset = get_le(e + 40, 8);
+
+        uint64_t table_len = (uint64_t)col->chunk_count * IRIGFIX_COLUMN_CHUNK_ENTRY_BYTES;
+        if (col->size == 0 || col->size > 8 || table_offset + table_len > file_size) {
+            ok = false;
+            break;
+        }
+
+        uint8_t *table = malloc(table_len + 1);
+        col->chunks = malloc(((size_t)col->chunk_count + 1) * sizeof(ColumnChunkInfo));
+        if (!table || !col->chunks || !read_at(store, table, table_len, table_offset)) {
+            if (table) free(table);
+            ok = false;
+            break;
+        }
+
+        for (uint32_t k = 0; k < col->chunk_count; k++) {
+            const uint8_t *t = table + (size_t)k * IRIGFIX_COLUMN_CHUNK_ENTRY_BYTES;
+            ColumnChunkInfo *info = &col->chunks[k];
+
+            info->offset = get_le(t + 0, 8);
+            info->data_len = (uint32_t)get_le(t + 8, 4);
+            info->row_count = (uint32_t)get_le(t + 12, 4);
+            info->min = get_f64(t + 16);
+            info->max = get_f64(t + 24);
+            info->encoding = t[32];
+            info->width = t[33];
+
+            if (info->offset + info->data_len > directory_offset ||
+                info->row_count > store->chunk_rows || info->width > 64) {
+                ok = false;
+            }
+        }
+        free(table);
+    }
+
+    free(entries);
+    return ok;
+}
+
+ColumnStore* ColumnStore_Open(const char *filename)
+{
+    if (!filename) return NULL;
+
+    ColumnStore *store = malloc(sizeof(ColumnStore));
+    if (!store) return NULL;
+    memset(store, 0, sizeof(ColumnStore));
+    atomic_init(&store->bytes_read, 0);
+
+    store->fd = open(filename, O_RDONLY);
+    if (store->fd < 0) {
+        free(store);
+        return NULL;
+    }
+
+    uint64_t file_size = (uint64_t)lseek(store->fd, 0, SEEK_END);
+    uint8_t header[IRIGFIX_COLUMN_HEADER_BYTES];
+
+    if (file_size < IRIGFIX_COLUMN_HEADER_BYTES ||
+        !read_at(store, header, sizeof(header), 0) ||
+        get_le(header + 0, 4) != IRIGFIX_COLUMN_MAGIC ||
+        get_le(header + 4, 4) != IRIGFIX_COLUMN_VERSION) {
+        ColumnStore_Close(store);
+        return NULL;
+    }
+
+    store->column_count = (uint32_t)get_le(header + 8, 4);
+    store->chunk_rows = (uint32_t)get_le(header + 12, 4);
+    store->row_count = get_le(header + 16, 8);
+    uint64_t directory_offset = get_le(header + 24, 8);
+
+    if (store->chunk_rows == 0 || !load_directory(store, directory_offset, file_size)) {
+        ColumnStore_Close(store);
+        return NULL;
+    }
+
+    return store;
+}
+
+void ColumnStore_Close(ColumnStore *store)
+{
+    if (!store) return;
+
+    if (store->columns) {
+        for (uint32_t c = 0; c < store->column_count; c++) {
+            if (store->columns[c].chunks) free(store->columns[c].chunks);
+        }
+        free(store->columns);
+    }
+    if (store->fd >= 0) close(store->fd);
+    free(store);
+}
+
+int ColumnStore_FindColumn(const ColumnStore *store, const char *name)
+{
+    if (!store || !name) return -1;
+
+    for (uint32_t c = 0; c < store->column_count; c++) {
+        if (strcmp(store->columns[c].name, name) == 0) return (int)c;
+    }
+    return -1;
+}
+
+const ColumnChunkInfo* ColumnStore_GetChunk(const ColumnStore *store, int column,
+                                            uint32_t chunk)
+{
+    if (!store || column < 0 || (uint32_t)column >= store->column_count) return NULL;
+    if (chunk >= store->columns[column].chunk_count) return NULL;
+    return &store->columns[column].chunks[chunk];
+}
+
+/* 청크 하나만 읽어 값으로 복원, 반환: 행 수 (실패 시 0) */
+uint32_t ColumnStore_ReadChunk(ColumnStore *store, int column, uint32_t chunk,
+                               double *out)
+{
+    const ColumnChunkInfo *info = ColumnStore_GetChunk(store, column, chunk);
+    if (!info || !out) return 0;
+
+    const ColumnInfo *col = &store->columns[column];
+    uint32_t rows = info->row_count;
+
+    /* 비트 추출 시 8바이트 로드가 끝을 넘지 않도록 여유 */
+    uint8_t *buf = calloc((size_t)info->data_len + 8, 1);
+    if (!buf) return 0;
+    if (!read_at(store, buf, info->data_len, info->offset)) {
+        free(buf);
+        return 0;
+    }
+
+    if (info->encoding == IRIGFIX_COLUMN_ENC_RAW) {
+        if ((uint64_t)rows * col->size > info->data_len) rows = 0;
+        for (uint32_t i = 0; i < rows; i++) {
+            out[i] = raw_to_double(col->type, get_le(buf + (size_t)i * col->size, col->size));
+        }
+    } else if (info->encoding == IRIGFIX_COLUMN_ENC_DELTA && info->data_len >= 8) {
+        int width = info->width;
+        uint64_t needed = 8 + ((uint64_t)width * (rows ? rows - 1 : 0) + 7) / 8;
+        if (needed > info->data_len) rows = 0;
+
+        uint64_t mask = size_mask(col->size);
+        uint64_t m = (width >= 64) ? ~0ULL : (1ULL << width) - 1;
+        uint64_t v = get_le(buf, 8);
+        const uint8_t *bits = buf + 8;
+
+        for (uint32_t i = 0; i < rows; i++) {
+            if (i > 0) {
+                uint64_t b = (uint64_t)(i - 1) * width;
+                uint64_t z;
+                if (width <= 56) {
+                    z = (get_le(bits + (b >> 3), 8) >> (b & 7)) & m;
+                } else {
+                    z = 0;
+                    for (int k = 0; k < width; k++) {
+                        uint64_t bit = b + k;
+                        z |= (uint64_t)((bits[bit >> 3] >> (bit & 7)) & 1) << k;
+                    }
+                }
+                uint64_t d = (z >> 1) ^ (-(z & 1));
+                v = (v + d) & mask;
+            }
+            out[i] = raw_to_double(col->type, v);
+        }
+    } else {
+        rows = 0;
+    }
+
+    free(buf);
+    return rows;
+}
+
+uint64_t ColumnStore_ReadColumn(ColumnStore *store, int column,
+                                double *out, uint64_t max)
+{
+    if (!store || !out || column < 0 || (uint32_t)column >= store->column_count) return 0;
+
+    uint64_t total = 0;
+    const ColumnInfo *col = &store->columns[column];
+
+    for (uint32_t k = 0; k < col->chunk_count; k++) {
+        if (total + col->chunks[k].row_count > max) break;
+        uint32_t n = ColumnStore_ReadChunk(store, column, k, out + total);
+        if (n != col->chunks[k].row_count) break;
+        total += n;
+    }
+    return total;
+}
@@ -0,0 +1,203 @@
+#include "black_box.h"
+#include "flight_log.h"
+#include "emergency_system.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+
+/* ============================================================
+ * 블랙박스 구현
+ *
+ * 생성 시: 파일 범위 할당 → 0으로 채워 기록 → fsync.
+ *   (할당만 된 미기록 범위는 첫 기록 때 익스텐트 상태가 바뀌어
+ *    메타데이터 저널링이 일어나므로 실제 0을 써 둔다.)
+ * 비상 시: 직렬화 (할당 없음) → pwrite 한 번 → fdatasync
+ *          → 트레일러 pwrite → fdatasync.
+ * ============================================================ */
+
+#define BLACK_BOX_ALIGN 4096
+
+static inline uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static bool pwrite_all(int fd, const uint8_t *data, uint64_t len, uint64_t offset)
+{
+    uint64_t done = 0;
+    while (done < len) {
+        ssize_t n = pwrite(fd, data + done, len - done, (off_t)(offset + done));
+        if (n <= 0) return false;
+        done += (uint64_t)n;
+    }
+    return true;
+}
+
+/* 패킷을 스테이징 버퍼에 이어 붙이고 상태 (오프셋/순번/색인) 갱신 */
+static void stage_packet(uint8_t *staging, FlightLogState *state, const FlightLogPacket *pkt)
+{
+    uint8_t *p = staging + state->offset;
+
+    memcpy(p, pkt->head, pkt->head_len);
+    p += pkt->head_len;
+    if (pkt->payload_len > 0) {
+        memcpy(p, pkt->payload, pkt->payload_len);
+        p += pkt->payload_len;
+    }
+    memcpy(p, pkt->tail, pkt->tail_len);
+
+    FlightLog_Commit(state, pkt);
+}
+
+BlackBox* BlackBox_Create(const char *filename, LogBuffer *log, uint32_t window_ms)
+{
+    if (!filename || !log) return NULL;
+
+    BlackBox *bb = malloc(sizeof(BlackBox));
+    if (!bb) return NULL;
+    memset(bb, 0, sizeof(BlackBox));
+
+    bb->fd = -1;
+    bb->log = log;
+    bb->window_ms = window_ms ? window_ms : PT_BLACK_BOX_WINDOW_MS;
+    bb->max_entries = (uint32_t)((uint64_t)bb->window_ms * PT_BLACK_BOX_ENTRY_RATE_HZ / 1000);
+    if (bb->max_entries > log->buffer_capacity) bb->max_entries = log->buffer_capacity;
+    if (bb->max_entries == 0) bb->max_entries = 1;
+
+    /* 최대 크기 산정: SETUP + TELEMETRY × N + INDEX */
+    FlightLogState probe;
+    FlightLogPacket pkt;
+    LogEntry blank;
+    FlightLogState_Init(&probe);
+    memset(&blank, 0, sizeof(blank));
+
+    FlightLog_BuildSetup(&probe, &pkt);
+    uint64_t size = pkt.packet_len;
+    FlightLog_BuildTelemetry(&probe, &pkt, &blank);
+    size += (uint64_t)pkt.packet_len * bb->max_entries;
+
+    bb->index_capacity = bb->max_entries / PT_FLOG_INDEX_STRIDE + 2;
+    size += IRIGFIX_FLOG_HEADER_BYTES + IRIGFIX_FLOG_CRC_BYTES +
+            (uint64_t)bb->index_capacity * IRIGFIX_FLOG_INDEX_ENTRY_BYTES;
+    size += IRIGFIX_FLOG_HEADER_BYTES;      /* 끝 표시 (0 헤더) */
+
+    bb->staging_size = (uint32_t)((size + BLACK_BOX_ALIGN - 1) & ~(uint64_t)(BLACK_BOX_ALIGN - 1));
+    bb->file_size = (uint64_t)bb->staging_size + BLACK_BOX_ALIGN;   /* 마지막 페이지: 트레일러 */
+
+    bb->staging = aligned_alloc(BLACK_BOX_ALIGN, bb->staging_size);
+    bb->index_bytes = malloc((size_t)bb->index_capacity * IRIGFIX_FLOG_INDEX_ENTRY_BYTES);
+    if (!bb->staging || !bb->index_bytes) {
+        BlackBox_Destroy(bb);
+        return NULL;
+    }
+    /* 페이지를 미리 접근해 비상 경로에서 페이지 폴트 방지 */
+    memset(bb->staging, 0, bb->staging_size);
+    memset(bb->index_bytes, 0, (size_t)bb->index_capacity * IRIGFIX_FLOG_INDEX_ENTRY_BYTES);
+
+    bb->fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (bb->fd < 0) {
+        BlackBox_Destroy(bb);
+        return NULL;
+    }
+
+    /* 범위 할당 (지원하지 않는 파일 시스템이면 0 기록만으로 할당) */
+    posix_fallocate(bb->fd, 0, (off_t)bb->file_size);
+
+    bool ok = true;
+    for (uint64_t off = 0; ok && off < bb->file_size; off += bb->staging_size) {
+        uint64_t len = bb->file_size - off;
+        if (len > bb->staging_size) len = bb->staging_size;
+        ok = pwrite_all(bb->fd, bb->staging, len, off);
+    }
+    if (!ok || fsync(bb->fd) != 0) {
+        BlackBox_Destroy(bb);
+        return NULL;
+    }
+
+    return bb;
+}
+
+void BlackBox_Destroy(BlackBox *bb)
+{
+    if (!bb) return;
+
+    if (bb->fd >= 0) close(bb->fd);
+    if (bb->staging) free(bb->staging);
+    if (bb->index_bytes) free(bb->index_bytes);
+    free(bb);
+}
+
+/* 비상 경로: 메모리 할당/파일 크기 변경 없음. report 는 NULL 가능 */
+bool BlackBox_Flush(BlackBox *bb, BlackBoxReport *report)
+{
+    if (!bb) return false;
+
+    uint64_t t0 = now_us();
+    LogBuffer *log = bb->log;
+    BlackBoxReport r;
+    memset(&r, 0, sizeof(r));
+
+    /* 최근 window_ms 구간 (용량을 넘으면 최신 max_entries 개) */
+    uint32_t count = DataStorage_GetEntryCount(log);
+    uint32_t first = 0;
+    if (count > 0) {
+        uint64_t newest = DataStorage_ReadEntryChrono(log, count - 1)->timestamp_us;
+        uint64_t window_us = (uint64_t)bb->window_ms * 1000;
+        first = (newest > window_us) ? DataStorage_LowerBound(log, newest - window_us) : 0;
+    }
+    if (count - first > bb->max_entries) first = count - bb->max_entries;
+
+    FlightLogState state;
+    FlightLogState_Init(&state);
+    state.index_bytes = bb->index_bytes;
+    state.index_capacity = bb->index_capacity;
+
+    FlightLogPacket pkt;
+    FlightLog_BuildSetup(&state, &pkt);
+    stage_packet(bb->staging, &state, &pkt);
+
+    uint64_t last_time = 0;
+    for (uint32_t n = first; n < count; n++) {
+        const LogEntry *entry = DataStorage_ReadEntryChrono(log, n);
+        FlightLog_BuildTelemetry(&state, &pkt, entry);
+        stage_packet(bb->staging, &state, &pkt);
+        last_time = entry->timestamp_us;
+    }
+
+    uint64_t index_offset = state.offset;
+    FlightLog_BuildIndex(&state, &pkt, last_time);
+    stage_packet(bb->staging, &state, &pkt);
+
+    /* 이전 플러시가 더 길었으면 남은 패킷이 이어 읽히지 않도록 0 헤더로 끝 표시 */
+    memset(bb->staging + state.offset, 0, IRIGFIX_FLOG_HEADER_BYTES);
+
+    r.entries = count - first;
+    r.bytes = state.offset;
+
+    uint64_t t1 = now_us();
+    bool ok = pwrite_all(bb->fd, bb->staging, state.offset + IRIGFIX_FLOG_HEADER_BYTES, 0);
+    uint64_t t2 = now_us();
+    ok = ok && fdatasync(bb->fd) == 0;
+
+    /* 본문이 내려간 뒤에 트레일러: 중간에 끊기면 순차 탐색 복구 */
+    uint8_t trailer[IRIGFIX_FLOG_TRAILER_BYTES];
+    FlightLog_BuildTrailer(trailer, index_offset);
+    ok = ok && pwrite_all(bb->fd, trailer, sizeof(trailer), bb->file_size - sizeof(trailer));
+    ok = ok && fdatasync(bb->fd) == 0;
+    uint64_t t3 = now_us();
+
+    r.serialize_us = (uint32_t)(t1 - t0);
+    r.write_us = (uint32_t)(t2 - t1);
+    r.sync_us = (uint32_t)(t3 - t2);
+    r.total_us = (uint32_t)(t3 - t0);
+    r.within_deadline = ok && r.total_us <= (uint32_t)PT_EMERGENCY_SHUTDOWN_TIME_MS * 1000;
+
+    bb->last = r;
+    bb->flush_count++;
+    if (report) *report = r;
+    return ok;
+}
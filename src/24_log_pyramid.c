@@ -0,0 +1,403 @@
+#include "log_pyramid.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* ============================================================
+ * 감축 피라미드 구현
+ *
+ * 엔트리마다 채널 값을 단계 0 누적기에 더하고, 10개가 모이면 레코드를
+ * 내보낸 뒤 그 버킷을 다음 단계 누적기로 합친다. 원본 엔트리를 다시
+ * 읽지 않으므로 엔트리당 비용은 채널 수만큼의 비교/덧셈이다.
+ * 레코드 기록은 LogWriter 기록 스레드가 맡는다.
+ * ============================================================ */
+
+/* ============================================================
+ * 리틀 엔디언 입출력
+ * ============================================================ */
+
+static inline void put_le(uint8_t *p, uint64_t v, int size)
+{
+    for (int i = 0; i < size; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static inline uint64_t get_le(const uint8_t *p, int size)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < size; i++) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+static inline void put_f32(uint8_t *p, float f)
+{
+    uint32_t v;
+    memcpy(&v, &f, 4);
+    put_le(p, v, 4);
+}
+
+static inline float get_f32(const uint8_t *p)
+{
+    uint32_t v = (uint32_t)get_le(p, 4);
+    float f;
+    memcpy(&f, &v, 4);
+    return f;
+}
+
+/* ============================================================
+ * 누적기
+ * ============================================================ */
+
+static inline void accum_reset(PyramidAccum *acc)
+{
+    acc->min = NAN;
+    acc->max = NAN;
+    acc->sum = 0.0;
+    acc->valid = 0;
+}
+
+static inline void accum_add(PyramidAccum *acc, double value)
+{
+    if (isnan(value)) return;
+
+    float v = (float)value;
+    if (acc->valid == 0) {
+        acc->min = v;
+        acc->max = v;
+    } else {
+        if (v < acc->min) acc->min = v;
+        if (v > acc->max) acc->max = v;
+    }
+    acc->sum += value;
+    acc->valid++;
+}
+
+static inline void accum_merge(PyramidAccum *dst, const PyramidAccum *src)
+{
+    if (src->valid == 0) return;
+
+    if (dst->valid == 0) {
+        dst->min = src->min;
+        dst->max = src->max;
+    } else {
+        if (src->min < dst->min) dst->min = src->min;
+        if (src->max > dst->max) dst->max = src->max;
+    }
+    dst->sum += src->sum;
+    dst->valid += src->valid;
+}
+
+static void level_reset(LogPyramid *pyr, int level)
+{
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+        accum_reset(&pyr->accum[level][c]);
+    }
+    pyr->fill[level] = 0;
+    pyr->samples[level] = 0;
+}
+
+/* 단계 level 의 버킷을 레코드로 내보내고 위 단계로 합침 */
+static void level_emit(LogPyramid *pyr, int level)
+{
+    uint8_t *rec = pyr->record;
+
+    rec[0] = (uint8_t)(level + 1);
+    rec[1] = rec[2] = rec[3] = 0;
+    put_le(rec + 4, pyr->samples[level], 4);
+    put_le(rec + 8, pyr->t_first[level], 8);
+    put_le(rec + 16, pyr->t_last[level], 8);
+
+    uint8_t *p = rec + IRIGFIX_PYRAMID_RECORD_HEAD_BYTES;
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++, p += 12) {
+        const PyramidAccum *acc = &pyr->accum[level][c];
+        put_f32(p, acc->min);
+        put_f32(p + 4, acc->max);
+        put_f32(p + 8, acc->valid ? (float)(acc->sum / acc->valid) : NAN);
+    }
+
+    if (LogWriter_Append(pyr->writer, rec, IRIGFIX_PYRAMID_RECORD_BYTES)) {
+        pyr->records[level]++;
+    } else {
+        pyr->records_dropped++;
+    }
+
+    int up = level + 1;
+    if (up < IRIGFIX_PYRAMID_LEVELS) {
+        for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+            accum_merge(&pyr->accum[up][c], &pyr->accum[level][c]);
+        }
+        if (pyr->samples[up] == 0) pyr->t_first[up] = pyr->t_first[level];
+        pyr->t_last[up] = pyr->t_last[level];
+        pyr->samples[up] += pyr->samples[level];
+        pyr->fill[up]++;
+    }
+    level_reset(pyr, level);
+
+    if (up < IRIGFIX_PYRAMID_LEVELS && pyr->fill[up] == IRIGFIX_PYRAMID_FACTOR) {
+        level_emit(pyr, up);
+    }
+}
+
+/* ============================================================
+ * 기록 측
+ * ============================================================ */
+
+LogPyramid* LogPyramid_Create(const char *filename)
+{
+    if (!filename) return NULL;
+
+    LogPyramid *pyr = malloc(sizeof(LogPyramid));
+    if (!pyr) return NULL;
+    memset(pyr, 0, sizeof(LogPyramid));
+
+    /* 버킷 단위로만 기록하므로 주기 동기화는 로그 기록기 기본값을 따름 */
+    pyr->writer = LogWriter_Create(filename, PT_LOG_WRITER_SYNC_INTERVAL_MS);
+    if (!pyr->writer) {
+        free(pyr);
+        return NULL;
+    }
+
+    uint8_t header[IRIGFIX_PYRAMID_HEADER_BYTES];
+    put_le(header, IRIGFIX_PYRAMID_MAGIC, 4);
+    put_le(header + 4, IRIGFIX_PYRAMID_VERSION, 2);
+    header[6] = IRIGFIX_PYRAMID_LEVELS;
+    header[7] = IRIGFIX_PYRAMID_FACTOR;
+    put_le(header + 8, TELEMETRY_NUM_CHANNELS, 2);
+    put_le(header + 10, 0, 2);
+    put_le(header + 12, IRIGFIX_PYRAMID_RECORD_BYTES, 4);
+
+    if (!LogWriter_Append(pyr->writer, header, sizeof(header))) {
+        LogWriter_Destroy(pyr->writer);
+        free(pyr);
+        return NULL;
+    }
+
+    for (int level = 0; level < IRIGFIX_PYRAMID_LEVELS; level++) {
+        level_reset(pyr, level);
+    }
+
+    return pyr;
+}
+
+/* 남은 부분 버킷을 내보내고 파일을 닫음 */
+void LogPyramid_Destroy(LogPyramid *pyr)
+{
+    if (!pyr) return;
+
+    LogPyramid_Finish(pyr);
+    LogWriter_Destroy(pyr->writer);
+    free(pyr);
+}
+
+void LogPyramid_Add(LogPyramid *pyr, uint64_t timestamp_us,
+                    const MissileTelemetryFrame *frame)
+{
+    if (!pyr || !frame) return;
+
+    PyramidAccum *acc = pyr->accum[0];
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+        accum_add(&acc[c], TelemetryChannels_GetValue(frame, c));
+    }
+
+    if (pyr->samples[0] == 0) pyr->t_first[0] = timestamp_us;
+    pyr->t_last[0] = timestamp_us;
+    pyr->samples[0]++;
+    pyr->fill[0]++;
+    pyr->entries++;
+
+    if (pyr->fill[0] == IRIGFIX_PYRAMID_FACTOR) {
+        level_emit(pyr, 0);
+    }
+}
+
+/* 부분 버킷을 아래 단계부터 내보냄 (이후 Add 는 새 버킷부터 시작) */
+void LogPyramid_Finish(LogPyramid *pyr)
+{
+    if (!pyr) return;
+
+    for (int level = 0; level < IRIGFIX_PYRAMID_LEVELS; level++) {
+        if (pyr->samples[level] > 0) level_emit(pyr, level);
+    }
+    LogWriter_Flush(pyr->writer);
+}
+
+/* ============================================================
+ * 읽기 측
+ * ============================================================ */
+
+static inline const uint8_t* record_at(const LogPyramidReader *reader, uint32_t rec)
+{
+    return reader->base + IRIGFIX_PYRAMID_HEADER_BYTES +
+           (uint64_t)rec * IRIGFIX_PYRAMID_RECORD_BYTES;
+}
+
+LogPyramidReader* LogPyramidReader_Open(const char *filename)
+{
+    if (!filename) return NULL;
+
+    LogPyramidReader *reader = malloc(sizeof(LogPyramidReader));
+    if (!reader) return NULL;
+    memset(reader, 0, sizeof(LogPyramidReader));
+    reader->base = MAP_FAILED;
+
+    reader->fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (reader->fd < 0 || fstat(reader->fd, &st) != 0 ||
+        (uint64_t)st.st_size < IRIGFIX_PYRAMID_HEADER_BYTES) {
+        LogPyramidReader_Close(reader);
+        return NULL;
+    }
+    reader->size = (uint64_t)st.st_size;
+
+    reader->base = mmap(NULL, reader->size, PROT_READ, MAP_PRIVATE, reader->fd, 0);
+    if (reader->base == MAP_FAILED) {
+        LogPyramidReader_Close(reader);
+        return NULL;
+    }
+
+    const uint8_t *h = reader->base;
+    if (get_le(h, 4) != IRIGFIX_PYRAMID_MAGIC ||
+        get_le(h + 4, 2) != IRIGFIX_PYRAMID_VERSION ||
+        h[6] != IRIGFIX_PYRAMID_LEVELS || h[7] != IRIGFIX_PYRAMID_FACTOR ||
+        get_le(h + 8, 2) != TELEMETRY_NUM_CHANNELS ||
+        get_le(h + 12, 4) != IRIGFIX_PYRAMID_RECORD_BYTES) {
+        LogPyramidReader_Close(reader);
+        return NULL;
+    }
+
+    /* 단계별 레코드 번호 표 (잘린 마지막 레코드 / 0 채움은 제외) */
+    uint32_t total = (uint32_t)((reader->size - IRIGFIX_PYRAMID_HEADER_BYTES) /
+                                IRIGFIX_PYRAMID_RECORD_BYTES);
+    for (uint32_t r = 0; r < total; r++) {
+        uint8_t level = record_at(reader, r)[0];
+        if (level >= 1 && level <= IRIGFIX_PYRAMID_LEVELS) reader->count[level - 1]++;
+    }
+    for (int level = 0; level < IRIGFIX_PYRAMID_LEVELS; level++) {
+        reader->records[level] = malloc((reader->count[level] + 1) * sizeof(uint32_t));
+        if (!reader->records[level]) {
+            LogPyramidReader_Close(reader);
+            return NULL;
+        }
+        reader->count[level] = 0;
+    }
+    for (uint32_t r = 0; r < total; r++) {
+        uint8_t level = record_at(reader, r)[0];
+        if (level >= 1 && level <= IRIGFIX_PYRAMID_LEVELS) {
+            reader->records[level - 1][reader->count[level - 1]++] = r;
+        }
+    }
+
+    return reader;
+}
+
+void LogPyramidReader_Close(LogPyramidReader *reader)
+{
+    if (!reader) return;
+
+    for (int level = 0; level < IRIGFIX_PYRAMID_LEVELS; level++) {
+        if (reader->records[level]) free(reader->records[level]);
+    }
+    if (reader->base != MAP_FAILED) munmap((void *)reader->base, reader->size);
+    if (reader->fd >= 0) close(reader->fd);
+    free(reader);
+}
+
+/* level 에서 t_last >= start_us 인 첫 버킷 */
+static uint32_t level_lower(const LogPyramidReader *reader, int level, uint64_t start_us)
+{
+    uint32_t lo = 0, hi = reader->count[level];
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (get_le(record_at(reader, reader->records[level][mid]) + 16, 8) < start_us) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* level 에서 t_first <= end_us 인 마지막 버킷 다음 */
+static uint32_t level_upper(const LogPyramidReader *reader, int level, uint64_t end_us)
+{
+    uint32_t lo = 0, hi = reader->count[level];
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (get_le(record_at(reader, reader->records[level][mid]) + 8, 8) <= end_us) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/*
+ * [start_us, end_us] 와 겹치는 버킷을 최대 max_points 개로 반환.
+ * max_points 안에 들어가는 가장 세밀한 단계를 고르고, 가장 거친 단계도
+ * 넘치면 인접 버킷을 묶어 줄인다. level 에는 사용한 단계 (1 = 10×) 를
+ * 돌려준다. 단계 1 결과 × 10 이 max_points 이하이면 원본 로그를 직접
+ * 읽는 편이 낫다.
+ */
+uint32_t LogPyramidReader_Query(const LogPyramidReader *reader, int channel,
+                                uint64_t start_us, uint64_t end_us,
+                                uint32_t max_points, PyramidPoint *out,
+                                int *level)
+{
+    if (!reader || !out || max_points == 0 || end_us < start_us) return 0;
+    if (channel < 0 || channel >= TELEMETRY_NUM_CHANNELS) return 0;
+
+    int use = IRIGFIX_PYRAMID_LEVELS - 1;
+    uint32_t first = 0, last = 0;
+    for (int l = 0; l < IRIGFIX_PYRAMID_LEVELS; l++) {
+        first = level_lower(reader, l, start_us);
+        last = level_upper(reader, l, end_us);
+        if (last < first) last = first;
+        if (last - first <= max_points) {
+            use = l;
+            break;
+        }
+    }
+    if (level) *level = use + 1;
+
+    uint32_t n = last - first;
+    uint32_t group = (n + max_points - 1) / max_points;
+    if (group == 0) group = 1;
+
+    uint32_t count = 0;
+    uint32_t ch_offset = IRIGFIX_PYRAMID_RECORD_HEAD_BYTES + (uint32_t)channel * 12;
+
+    for (uint32_t i = first; i < last; i += group) {
+        uint32_t end = (i + group < last) ? i + group : last;
+        PyramidPoint *pt = &out[count++];
+        double sum = 0.0;
+        uint32_t weight = 0;
+
+        pt->min = NAN;
+        pt->max = NAN;
+        pt->samples = 0;
+
+        for (uint32_t k = i; k < end; k++) {
+            const uint8_t *rec = record_at(reader, reader->records[use][k]);
+            const uint8_t *v = rec + ch_offset;
+            uint32_t samples = (uint32_t)get_le(rec + 4, 4);
+            float mn = get_f32(v), mx = get_f32(v + 4), mean = get_f32(v + 8);
+
+            if (k == i) pt->t_first = get_le(rec + 8, 8);
+            pt->t_last = get_le(rec + 16, 8);
+            pt->samples += samples;
+
+            if (isnan(mean)) continue;
+            if (isnan(pt->min) || mn < pt->min) pt->min = mn;
+            if (isnan(pt->max) || mx > pt->max) pt->max = mx;
+            sum += (double)mean * samples;
+            weight += samples;
+        }
+        pt->mean = weight ? (float)(sum / weight) : NAN;
+    }
+
+    return count;
+}
@@ -0,0 +1,676 @@
+#include "log_query.h"
+#include "flight_log.h"
+#include "flight_log_map.h"
+#include "column_store.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <pthread.h>
+
+/* ============================================================
+ * 로그 질의 구현
+ *
+ * 식은 고정 크기 노드 배열로 파싱하고 행마다 재귀 평가한다.
+ * 실행: 스레드들이 청크 번호를 하나씩 가져가 평가 결과를 청크별 버퍼에
+ * 쓰고, 호출 스레드가 청크 순서대로 출력한다. 출력이 밀리면 앞선
+ * 청크를 PT_LOG_QUERY_LOOKAHEAD × 스레드 수 이상 가져가지 않는다.
+ * ============================================================ */
+
+/* ============================================================
+ * 파서
+ * ============================================================ */
+
+typedef struct {
+    const char *text;
+    const char *p;
+    LogQueryExpr *expr;
+    char *err;
+    size_t err_len;
+    bool failed;
+} QueryParser;
+
+static void parse_fail(QueryParser *ps, const char *msg)
+{
+    if (ps->failed) return;
+    ps->failed = true;
+    if (ps->err && ps->err_len > 0) {
+        snprintf(ps->err, ps->err_len, "위치 %d: %s", (int)(ps->p - ps->text), msg);
+    }
+}
+
+static void skip_space(QueryParser *ps)
+{
+    while (isspace((unsigned char)*ps->p)) ps->p++;
+}
+
+static bool accept(QueryParser *ps, const char *tok)
+{
+    skip_space(ps);
+    size_t n = strlen(tok);
+    if (strncmp(ps->p, tok, n) != 0) return false;
+    ps->p += n;
+    return true;
+}
+
+static int new_node(QueryParser *ps, LogQueryNodeKind kind)
+{
+    LogQueryExpr *expr = ps->expr;
+    if (expr->node_count >= PT_LOG_QUERY_MAX_NODES) {
+        parse_fail(ps, "식이 너무 김");
+        return -1;
+    }
+    int n = expr->node_count++;
+    memset(&expr->nodes[n], 0, sizeof(LogQueryNode));
+    expr->nodes[n].kind = kind;
+    expr->nodes[n].left = expr->nodes[n].right = -1;
+    return n;
+}
+
+/* 채널 이름 (예: temperature_c[3]) 또는 숫자 */
+static bool parse_operand(QueryParser *ps, LogQueryOperand *op)
+{
+    skip_space(ps);
+    const char *s = ps->p;
+
+    if (isalpha((unsigned char)*s) || *s == '_') {
+        const char *e = s;
+        while (isalnum((unsigned char)*e) || *e == '_') e++;
+        if (*e == '[') {
+            e++;
+            while (isdigit((unsigned char)*e)) e++;
+            if (*e != ']') {
+                parse_fail(ps, "']' 없음");
+                return false;
+            }
+            e++;
+        }
+
+        char name[64];
+        size_t len = (size_t)(e - s);
+        if (len >= sizeof(name)) {
+            parse_fail(ps, "채널 이름이 너무 김");
+            return false;
+        }
+        memcpy(name, s, len);
+        name[len] = '\0';
+
+        op->channel = TelemetryChannels_Find(name);
+        if (op->channel < 0) {
+            parse_fail(ps, "알 수 없는 채널");
+            return false;
+        }
+        op->value = 0.0;
+        ps->expr->uses[op->channel] = true;
+        ps->p = e;
+        return true;
+    }
+
+    char *end;
+    double v = strtod(s, &end);
+    if (end == s) {
+        parse_fail(ps, "채널 또는 숫자가 와야 함");
+        return false;
+    }
+    op->channel = -1;
+    op->value = v;
+    ps->p = end;
+    return true;
+}
+
+static int parse_or(QueryParser *ps);
+
+/* 비교: 피연산자 연산자 피연산자 */
+static int parse_compare(QueryParser *ps)
+{
+    static const struct { const char *tok; LogQueryOp op; } ops[] = {
+        { "==", LOG_QUERY_OP_EQ }, { "!=", LOG_QUERY_OP_NE },
+        { "<=", LOG_QUERY_OP_LE }, { ">=", LOG_QUERY_OP_GE },
+        { "<",  LOG_QUERY_OP_LT }, { ">",  LOG_QUERY_OP_GT },
+    };
+
+    int n = new_node(ps, LOG_QUERY_NODE_CMP);
+    if (n < 0) return -1;
+    LogQueryNode *node = &ps->expr->nodes[n];
+
+    if (!parse_operand(ps, &node->a)) return -1;
+
+    size_t i;
+    for (i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        if (accept(ps, ops[i].tok)) break;
+    }
+    if (i == sizeof(ops) / sizeof(ops[0])) {
+        parse_fail(ps, "비교 연산자가 와야 함");
+        return -1;
+    }
+    node->op = ops[i].op;
+
+    if (!parse_operand(ps, &node->b)) return -1;
+    return n;
+}
+
+static int parse_unary(QueryParser *ps)
+{
+    skip_space(ps);
+
+    if (ps->p[0] == '!' && ps->p[1] != '=') {
+        ps->p++;
+        int inner = parse_unary(ps);
+        if (inner < 0) return -1;
+        int n = new_node(ps, LOG_QUERY_NODE_NOT);
+        if (n < 0) return -1;
+        ps->expr->nodes[n].left = inner;
+        return n;
+    }
+
+    if (accept(ps, "(")) {
+        int inner = parse_or(ps);
+        if (inner < 0) return -1;
+        if (!accept(ps, ")")) {
+            parse_fail(ps, "')' 없음");
+            return -1;
+        }
+        return inner;
+    }
+
+    return parse_compare(ps);
+}
+
+static int parse_binary(QueryParser *ps, const char *tok, LogQueryNodeKind kind,
+                        int (*operand)(QueryParser *))
+{
+    int left = operand(ps);
+    while (left >= 0 && accept(ps, tok)) {
+        int right = operand(ps);
+        if (right < 0) return -1;
+        int n = new_node(ps, kind);
+        if (n < 0) return -1;
+        ps->expr->nodes[n].left = left;
+        ps->expr->nodes[n].right = right;
+        left = n;
+    }
+    return left;
+}
+
+static int parse_and(QueryParser *ps)
+{
+    return parse_binary(ps, "&&", LOG_QUERY_NODE_AND, parse_unary);
+}
+
+static int parse_or(QueryParser *ps)
+{
+    return parse_binary(ps, "||", LOG_QUERY_NODE_OR, parse_and);
+}
+
+bool LogQuery_Parse(const char *text, LogQueryExpr *expr, char *err, size_t err_len)
+{
+    if (!text || !expr) return false;
+
+    memset(expr, 0, sizeof(LogQueryExpr));
+    QueryParser ps = { text, text, expr, err, err_len, false };
+
+    expr->root = parse_or(&ps);
+    skip_space(&ps);
+    if (expr->root >= 0 && *ps.p != '\0') {
+        parse_fail(&ps, "식 끝에 남은 문자");
+    }
+    return !ps.failed && expr->root >= 0;
+}
+
+/* ============================================================
+ * 평가 / 청크 건너뛰기 판정
+ * ============================================================ */
+
+static inline double operand_value(const LogQueryOperand *op, const double *values)
+{
+    return (op->channel >= 0) ? values[op->channel] : op->value;
+}
+
+static bool eval_node(const LogQueryExpr *expr, int n, const double *values)
+{
+    const LogQueryNode *node = &expr->nodes[n];
+
+    switch (node->kind) {
+        case LOG_QUERY_NODE_AND:
+            return eval_node(expr, node->left, values) && eval_node(expr, node->right, values);
+        case LOG_QUERY_NODE_OR:
+            return eval_node(expr, node->left, values) || eval_node(expr, node->right, values);
+        case LOG_QUERY_NODE_NOT:
+            return !eval_node(expr, node->left, values);
+        case LOG_QUERY_NODE_CMP:
+            break;
+    }
+
+    double a = operand_value(&node->a, values);
+    double b = operand_value(&node->b, values);
+
+    switch (node->op) {
+        case LOG_QUERY_OP_EQ: return a == b;
+        case LOG_QUERY_OP_NE: return a != b;
+        case LOG_QUERY_OP_LT: return a < b;
+        case LOG_QUERY_OP_LE: return a <= b;
+        case LOG_QUERY_OP_GT: return a > b;
+        case LOG_QUERY_OP_GE: return a >= b;
+    }
+    return false;
+}
+
+bool LogQuery_Eval(const LogQueryExpr *expr, const double *values)
+{
+    if (!expr || !values || expr->root < 0) return false;
+    return eval_node(expr, expr->root, values);
+}
+
+/* 피연산자 범위. 통계 없는 채널이면 false (판정 불가) */
+static bool operand_range(const LogQueryOperand *op, const double *min, const double *max,
+                          const bool *has_stats, double *lo, double *hi)
+{
+    if (op->channel < 0) {
+        *lo = *hi = op->value;
+        return true;
+    }
+    if (!has_stats[op->channel]) return false;
+    *lo = min[op->channel];
+    *hi = max[op->channel];
+    return true;
+}
+
+/*
+ * 보수적 판정: false 는 "어떤 행도 참이 될 수 없음" 일 때만.
+ * min/max 는 NaN 제외 값이므로 전부 NaN 이면 비교가 모두 거짓이 되어
+ * 올바르게 건너뛴다 (!= 는 NaN 에서 참이므로 항상 true).
+ * NOT 아래는 범위로 부정할 수 없으므로 항상 true.
+ */
+static bool may_match_node(const LogQueryExpr *expr, int n, const double *min,
+                           const double *max, const bool *has_stats)
+{
+    const LogQueryNode *node = &expr->nodes[n];
+
+    switch (node->kind) {
+        case LOG_QUERY_NODE_AND:
+            return may_match_node(expr, node->left, min, max, has_stats) &&
+                   may_match_node(expr, node->right, min, max, has_stats);
+        case LOG_QUERY_NODE_OR:
+            return may_match_node(expr, node->left, min, max, has_stats) ||
+                   may_match_node(expr, node->right, min, max, has_stats);
+        case LOG_QUERY_NODE_NOT:
+            return true;
+        case LOG_QUERY_NODE_CMP:
+            break;
+    }
+
+    double alo, ahi, blo, bhi;
+    if (!operand_range(&node->a, min, max, has_stats, &alo, &ahi) ||
+        !operand_range(&node->b, min, max, has_stats, &blo, &bhi)) {
+        return true;
+    }
+
+    switch (node->op) {
+        case LOG_QUERY_OP_EQ: return alo <= bhi && blo <= ahi;
+        case LOG_QUERY_OP_NE: return true;
+        case LOG_QUERY_OP_LT: return alo < bhi;
+        case LOG_QUERY_OP_LE: return alo <= bhi;
+        case LOG_QUERY_OP_GT: return ahi > blo;
+        case LOG_QUERY_OP_GE: return ahi >= blo;
+    }
+    return true;
+}
+
+bool LogQuery_MayMatch(const LogQueryExpr *expr, const double *min, const double *max,
+                       const bool *has_stats)
+{
+    if (!expr || !min || !max || !has_stats || expr->root < 0) return true;
+    return may_match_node(expr, expr->root, min, max, has_stats);
+}
+
+/* ============================================================
+ * 병렬 실행
+ * ============================================================ */
+
+typedef struct {
+    char *data;
+    size_t len;
+    size_t cap;
+    uint64_t rows_scanned;
+    uint64_t rows_matched;
+    bool skipped;
+    bool done;
+} QueryChunk;
+
+typedef struct {
+    const LogQueryExpr *expr;
+    LogQueryFormat format;
+    int out_columns[TELEMETRY_NUM_CHANNELS];
+    int out_count;
+    bool need[TELEMETRY_NUM_CHANNELS];  /* 식 + 출력 채널 */
+
+    /* 입력 (둘 중 하나) */
+    FlightLogMap *map;
+    ColumnStore *store;
+    int store_column[TELEMETRY_NUM_CHANNELS];
+
+    uint32_t chunk_count;
+    QueryChunk *chunks;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t next_chunk;
+    uint32_t written;
+    uint32_t window;
+} QueryContext;
+
+static bool chunk_reserve(QueryChunk *chunk, size_t extra)
+{
+    if (chunk->len + extra <= chunk->cap) return true;
+
+    size_t cap = chunk->cap ? chunk->cap : 4096;
+    while (cap < chunk->len + extra) cap *= 2;
+    char *grown = realloc(chunk->data, cap);
+    if (!grown) return false;
+    chunk->data = grown;
+    chunk->cap = cap;
+    return true;
+}
+
+static void emit_row(const QueryContext *ctx, QueryChunk *chunk, const double *values)
+{
+    if (ctx->format == LOG_QUERY_FORMAT_BINARY) {
+        if (!chunk_reserve(chunk, (size_t)ctx->out_count * 8)) return;
+        uint8_t *p = (uint8_t *)chunk->data + chunk->len;
+        for (int i = 0; i < ctx->out_count; i++, p += 8) {
+            uint64_t bits;
+            double v = values[ctx->out_columns[i]];
+            memcpy(&bits, &v, 8);
+            for (int k = 0; k < 8; k++) p[k] = (uint8_t)(bits >> (8 * k));
+        }
+        chunk->len += (size_t)ctx->out_count * 8;
+        return;
+    }
+
+    /* 채널당 최대 25자 + 구분자 */
+    if (!chunk_reserve(chunk, (size_t)ctx->out_count * 26 + 2)) return;
+    char *p = chunk->data + chunk->len;
+    for (int i = 0; i < ctx->out_count; i++) {
+        int c = ctx->out_columns[i];
+        double v = values[c];
+        if (i > 0) *p++ = ',';
+        switch (TelemetryChannels[c].type) {
+            case CHANNEL_TYPE_F32: p += sprintf(p, "%.9g", v); break;
+            case CHANNEL_TYPE_F64: p += sprintf(p, "%.17g", v); break;
+            default:               p += sprintf(p, "%.0f", v); break;
+        }
+    }
+    *p++ = '\n';
+    chunk->len = (size_t)(p - chunk->data);
+}
+
+/* 비행 로그: 색인 PT_LOG_QUERY_CHUNK_INDEXES 개 구간의 텔레메트리 패킷 */
+static void run_log_chunk(const QueryContext *ctx, uint32_t k, QueryChunk *chunk)
+{
+    const FlightLogMap *map = ctx->map;
+    uint32_t first = k * PT_LOG_QUERY_CHUNK_INDEXES;
+    uint32_t next = first + PT_LOG_QUERY_CHUNK_INDEXES;
+    uint64_t pos = map->index[first].offset;
+    uint64_t end = (next < map->index_count) ? map->index[next].offset : map->data_end;
+
+    double values[TELEMETRY_NUM_CHANNELS];
+    FlightLogPacketHeader hdr;
+    LogEntry entry;
+
+    while (pos < end && FlightLog_ParseHeader(map->base + pos, map->data_end - pos, &hdr) &&
+           pos + hdr.packet_len <= map->data_end) {
+        const uint8_t *p = map->base + pos;
+        pos += hdr.packet_len;
+
+        /* 카메라 페이로드는 헤더만 보고 건너뜀 (CRC 는 텔레메트리만 확인) */
+        if (hdr.channel_id != IRIGFIX_FLOG_CHANNEL_TELEMETRY) continue;
+        if (!FlightLog_VerifyPacket(p, hdr.packet_len, &hdr) ||
+            !FlightLog_DecodeTelemetry(&hdr, p + IRIGFIX_FLOG_HEADER_BYTES, &entry)) {
+            continue;
+        }
+
+        for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+            if (ctx->need[c]) values[c] = TelemetryChannels_GetValue(&entry.telemetry, c);
+        }
+        chunk->rows_scanned++;
+        if (LogQuery_Eval(ctx->expr, values)) {
+            chunk->rows_matched++;
+            emit_row(ctx, chunk, values);
+        }
+    }
+}
+
+/* 열 저장: min/max 로 건너뛰고, 필요한 열의 청크만 읽음 */
+static void run_column_chunk(const QueryContext *ctx, uint32_t k, QueryChunk *chunk,
+                             double **columns)
+{
+    double min[TELEMETRY_NUM_CHANNELS], max[TELEMETRY_NUM_CHANNELS];
+    bool has_stats[TELEMETRY_NUM_CHANNELS];
+    uint32_t rows = 0;
+
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+        has_stats[c] = false;
+        if (!ctx->need[c]) continue;
+        const ColumnChunkInfo *info = ColumnStore_GetChunk(ctx->store, ctx->store_column[c], k);
+        if (!info) return;
+        min[c] = info->min;
+        max[c] = info->max;
+        has_stats[c] = true;
+        rows = info->row_count;
+    }
+
+    if (!LogQuery_MayMatch(ctx->expr, min, max, has_stats)) {
+        chunk->skipped = true;
+        return;
+    }
+
+    /* 식 채널을 먼저 읽고, 일치 행이 있을 때만 출력 전용 채널을 읽음 */
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+        if (!ctx->expr->uses[c]) continue;
+        if (ColumnStore_ReadChunk(ctx->store, ctx->store_column[c], k, columns[c]) != rows) return;
+    }
+
+    double values[TELEMETRY_NUM_CHANNELS];
+    bool output_loaded = false;
+
+    for (uint32_t r = 0; r < rows; r++) {
+        for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+            if (ctx->expr->uses[c]) values[c] = columns[c][r];
+        }
+        chunk->rows_scanned++;
+        if (!LogQuery_Eval(ctx->expr, values)) continue;
+
+        if (!output_loaded) {
+            for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+                if (!ctx->need[c] || ctx->expr->uses[c]) continue;
+                if (ColumnStore_ReadChunk(ctx->store, ctx->store_column[c], k, columns[c]) != rows) {
+                    return;
+                }
+            }
+            output_loaded = true;
+        }
+        for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+            if (ctx->need[c]) values[c] = columns[c][r];
+        }
+        chunk->rows_matched++;
+        emit_row(ctx, chunk, values);
+    }
+}
+
+static void* query_worker(void *arg)
+{
+    QueryContext *ctx = (QueryContext *)arg;
+    double *columns[TELEMETRY_NUM_CHANNELS] = { NULL };
+    bool ok = true;
+
+    if (ctx->store) {
+        for (int c = 0; c < TELEMETRY_NUM_CHANNELS && ok; c++) {
+            if (!ctx->need[c]) continue;
+            columns[c] = malloc((size_t)ctx->store->chunk_rows * sizeof(double));
+            ok = columns[c] != NULL;
+        }
+    }
+
+    for (;;) {
+        pthread_mutex_lock(&ctx->lock);
+        while (ctx->next_chunk < ctx->chunk_count &&
+               ctx->next_chunk >= ctx->written + ctx->window) {
+            pthread_cond_wait(&ctx->cond, &ctx->lock);
+        }
+        uint32_t k = ctx->next_chunk;
+        if (k < ctx->chunk_count) ctx->next_chunk++;
+        pthread_mutex_unlock(&ctx->lock);
+
+        if (k >= ctx->chunk_count) break;
+
+        QueryChunk *chunk = &ctx->chunks[k];
+        if (ok) {
+            if (ctx->store) {
+                run_column_chunk(ctx, k, chunk, columns);
+            } else {
+                run_log_chunk(ctx, k, chunk);
+            }
+        }
+
+        pthread_mutex_lock(&ctx->lock);
+        chunk->done = true;
+        pthread_cond_broadcast(&ctx->cond);
+        pthread_mutex_unlock(&ctx->lock);
+    }
+
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+        if (columns[c]) free(columns[c]);
+    }
+    return NULL;
+}
+
+static bool open_source(QueryContext *ctx, const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    if (!file) return false;
+    uint8_t magic[4] = { 0 };
+    size_t got = fread(magic, 1, sizeof(magic), file);
+    fclose(file);
+    if (got != sizeof(magic)) return false;
+
+    uint32_t m = (uint32_t)magic[0] | ((uint32_t)magic[1] << 8) |
+                 ((uint32_t)magic[2] << 16) | ((uint32_t)magic[3] << 24);
+
+    if (m == IRIGFIX_COLUMN_MAGIC) {
+        ctx->store = ColumnStore_Open(filename);
+        if (!ctx->store) return false;
+        for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) {
+            ctx->store_column[c] = ColumnStore_FindColumn(ctx->store, TelemetryChannels[c].name);
+            if (ctx->need[c] && ctx->store_column[c] < 0) return false;
+        }
+        ctx->chunk_count = (ctx->store->row_count + ctx->store->chunk_rows - 1) /
+                           ctx->store->chunk_rows;
+        return true;
+    }
+
+    ctx->map = FlightLogMap_Open(filename);
+    if (!ctx->map) return false;
+    ctx->chunk_count = (ctx->map->index_count + PT_LOG_QUERY_CHUNK_INDEXES - 1) /
+                       PT_LOG_QUERY_CHUNK_INDEXES;
+    return true;
+}
+
+static void close_source(QueryContext *ctx)
+{
+    if (ctx->store) ColumnStore_Close(ctx->store);
+    if (ctx->map) FlightLogMap_Close(ctx->map);
+}
+
+bool LogQuery_Run(const char *filename, const LogQueryExpr *expr,
+                  const LogQueryOptions *options, FILE *out, LogQueryStats *stats)
+{
+    if (!filename || !expr || !out || expr->root < 0) return false;
+
+    QueryContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.expr = expr;
+    ctx.format = options ? options->format : LOG_QUERY_FORMAT_CSV;
+
+    if (options && options->columns && options->column_count > 0) {
+        for (int i = 0; i < options->column_count && i < TELEMETRY_NUM_CHANNELS; i++) {
+            int c = options->columns[i];
+            if (c < 0 || c >= TELEMETRY_NUM_CHANNELS) return false;
+            ctx.out_columns[ctx.out_count++] = c;
+        }
+    } else {
+        for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) ctx.out_columns[ctx.out_count++] = c;
+    }
+    for (int c = 0; c < TELEMETRY_NUM_CHANNELS; c++) ctx.need[c] = expr->uses[c];
+    for (int i = 0; i < ctx.out_count; i++) ctx.need[ctx.out_columns[i]] = true;
+
+    if (!open_source(&ctx, filename)) {
+        close_source(&ctx);
+        return false;
+    }
+
+    uint32_t threads = (options && options->threads) ? options->threads : PT_LOG_QUERY_THREADS;
+    if (threads > ctx.chunk_count) threads = ctx.chunk_count ? ctx.chunk_count : 1;
+    ctx.window = threads * PT_LOG_QUERY_LOOKAHEAD;
+
+    ctx.chunks = calloc(ctx.chunk_count ? ctx.chunk_count : 1, sizeof(QueryChunk));
+    pthread_t *tids = malloc(threads * sizeof(pthread_t));
+    if (!ctx.chunks || !tids) {
+        if (ctx.chunks) free(ctx.chunks);
+        if (tids) free(tids);
+        close_source(&ctx);
+        return false;
+    }
+    pthread_mutex_init(&ctx.lock, NULL);
+    pthread_cond_init(&ctx.cond, NULL);
+
+    if (ctx.format == LOG_QUERY_FORMAT_CSV) {
+        for (int i = 0; i < ctx.out_count; i++) {
+            fprintf(out, "%s%s", i ? "," : "", TelemetryChannels[ctx.out_columns[i]].name);
+        }
+        fputc('\n', out);
+    }
+
+    uint32_t started = 0;
+    for (uint32_t t = 0; t < threads; t++) {
+        if (pthread_create(&tids[t], NULL, query_worker, &ctx) == 0) started++;
+    }
+    if (started == 0) {
+        /* 스레드 생성 실패: 호출 스레드가 전부 처리 (출력 대기 제한 없음) */
+        ctx.window = ctx.chunk_count;
+        query_worker(&ctx);
+    }
+
+    /* 청크 순서대로 출력 */
+    LogQueryStats st = { ctx.chunk_count, 0, 0, 0 };
+    bool ok = true;
+    for (uint32_t k = 0; k < ctx.chunk_count; k++) {
+        QueryChunk *chunk = &ctx.chunks[k];
+
+        pthread_mutex_lock(&ctx.lock);
+        while (!chunk->done) pthread_cond_wait(&ctx.cond, &ctx.lock);
+        pthread_mutex_unlock(&ctx.lock);
+
+        if (chunk->len > 0 && fwrite(chunk->data, 1, chunk->len, out) != chunk->len) ok = false;
+        if (chunk->skipped) st.chunks_skipped++;
+        st.rows_scanned += chunk->rows_scanned;
+        st.rows_matched += chunk->rows_matched;
+        free(chunk->data);
+        chunk->data = NULL;
+
+        pthread_mutex_lock(&ctx.lock);
+        ctx.written++;
+        pthread_cond_broadcast(&ctx.cond);
+        pthread_mutex_unlock(&ctx.lock);
+    }
+
+    for (uint32_t t = 0; t < started; t++) pthread_join(tids[t], NULL);
+
+    pthread_cond_destroy(&ctx.cond);
+    pthread_mutex_destroy(&ctx.lock);
+    free(tids);
+    free(ctx.chunks);
+    close_source(&ctx);
+
+    if (stats) *stats = st;
+    return ok;
+}
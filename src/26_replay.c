@@ -0,0 +1,315 @@
+#include "replay.h"
+#include "flight_log.h"
+#include "data_storage.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+/* ============================================================
+ * 기록 재생 송신 체인 구현
+ *
+ * 블록 하나 = 패커가 채운 K 비트 → 코드워드 N 비트 → 랜덤화 → 변조.
+ * 버퍼는 생성 시 한 번만 할당하고 블록마다 재사용한다. 단계별 시간을
+ * 따로 모아 어느 단계가 처리율을 제한하는지 보여 준다.
+ * ============================================================ */
+
+#define FNV64_OFFSET 0xCBF29CE484222325ULL
+#define FNV64_PRIME 0x100000001B3ULL
+
+static inline uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static void sleep_until_us(uint64_t target_us)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(target_us / 1000000ULL);
+    ts.tv_nsec = (long)(target_us % 1000000ULL) * 1000;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+        /* 시그널로 깨면 남은 시간 다시 대기 */
+    }
+}
+
+void Replay_DefaultOptions(ReplayOptions *options)
+{
+    if (!options) return;
+
+    options->speed = 0.0;
+    options->rate = PT_REPLAY_LDPC_RATE;
+    options->samples_per_symbol = PT_REPLAY_SAMPLES_PER_SYMBOL;
+    options->max_frames = 0;
+    options->modulate = true;
+    options->video = false;
+}
+
+ReplayPipeline* Replay_Create(const ReplayOptions *options)
+{
+    ReplayPipeline *replay = malloc(sizeof(ReplayPipeline));
+    if (!replay) return NULL;
+    memset(replay, 0, sizeof(ReplayPipeline));
+
+    if (options) {
+        replay->options = *options;
+    } else {
+        Replay_DefaultOptions(&replay->options);
+    }
+    if (replay->options.samples_per_symbol <= 0) {
+        replay->options.samples_per_symbol = PT_REPLAY_SAMPLES_PER_SYMBOL;
+    }
+
+    replay->encoder = LDPC_Encoder_Create(replay->options.rate);
+    if (!replay->encoder) {
+        Replay_Destroy(replay);
+        return NULL;
+    }
+
+    int k = replay->encoder->K;
+    int n = replay->encoder->N;
+    replay->packer = FramePacker_Create(k);
+    replay->info = malloc((size_t)k);
+    replay->codeword = malloc((size_t)n);
+    replay->randomized = malloc((size_t)n);
+    if (!replay->packer || !replay->info || !replay->codeword || !replay->randomized) {
+        Replay_Destroy(replay);
+        return NULL;
+    }
+
+    if (replay->options.modulate) {
+        replay->modulator = SOQPSK_Modulator_Create(PT_REPLAY_CARRIER_HZ, PT_REPLAY_SAMPLE_RATE_HZ,
+                                                    replay->options.samples_per_symbol);
+        replay->samples = malloc((size_t)n * replay->options.samples_per_symbol *
+                                 sizeof(float_complex));
+        if (!replay->modulator || !replay->samples) {
+            Replay_Destroy(replay);
+            return NULL;
+        }
+    }
+
+    if (replay->options.video) {
+        /* 슬롯 = 코드워드 하나의 링크 송신 시간 */
+        double block_period_us = n / IRIGFIX_DATA_RATE * 1e6;
+        replay->mux = DownlinkMux_Create(k, block_period_us);
+        replay->demux = DownlinkDemux_Create(k, NULL, NULL);
+        replay->unpacker = FrameUnpacker_Create(k);
+        replay->video_pool = CameraFramePool_Create(PT_REPLAY_VIDEO_POOL_FRAMES);
+        if (!replay->mux || !replay->demux || !replay->unpacker || !replay->video_pool) {
+            Replay_Destroy(replay);
+            return NULL;
+        }
+    }
+
+    /* 재생마다 같은 랜덤화 열 → 같은 bit_hash */
+    LDPC_Randomizer_Init(0);
+    replay->report.bit_hash = FNV64_OFFSET;
+
+    return replay;
+}
+
+void Replay_Destroy(ReplayPipeline *replay)
+{
+    if (!replay) return;
+
+    if (replay->packer) FramePacker_Destroy(replay->packer);
+    if (replay->encoder) LDPC_Encoder_Destroy(replay->encoder);
+    if (replay->modulator) SOQPSK_Modulator_Destroy(replay->modulator);
+    if (replay->mux) DownlinkMux_Destroy(replay->mux);
+    if (replay->demux) DownlinkDemux_Destroy(replay->demux);
+    if (replay->unpacker) FrameUnpacker_Destroy(replay->unpacker);
+    if (replay->video_pool) CameraFramePool_Destroy(replay->video_pool);
+    if (replay->info) free(replay->info);
+    if (replay->codeword) free(replay->codeword);
+    if (replay->randomized) free(replay->randomized);
+    if (replay->samples) free(replay->samples);
+    free(replay);
+}
+
+/* 완성된 정보 블록 하나를 부호화 → 랜덤화 → 변조 */
+static void transmit_block(ReplayPipeline *replay)
+{
+    ReplayReport *r = &replay->report;
+    int n = replay->encoder->N;
+
+    uint64_t t0 = now_us();
+    LDPC_Encode(replay->encoder, replay->info, replay->codeword);
+    uint64_t t1 = now_us();
+    LDPC_Randomize(replay->codeword, replay->randomized, n);
+    uint64_t t2 = now_us();
+
+    for (int i = 0; i < n; i++) {
+        r->bit_hash = (r->bit_hash ^ replay->randomized[i]) * FNV64_PRIME;
+    }
+
+    if (replay->modulator) {
+        SOQPSK_Modulate(replay->modulator, replay->randomized, n, replay->samples);
+        r->samples += (uint64_t)n * replay->options.samples_per_symbol;
+    }
+    uint64_t t3 = now_us();
+
+    r->encode_us += t1 - t0;
+    r->randomize_us += t2 - t1;
+    r->modulate_us += t3 - t2;
+    r->codewords++;
+
+    /* 지상측 되돌림: 언패커가 info 를 제자리에서 바이트로 압축한 뒤 영상 조각 처리
+     * (다음 블록은 패커가 처음부터 다시 쓰므로 info 를 덮어써도 됨) */
+    if (replay->mux) {
+        const MissileTelemetryFrame *views[FRAME_PACKER_MAX_FRAMES_PER_BLOCK];
+        r->telemetry_frames_received += FrameUnpacker_Unpack(replay->unpacker, replay->info, views,
+                                                             FRAME_PACKER_MAX_FRAMES_PER_BLOCK);
+        r->video_frames_received += DownlinkDemux_PushBlock(replay->demux, replay->info);
+    }
+}
+
+/* 링크 모드: until_us 까지 송신 시각이 된 슬롯을 모두 보냄 */
+static void transmit_slots(ReplayPipeline *replay, uint64_t until_us)
+{
+    for (;;) {
+        uint64_t t0 = now_us();
+        bool due = DownlinkMux_NextBlock(replay->mux, until_us, replay->info);
+        replay->report.pack_us += now_us() - t0;
+        if (!due) break;
+        transmit_block(replay);
+    }
+}
+
+static void submit_camera(ReplayPipeline *replay, const FlightLogPacketHeader *hdr,
+                          const uint8_t *body)
+{
+    uint32_t frame_id, size;
+    const uint8_t *data;
+    if (!FlightLog_DecodeCamera(hdr, body, &frame_id, &data, &size)) return;
+    if (size == 0 || size > IRIGFIX_CAMERA_MAX_FRAME_SIZE) return;
+
+    /* 리더 버퍼는 다음 패킷에서 덮어쓰이므로 풀 프레임에 복사해 넘김 */
+    CameraFrame *frame = CameraFramePool_Acquire(replay->video_pool);
+    if (!frame) return;
+    memcpy(frame->data, data, size);
+    frame->frame_id = frame_id;
+    frame->timestamp_us = hdr->time_us;
+    frame->data_size = size;
+    frame->format = IRIGFIX_CAMERA_FORMAT_JPEG;
+
+    if (DownlinkMux_SubmitVideo(replay->mux, frame)) replay->report.video_frames_submitted++;
+    Camera_ReleaseFrame(frame);
+}
+
+void Replay_PushFrame(ReplayPipeline *replay, const MissileTelemetryFrame *frame)
+{
+    if (!replay || !frame) return;
+
+    if (replay->mux) {
+        transmit_slots(replay, frame->timestamp_us);
+        DownlinkMux_AddTelemetry(replay->mux, frame);
+        replay->report.frames++;
+        return;
+    }
+
+    /* 블록 경계에 걸친 프레임은 나머지를 다음 블록에 이어 씀 */
+    for (;;) {
+        uint64_t t0 = now_us();
+        bool done = FramePacker_AddFrame(replay->packer, frame, replay->info);
+        replay->report.pack_us += now_us() - t0;
+
+        if (FramePacker_IsBlockReady(replay->packer)) transmit_block(replay);
+        if (done) break;
+    }
+    replay->report.frames++;
+}
+
+void Replay_Finish(ReplayPipeline *replay)
+{
+    if (!replay) return;
+
+    if (replay->mux) {
+        /* 남은 텔레메트리/영상을 슬롯 시각을 진행시키며 모두 보냄 (영상은 마감까지만) */
+        while (DownlinkMux_HasPending(replay->mux)) {
+            transmit_slots(replay, (uint64_t)replay->mux->next_slot_us);
+        }
+        return;
+    }
+
+    if (!FramePacker_IsBlockReady(replay->packer) &&
+        FramePacker_Flush(replay->packer, replay->info)) {
+        transmit_block(replay);
+    }
+}
+
+static void finish_report(ReplayPipeline *replay)
+{
+    ReplayReport *r = &replay->report;
+    double elapsed_s = r->elapsed_us ? r->elapsed_us / 1e6 : 1e-6;
+
+    r->frames_per_s = r->frames / elapsed_s;
+    r->info_bits_per_s = (double)r->codewords * replay->encoder->K / elapsed_s;
+    r->realtime_factor = r->elapsed_us ? (double)r->log_span_us / r->elapsed_us : 0.0;
+
+    if (replay->mux) {
+        r->video_frames_sent = replay->mux->video_frames_sent;
+        r->video_frames_dropped = replay->mux->video_frames_stale +
+                                  replay->mux->video_frames_superseded;
+        r->video_bytes = replay->mux->video_bytes;
+        r->telemetry_latency_max_us = replay->mux->telemetry_latency_max_us;
+    }
+}
+
+bool Replay_RunFile(ReplayPipeline *replay, const char *filename, ReplayReport *report)
+{
+    if (!replay || !filename) return false;
+
+    FlightLogReader *reader = FlightLogReader_Open(filename);
+    if (!reader) return false;
+
+    ReplayReport *r = &replay->report;
+    double speed = replay->options.speed;
+    uint64_t start_us = now_us();
+    uint64_t first_ts = 0, last_ts = 0;
+    bool have_first = false;
+
+    FlightLogPacketHeader hdr;
+    const uint8_t *body;
+    LogEntry entry;
+
+    while (FlightLogReader_Next(reader, &hdr, &body)) {
+        if (hdr.channel_id == IRIGFIX_FLOG_CHANNEL_CAMERA && replay->mux) {
+            submit_camera(replay, &hdr, body);
+            continue;
+        }
+        if (hdr.channel_id != IRIGFIX_FLOG_CHANNEL_TELEMETRY) continue;
+        if (!FlightLog_DecodeTelemetry(&hdr, body, &entry)) continue;
+
+        if (!have_first) {
+            first_ts = entry.timestamp_us;
+            have_first = true;
+        }
+        last_ts = entry.timestamp_us;
+
+        /* 기록 시각의 speed 배 속도로 배치 (앞서면 대기) */
+        if (speed > 0.0 && entry.timestamp_us >= first_ts) {
+            uint64_t target = start_us + (uint64_t)((entry.timestamp_us - first_ts) / speed);
+            uint64_t now = now_us();
+            if (now < target) {
+                sleep_until_us(target);
+            } else if (now - target > r->max_lag_us) {
+                r->max_lag_us = now - target;
+            }
+        }
+
+        Replay_PushFrame(replay, &entry.telemetry);
+
+        if (replay->options.max_frames && r->frames >= replay->options.max_frames) break;
+    }
+    FlightLogReader_Close(reader);
+
+    Replay_Finish(replay);
+
+    r->elapsed_us = now_us() - start_us;
+    r->log_span_us = (last_ts > first_ts) ? last_ts - first_ts : 0;
+    finish_report(replay);
+
+    if (report) *report = *r;
+    return have_first;
+}
@@ -0,0 +1,411 @@
+#include "camera_codec.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * 카메라 영상 압축 구현 (JPEG 베이스라인, 흑백)
+ *
+ * 블록 = 8행 × 8레인 벡터. 1차 DCT 는 행 방향 벡터끼리 더하고 빼므로
+ * 8열이 한꺼번에 변환된다 (세로 방향). 전치 후 같은 연산으로 가로
+ * 방향을 변환하고 다시 전치해 자연 순서로 되돌린다. AAN 배율과
+ * 양자화는 역수 표 하나의 곱셈으로 합친다.
+ * ============================================================ */
+
+typedef float v8f __attribute__((vector_size(32)));
+typedef int32_t v8i __attribute__((vector_size(32)));
+
+/* 자연 순서 번호 (지그재그 순번 → 자연 순서) */
+static const uint8_t jpeg_zigzag[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/* ITU T.81 표 K.1 휘도 양자화 (자연 순서) */
+static const uint8_t jpeg_luma_quant[64] = {
+    16, 11, 10, 16,  24,  40,  51,  61,
+    12, 12, 14, 19,  26,  58,  60,  55,
+    14, 13, 16, 24,  40,  57,  69,  56,
+    14, 17, 22, 29,  51,  87,  80,  62,
+    18, 22, 37, 56,  68, 109, 103,  77,
+    24, 35, 55, 64,  81, 104, 113,  92,
+    49, 64, 78, 87, 103, 121, 120, 101,
+    72, 92, 95, 98, 112, 100, 103,  99
+};
+
+/* ITU T.81 표 K.3 / K.5 휘도 허프만 (길이별 개수, 심볼) */
+static const uint8_t jpeg_dc_bits[16] = { 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
+static const uint8_t jpeg_dc_vals[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+
+static const uint8_t jpeg_ac_bits[16] = { 0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d };
+static const uint8_t jpeg_ac_vals[162] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+    0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+    0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+    0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+
+/* AAN DCT 출력 배율: cos(k·π/16)·√2 (k = 0 은 1) */
+static const float aan_scale[8] = {
+    1.0f, 1.387039845f, 1.306562965f, 1.175875602f,
+    1.0f, 0.785694958f, 0.541196100f, 0.275899379f
+};
+
+/* 길이별 개수 + 심볼 → 정규 허프만 코드 표 */
+static void build_huffman(const uint8_t *bits, const uint8_t *vals,
+                          uint16_t *code_out, uint8_t *len_out)
+{
+    uint16_t code = 0;
+    int k = 0;
+    for (int len = 1; len <= 16; len++) {
+        for (int i = 0; i < bits[len - 1]; i++) {
+            code_out[vals[k]] = code++;
+            len_out[vals[k]] = (uint8_t)len;
+            k++;
+        }
+        code <<= 1;
+    }
+}
+
+CameraCodec* CameraCodec_Create(int quality, uint32_t target_size)
+{
+    CameraCodec *codec = aligned_alloc(32, sizeof(CameraCodec));
+    if (!codec) return NULL;
+    memset(codec, 0, sizeof(CameraCodec));
+
+    build_huffman(jpeg_dc_bits, jpeg_dc_vals, codec->dc_code, codec->dc_len);
+    build_huffman(jpeg_ac_bits, jpeg_ac_vals, codec->ac_code, codec->ac_len);
+
+    codec->target_size = target_size;
+    CameraCodec_SetQuality(codec, quality ? quality : PT_CAMERA_JPEG_QUALITY);
+
+    return codec;
+}
+
+void CameraCodec_Destroy(CameraCodec *codec)
+{
+    if (codec) free(codec);
+}
+
+/* IJG 품질 배율: 50 = 표준 표 그대로 */
+void CameraCodec_SetQuality(CameraCodec *codec, int quality)
+{
+    if (!codec) return;
+
+    if (quality < 1) quality = 1;
+    if (quality > 100) quality = 100;
+    codec->quality = quality;
+
+    int scale = (quality < 50) ? 5000 / quality : 200 - quality * 2;
+    uint8_t table[64];
+    for (int i = 0; i < 64; i++) {
+        int q = (jpeg_luma_quant[i] * scale + 50) / 100;
+        if (q < 1) q = 1;
+        if (q > 255) q = 255;
+        table[i] = (uint8_t)q;
+    }
+
+    for (int k = 0; k < 64; k++) {
+        codec->qtable[k] = table[jpeg_zigzag[k]];
+    }
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 8; col++) {
+            int i = row * 8 + col;
+            codec->qscale[i] = 1.0f / ((float)table[i] * aan_scale[row] * aan_scale[col] * 8.0f);
+        }
+    }
+}
+
+/* ============================================================
+ * 8레인 DCT / 양자화
+ * ============================================================ */
+
+/* AAN 1차원 DCT 를 행 벡터 8개에 적용 (각 레인 = 한 열) */
+static inline void dct_rows(v8f *d)
+{
+    v8f tmp0 = d[0] + d[7], tmp7 = d[0] - d[7];
+    v8f tmp1 = d[1] + d[6], tmp6 = d[1] - d[6];
+    v8f tmp2 = d[2] + d[5], tmp5 = d[2] - d[5];
+    v8f tmp3 = d[3] + d[4], tmp4 = d[3] - d[4];
+
+    /* 짝수 부분 */
+    v8f tmp10 = tmp0 + tmp3, tmp13 = tmp0 - tmp3;
+    v8f tmp11 = tmp1 + tmp2, tmp12 = tmp1 - tmp2;
+    d[0] = tmp10 + tmp11;
+    d[4] = tmp10 - tmp11;
+    v8f z1 = (tmp12 + tmp13) * 0.707106781f;
+    d[2] = tmp13 + z1;
+    d[6] = tmp13 - z1;
+
+    /* 홀수 부분 */
+    tmp10 = tmp4 + tmp5;
+    tmp11 = tmp5 + tmp6;
+    tmp12 = tmp6 + tmp7;
+    v8f z5 = (tmp10 - tmp12) * 0.382683433f;
+    v8f z2 = tmp10 * 0.541196100f + z5;
+    v8f z4 = tmp12 * 1.306562965f + z5;
+    v8f z3 = tmp11 * 0.707106781f;
+    v8f z11 = tmp7 + z3, z13 = tmp7 - z3;
+    d[5] = z13 + z2;
+    d[3] = z13 - z2;
+    d[1] = z11 + z4;
+    d[7] = z11 - z4;
+}
+
+static inline void transpose8(v8f *d)
+{
+    float t[64] __attribute__((aligned(32)));
+    memcpy(t, d, sizeof(t));
+    for (int r = 0; r < 8; r++) {
+        for (int c = 0; c < 8; c++) {
+            d[r][c] = t[c * 8 + r];
+        }
+    }
+}
+
+/* 블록 하나 (레벨 이동된 행 8개) → 양자화 계수 (자연 순서) */
+static inline void dct_quantize(const CameraCodec *codec, v8f *d, int32_t *coef)
+{
+    dct_rows(d);
+    transpose8(d);
+    dct_rows(d);
+    transpose8(d);
+
+    /* 반올림: 양수로 옮긴 뒤 절삭 (|계수| < 2048) */
+    const v8f bias = (v8f){ 16384.5f, 16384.5f, 16384.5f, 16384.5f,
+                            16384.5f, 16384.5f, 16384.5f, 16384.5f };
+    for (int r = 0; r < 8; r++) {
+        v8f scale;
+        memcpy(&scale, &codec->qscale[r * 8], sizeof(scale));
+        v8i q = __builtin_convertvector(d[r] * scale + bias, v8i) - 16384;
+        memcpy(&coef[r * 8], &q, sizeof(q));
+    }
+}
+
+/* ============================================================
+ * 비트 출력 (MSB 우선, 0xFF 뒤 0x00 삽입)
+ * ============================================================ */
+
+typedef struct {
+    uint8_t *buf;
+    uint32_t pos;
+    uint32_t capacity;
+    uint32_t acc;
+    int nbits;
+    bool overflow;
+} JpegBitWriter;
+
+static inline void jbw_byte(JpegBitWriter *bw, uint8_t byte)
+{
+    if (bw->pos + 2 > bw->capacity) {
+        bw->overflow = true;
+        return;
+    }
+    bw->buf[bw->pos++] = byte;
+    if (byte == 0xFF) bw->buf[bw->pos++] = 0x00;
+}
+
+static inline void jbw_put(JpegBitWriter *bw, uint32_t value, int width)
+{
+    bw->acc = (bw->acc << width) | (value & ((1u << width) - 1));
+    bw->nbits += width;
+    while (bw->nbits >= 8) {
+        bw->nbits -= 8;
+        jbw_byte(bw, (uint8_t)(bw->acc >> bw->nbits));
+    }
+}
+
+/* 남은 비트를 1 로 채워 바이트 경계 맞춤 */
+static void jbw_flush(JpegBitWriter *bw)
+{
+    if (bw->nbits > 0) jbw_put(bw, 0x7F, 8 - bw->nbits);
+}
+
+static inline int bit_length(int32_t magnitude)
+{
+    return magnitude ? 32 - __builtin_clz((uint32_t)magnitude) : 0;
+}
+
+static void encode_block(const CameraCodec *codec, JpegBitWriter *bw,
+                         const int32_t *coef, int32_t *prev_dc)
+{
+    int32_t diff = coef[0] - *prev_dc;
+    *prev_dc = coef[0];
+
+    int size = bit_length(diff < 0 ? -diff : diff);
+    jbw_put(bw, codec->dc_code[size], codec->dc_len[size]);
+    if (size) jbw_put(bw, (uint32_t)(diff < 0 ? diff - 1 : diff), size);
+
+    int run = 0;
+    for (int k = 1; k < 64; k++) {
+        int32_t v = coef[jpeg_zigzag[k]];
+        if (v == 0) {
+            run++;
+            continue;
+        }
+        while (run > 15) {
+            jbw_put(bw, codec->ac_code[0xF0], codec->ac_len[0xF0]);
+            run -= 16;
+        }
+        size = bit_length(v < 0 ? -v : v);
+        int symbol = (run << 4) | size;
+        jbw_put(bw, codec->ac_code[symbol], codec->ac_len[symbol]);
+        jbw_put(bw, (uint32_t)(v < 0 ? v - 1 : v), size);
+        run = 0;
+    }
+    if (run > 0) jbw_put(bw, codec->ac_code[0x00], codec->ac_len[0x00]);
+}
+
+/* ============================================================
+ * 헤더
+ * ============================================================ */
+
+static inline uint8_t* put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+    return p + 2;
+}
+
+static uint8_t* put_dht(uint8_t *p, uint8_t table_id, const uint8_t *bits,
+                        const uint8_t *vals, int count)
+{
+    p = put_u16(p, 0xFFC4);
+    p = put_u16(p, (uint16_t)(2 + 1 + 16 + count));
+    *p++ = table_id;
+    memcpy(p, bits, 16);
+    p += 16;
+    memcpy(p, vals, count);
+    return p + count;
+}
+
+static uint32_t write_header(const CameraCodec *codec, uint8_t *out,
+                             uint16_t width, uint16_t height)
+{
+    static const uint8_t jfif_app0[18] = {
+        0xFF, 0xE0, 0x00, 0x10, 'J', 'F', 'I', 'F', 0x00,
+        0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00
+    };
+    uint8_t *p = out;
+
+    p = put_u16(p, 0xFFD8);             /* SOI */
+    memcpy(p, jfif_app0, sizeof(jfif_app0));
+    p += sizeof(jfif_app0);
+
+    p = put_u16(p, 0xFFDB);             /* DQT: 8비트, 표 0 */
+    p = put_u16(p, 2 + 1 + 64);
+    *p++ = 0x00;
+    memcpy(p, codec->qtable, 64);
+    p += 64;
+
+    p = put_u16(p, 0xFFC0);             /* SOF0: 8비트, 성분 1개 */
+    p = put_u16(p, 2 + 6 + 3);
+    *p++ = 8;
+    p = put_u16(p, height);
+    p = put_u16(p, width);
+    *p++ = 1;
+    *p++ = 1;                           /* 성분 번호 */
+    *p++ = 0x11;                        /* 1×1 표본 */
+    *p++ = 0;                           /* 양자화 표 0 */
+
+    p = put_dht(p, 0x00, jpeg_dc_bits, jpeg_dc_vals, sizeof(jpeg_dc_vals));
+    p = put_dht(p, 0x10, jpeg_ac_bits, jpeg_ac_vals, sizeof(jpeg_ac_vals));
+
+    p = put_u16(p, 0xFFDA);             /* SOS */
+    p = put_u16(p, 2 + 1 + 2 + 3);
+    *p++ = 1;
+    *p++ = 1;
+    *p++ = 0x00;                        /* DC 0 / AC 0 */
+    *p++ = 0;
+    *p++ = 63;
+    *p++ = 0;
+
+    return (uint32_t)(p - out);
+}
+
+/* ============================================================
+ * 부호화
+ * ============================================================ */
+
+/* 블록 로드: 영상 밖은 가장자리 화소 반복, 레벨 이동 -128 */
+static inline void load_block(const uint8_t *pixels, uint16_t width, uint16_t height,
+                              int bx, int by, v8f *d)
+{
+    bool inside = (bx + 8 <= width) && (by + 8 <= height);
+    for (int r = 0; r < 8; r++) {
+        int y = (by + r < height) ? by + r : height - 1;
+        const uint8_t *row = pixels + (size_t)y * width;
+        if (inside) {
+            for (int c = 0; c < 8; c++) d[r][c] = (float)row[bx + c] - 128.0f;
+        } else {
+            for (int c = 0; c < 8; c++) {
+                int x = (bx + c < width) ? bx + c : width - 1;
+                d[r][c] = (float)row[x] - 128.0f;
+            }
+        }
+    }
+}
+
+/* 결과 크기로 다음 프레임 품질 조정 (2배 이상 벗어나면 큰 걸음, 아니면 1씩) */
+static void rate_control(CameraCodec *codec, uint32_t size)
+{
+    if (codec->target_size == 0) return;
+
+    float high = codec->target_size * (1.0f + PT_CAMERA_JPEG_SIZE_TOLERANCE);
+    float low = codec->target_size * (1.0f - PT_CAMERA_JPEG_SIZE_TOLERANCE);
+    bool far = size > codec->target_size * 2 || size * 2 < codec->target_size;
+    int step = far ? PT_CAMERA_JPEG_QUALITY_STEP : 1;
+    int quality = codec->quality;
+
+    if (size > high && quality > PT_CAMERA_JPEG_QUALITY_MIN) {
+        quality -= step;
+        if (quality < PT_CAMERA_JPEG_QUALITY_MIN) quality = PT_CAMERA_JPEG_QUALITY_MIN;
+    } else if (size < low && quality < PT_CAMERA_JPEG_QUALITY_MAX) {
+        quality += step;
+        if (quality > PT_CAMERA_JPEG_QUALITY_MAX) quality = PT_CAMERA_JPEG_QUALITY_MAX;
+    }
+    if (quality != codec->quality) CameraCodec_SetQuality(codec, quality);
+}
+
+uint32_t CameraCodec_EncodeGray(CameraCodec *codec, const uint8_t *pixels,
+                                uint16_t width, uint16_t height,
+                                uint8_t *out, uint32_t out_capacity)
+{
+    if (!codec || !pixels || !out || width == 0 || height == 0) return 0;
+    if (out_capacity < IRIGFIX_JPEG_HEADER_SIZE + 2) return 0;
+
+    uint32_t header = write_header(codec, out, width, height);
+
+    JpegBitWriter bw = { out, header, out_capacity - 2, 0, 0, false };
+    v8f block[8];
+    int32_t coef[64] __attribute__((aligned(32)));
+    int32_t prev_dc = 0;
+
+    for (int by = 0; by < height && !bw.overflow; by += IRIGFIX_JPEG_BLOCK) {
+        for (int bx = 0; bx < width; bx += IRIGFIX_JPEG_BLOCK) {
+            load_block(pixels, width, height, bx, by, block);
+            dct_quantize(codec, block, coef);
+            encode_block(codec, &bw, coef, &prev_dc);
+        }
+    }
+    jbw_flush(&bw);
+    if (bw.overflow) return 0;
+
+    uint32_t size = bw.pos;
+    put_u16(out + size, 0xFFD9);        /* EOI (자리는 capacity - 2 로 남겨 둠) */
+    size += 2;
+
+    codec->frames_encoded++;
+    codec->bytes_out += size;
+    rate_control(codec, size);
+
+    return size;
+}
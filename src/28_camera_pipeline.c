@@ -0,0 +1,290 @@
+#include "camera_pipeline.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+/* ============================================================
+ * 카메라 압축 파이프라인 구현
+ *
+ * 워커는 요청 하나마다 원시 프레임 (풀) 캡처 → (축소 설정이 있으면
+ * 축소 프레임 (풀) 으로 변환 후 원시 반환) → 압축 프레임 (풀) 에 JPEG
+ * 부호화 → 원시 반환 → 로그/다운링크에 참조 전달 순으로 처리한다.
+ * 요청 슬롯은 처리가 끝난 뒤에 head 를 올리므로 WaitIdle 은 head == tail
+ * 만 보면 된다.
+ * ============================================================ */
+
+#define TRIGGER_MASK (PT_CAMERA_TRIGGER_QUEUE - 1)
+#define DOWNLINK_MASK (PT_CAMERA_DOWNLINK_QUEUE - 1)
+
+_Static_assert((PT_CAMERA_TRIGGER_QUEUE & TRIGGER_MASK) == 0,
+               "PT_CAMERA_TRIGGER_QUEUE must be a power of two");
+_Static_assert((PT_CAMERA_DOWNLINK_QUEUE & DOWNLINK_MASK) == 0,
+               "PT_CAMERA_DOWNLINK_QUEUE must be a power of two");
+
+static inline uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/* ============================================================
+ * 큐
+ * ============================================================ */
+
+static bool downlink_push(CameraDownlinkQueue *q, CameraFrame *frame)
+{
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (tail - atomic_load_explicit(&q->head, memory_order_acquire) >= PT_CAMERA_DOWNLINK_QUEUE) {
+        return false;
+    }
+    q->frames[tail & DOWNLINK_MASK] = frame;
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+static CameraFrame* downlink_pop(CameraDownlinkQueue *q)
+{
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    if (head == atomic_load_explicit(&q->tail, memory_order_acquire)) return NULL;
+
+    CameraFrame *frame = q->frames[head & DOWNLINK_MASK];
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return frame;
+}
+
+/* ============================================================
+ * 워커
+ * ============================================================ */
+
+/* ROI / 축소가 필요하면 새 풀 프레임으로 바꿔 원본 반환 (실패하면 원본 그대로) */
+static CameraFrame* scale_frame(CameraPipeline *pipeline, CameraFrame *raw,
+                                const CameraScaleParams *scale)
+{
+    CameraScaleParams resolved;
+    if (!CameraScaler_Resolve(scale, raw->width, raw->height, &resolved)) return raw;
+
+    CameraFrame *scaled = CameraFramePool_Acquire(pipeline->camera->pool);
+    if (!scaled) return raw;
+
+    uint64_t t0 = now_us();
+    if (!CameraScaler_Process(pipeline->scaler, &resolved, raw, scaled)) {
+        Camera_ReleaseFrame(scaled);
+        return raw;
+    }
+    atomic_fetch_add(&pipeline->scale_us_total, now_us() - t0);
+    atomic_fetch_add(&pipeline->frames_scaled, 1);
+
+    Camera_ReleaseFrame(raw);
+    return scaled;
+}
+
+static void compress_one(CameraPipeline *pipeline, const CameraTrigger *trigger)
+{
+    CameraDevice *cam = pipeline->camera;
+    uint64_t timestamp_us = trigger->timestamp_us;
+
+    CameraFrame *raw = Camera_CaptureFrame(cam);
+    if (!raw || raw->data_size == 0) {
+        Camera_ReleaseFrame(raw);
+        atomic_fetch_add(&pipeline->capture_failures, 1);
+        return;
+    }
+    uint32_t raw_size = raw->data_size;
+    raw = scale_frame(pipeline, raw, &trigger->scale);
+
+    CameraFrame *jpeg = CameraFramePool_Acquire(cam->pool);
+    if (!jpeg) {
+        Camera_ReleaseFrame(raw);
+        atomic_fetch_add(&pipeline->capture_failures, 1);
+        return;
+    }
+
+    /* 목표 크기는 실제 부호화 화소 수 기준, 로그 저장 상한 (PT_CAMERA_FRAME_SIZE) 안에서만 출력 */
+    pipeline->codec->target_size = raw->data_size / PT_CAMERA_COMPRESSION_RATIO;
+    uint64_t t0 = now_us();
+    uint32_t size = CameraCodec_EncodeGray(pipeline->codec, raw->data, raw->width, raw->height,
+                                           jpeg->data, PT_CAMERA_FRAME_SIZE);
+    uint32_t elapsed = (uint32_t)(now_us() - t0);
+
+    jpeg->frame_id = raw->frame_id;
+    jpeg->timestamp_us = timestamp_us;
+    jpeg->width = raw->width;
+    jpeg->height = raw->height;
+    jpeg->data_size = size;
+    jpeg->format = IRIGFIX_CAMERA_FORMAT_JPEG;
+    Camera_ReleaseFrame(raw);
+
+    if (size == 0) {
+        Camera_ReleaseFrame(jpeg);
+        atomic_fetch_add(&pipeline->capture_failures, 1);
+        return;
+    }
+
+    atomic_fetch_add(&pipeline->frames_compressed, 1);
+    atomic_fetch_add(&pipeline->raw_bytes, raw_size);
+    atomic_fetch_add(&pipeline->compressed_bytes, size);
+    atomic_fetch_add(&pipeline->encode_us_total, elapsed);
+    if (elapsed > atomic_load(&pipeline->encode_us_max)) {
+        atomic_store(&pipeline->encode_us_max, elapsed);
+    }
+
+    /* 같은 버퍼를 로그와 다운링크가 각자 참조 */
+    if (pipeline->log) DataStorage_WriteCameraFrameRef(pipeline->log, jpeg);
+
+    Camera_RetainFrame(jpeg);
+    if (!downlink_push(&pipeline->downlink, jpeg)) {
+        Camera_ReleaseFrame(jpeg);
+        atomic_fetch_add(&pipeline->downlink_dropped, 1);
+    }
+
+    Camera_ReleaseFrame(jpeg);
+}
+
+static void* pipeline_thread(void *arg)
+{
+    CameraPipeline *pipeline = (CameraPipeline *)arg;
+    CameraTriggerQueue *q = &pipeline->triggers;
+
+    for (;;) {
+        bool running = atomic_load(&pipeline->running);
+
+        uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+        while (head != atomic_load_explicit(&q->tail, memory_order_acquire)) {
+            compress_one(pipeline, &q->entries[head & TRIGGER_MASK]);
+            atomic_store_explicit(&q->head, ++head, memory_order_release);
+        }
+
+        if (!running) break;
+
+        while (sem_wait(&pipeline->wakeup) != 0 && errno == EINTR) {
+            /* 시그널로 깨면 다시 대기 */
+        }
+    }
+
+    return NULL;
+}
+
+/* ============================================================
+ * 생성 / 해제
+ * ============================================================ */
+
+CameraPipeline* CameraPipeline_Create(CameraDevice *camera, LogBuffer *log)
+{
+    if (!camera || !camera->pool) return NULL;
+
+    CameraPipeline *pipeline = malloc(sizeof(CameraPipeline));
+    if (!pipeline) return NULL;
+    memset(pipeline, 0, sizeof(CameraPipeline));
+
+    pipeline->camera = camera;
+    pipeline->log = log;
+
+    /* 목표 크기 = 원시 프레임 / PT_CAMERA_COMPRESSION_RATIO */
+    uint32_t raw_size = PT_CAMERA_RESOLUTION_WIDTH * PT_CAMERA_RESOLUTION_HEIGHT;
+    pipeline->codec = CameraCodec_Create(PT_CAMERA_JPEG_QUALITY,
+                                         raw_size / PT_CAMERA_COMPRESSION_RATIO);
+    pipeline->scaler = CameraScaler_Create();
+    if (!pipeline->codec || !pipeline->scaler) {
+        CameraCodec_Destroy(pipeline->codec);
+        CameraScaler_Destroy(pipeline->scaler);
+        free(pipeline);
+        return NULL;
+    }
+    CameraScaler_DefaultParams(&pipeline->scale);
+
+    atomic_init(&pipeline->triggers.head, 0);
+    atomic_init(&pipeline->triggers.tail, 0);
+    atomic_init(&pipeline->downlink.head, 0);
+    atomic_init(&pipeline->downlink.tail, 0);
+    atomic_init(&pipeline->running, true);
+
+    if (sem_init(&pipeline->wakeup, 0, 0) != 0) {
+        CameraCodec_Destroy(pipeline->codec);
+        CameraScaler_Destroy(pipeline->scaler);
+        free(pipeline);
+        return NULL;
+    }
+    if (pthread_create(&pipeline->thread, NULL, pipeline_thread, pipeline) != 0) {
+        sem_destroy(&pipeline->wakeup);
+        CameraCodec_Destroy(pipeline->codec);
+        CameraScaler_Destroy(pipeline->scaler);
+        free(pipeline);
+        return NULL;
+    }
+
+    return pipeline;
+}
+
+void CameraPipeline_Destroy(CameraPipeline *pipeline)
+{
+    if (!pipeline) return;
+
+    atomic_store(&pipeline->running, false);
+    sem_post(&pipeline->wakeup);
+    pthread_join(pipeline->thread, NULL);
+
+    CameraFrame *frame;
+    while ((frame = downlink_pop(&pipeline->downlink)) != NULL) {
+        Camera_ReleaseFrame(frame);
+    }
+
+    sem_destroy(&pipeline->wakeup);
+    CameraCodec_Destroy(pipeline->codec);
+    CameraScaler_Destroy(pipeline->scaler);
+    free(pipeline);
+}
+
+/* ============================================================
+ * 텔레메트리 루프 / 다운링크 측
+ * ============================================================ */
+
+void CameraPipeline_SetScale(CameraPipeline *pipeline, const CameraScaleParams *scale)
+{
+    if (!pipeline || !scale) return;
+    pipeline->scale = *scale;
+}
+
+void CameraPipeline_ApplyConfig(CameraPipeline *pipeline, ConfigSet *config)
+{
+    if (!pipeline || !config) return;
+    CameraScaler_ApplyConfig(&pipeline->scale, config);
+}
+
+bool CameraPipeline_Trigger(CameraPipeline *pipeline, uint64_t timestamp_us)
+{
+    if (!pipeline) return false;
+
+    CameraTriggerQueue *q = &pipeline->triggers;
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (tail - atomic_load_explicit(&q->head, memory_order_acquire) >= PT_CAMERA_TRIGGER_QUEUE) {
+        atomic_fetch_add(&pipeline->triggers_dropped, 1);
+        return false;
+    }
+
+    q->entries[tail & TRIGGER_MASK].timestamp_us = timestamp_us;
+    q->entries[tail & TRIGGER_MASK].scale = pipeline->scale;
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    sem_post(&pipeline->wakeup);
+    return true;
+}
+
+CameraFrame* CameraPipeline_PopDownlink(CameraPipeline *pipeline)
+{
+    if (!pipeline) return NULL;
+    return downlink_pop(&pipeline->downlink);
+}
+
+void CameraPipeline_WaitIdle(CameraPipeline *pipeline)
+{
+    if (!pipeline) return;
+
+    CameraTriggerQueue *q = &pipeline->triggers;
+    while (atomic_load_explicit(&q->head, memory_order_acquire) !=
+           atomic_load_explicit(&q->tail, memory_order_acquire)) {
+        sem_post(&pipeline->wakeup);
+        usleep(1000);
+    }
+}
@@ -0,0 +1,330 @@
+#include "downlink_mux.h"
+#include "flight_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * 하향 링크 다중화 / 지상측 영상 재조립 구현
+ *
+ * 슬롯 하나 = 텔레메트리 패킹 (필수) → 블록 닫기 → 여유 자리에 영상
+ * 조각. 영상 스케줄링은 슬롯 시작 시각 기준으로 마감을 판정한다.
+ * ============================================================ */
+
+static inline uint8_t* put_be(uint8_t *p, uint32_t value, int bytes)
+{
+    for (int i = bytes - 1; i >= 0; i--) *p++ = (uint8_t)(value >> (i * 8));
+    return p;
+}
+
+static inline uint32_t get_be(const uint8_t *p, int bytes)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++) value = (value << 8) | p[i];
+    return value;
+}
+
+/* ============================================================
+ * 다중화기
+ * ============================================================ */
+
+DownlinkMux* DownlinkMux_Create(int info_bits, double block_period_us)
+{
+    if (block_period_us <= 0.0) return NULL;
+
+    DownlinkMux *mux = malloc(sizeof(DownlinkMux));
+    if (!mux) return NULL;
+    memset(mux, 0, sizeof(DownlinkMux));
+
+    mux->packer = FramePacker_Create(info_bits);
+    if (!mux->packer) {
+        free(mux);
+        return NULL;
+    }
+    mux->fragment = malloc(mux->packer->payload_capacity);
+    if (!mux->fragment) {
+        FramePacker_Destroy(mux->packer);
+        free(mux);
+        return NULL;
+    }
+
+    mux->block_period_us = block_period_us;
+    mux->next_slot_us = -1.0;
+
+    return mux;
+}
+
+void DownlinkMux_Destroy(DownlinkMux *mux)
+{
+    if (!mux) return;
+
+    for (uint32_t i = 0; i < mux->video_count; i++) {
+        Camera_ReleaseFrame(mux->video[(mux->video_head + i) % PT_MUX_VIDEO_QUEUE].frame);
+    }
+    FramePacker_Destroy(mux->packer);
+    free(mux->fragment);
+    free(mux);
+}
+
+bool DownlinkMux_AddTelemetry(DownlinkMux *mux, const MissileTelemetryFrame *frame)
+{
+    if (!mux || !frame) return false;
+
+    if (mux->telemetry_count == PT_MUX_TELEMETRY_QUEUE) {
+        mux->telemetry_overflow++;
+        return false;
+    }
+
+    uint32_t tail = (mux->telemetry_head + mux->telemetry_count) % PT_MUX_TELEMETRY_QUEUE;
+    memcpy(&mux->telemetry[tail], frame, sizeof(MissileTelemetryFrame));
+    mux->telemetry_count++;
+    return true;
+}
+
+/* 맨 앞 영상 프레임 반환 (보내던 중이면 그 자리에서 중단) */
+static void video_pop(DownlinkMux *mux)
+{
+    Camera_ReleaseFrame(mux->video[mux->video_head].frame);
+    mux->video[mux->video_head].frame = NULL;
+    mux->video_head = (mux->video_head + 1) % PT_MUX_VIDEO_QUEUE;
+    mux->video_count--;
+    mux->video_offset = 0;
+}
+
+bool DownlinkMux_SubmitVideo(DownlinkMux *mux, CameraFrame *frame)
+{
+    if (!mux || !frame || !frame->data) return false;
+    if (frame->data_size == 0 || frame->data_size > IRIGFIX_CAMERA_MAX_FRAME_SIZE) return false;
+
+    /* 새 영상이 오래된 영상보다 가치 있음 → 가장 오래된 것을 밀어냄 */
+    if (mux->video_count == PT_MUX_VIDEO_QUEUE) {
+        video_pop(mux);
+        mux->video_frames_superseded++;
+    }
+
+    Camera_RetainFrame(frame);
+    uint32_t tail = (mux->video_head + mux->video_count) % PT_MUX_VIDEO_QUEUE;
+    mux->video[tail].frame = frame;
+    mux->video[tail].deadline_us = frame->timestamp_us + PT_MUX_VIDEO_MAX_AGE_US;
+    mux->video_count++;
+    return true;
+}
+
+bool DownlinkMux_HasPending(const DownlinkMux *mux)
+{
+    if (!mux) return false;
+    return mux->telemetry_count > 0 || mux->video_count > 0;
+}
+
+/* 마감 안에 끝낼 수 없는 맨 앞 프레임을 버림 */
+static void drop_stale_video(DownlinkMux *mux, uint64_t now_us)
+{
+    while (mux->video_count > 0) {
+        DownlinkVideoSlot *slot = &mux->video[mux->video_head];
+        bool stale = now_us > slot->deadline_us;
+
+        /* 최근 여유 평균으로 남은 바이트 송신에 걸릴 시간 예상 */
+        uint32_t per_block = (mux->spare_avg > IRIGFIX_MUX_FRAGMENT_OVERHEAD)
+                             ? mux->spare_avg - IRIGFIX_MUX_FRAGMENT_OVERHEAD : 0;
+        if (!stale && per_block > 0) {
+            uint32_t remaining = slot->frame->data_size - mux->video_offset;
+            uint32_t blocks = (remaining + per_block - 1) / per_block;
+            stale = now_us + (uint64_t)(blocks * mux->block_period_us) > slot->deadline_us;
+        }
+
+        if (!stale) break;
+        video_pop(mux);
+        mux->video_frames_stale++;
+    }
+}
+
+/* 닫힌 블록의 여유 자리를 영상 조각으로 채움. 반환: 사용한 바이트 */
+static uint32_t fill_video(DownlinkMux *mux, uint8_t *info, uint32_t spare, uint64_t now_us)
+{
+    uint32_t used = 0;
+
+    drop_stale_video(mux, now_us);
+
+    while (mux->video_count > 0 && spare - used >= PT_MUX_MIN_FRAGMENT_BYTES) {
+        CameraFrame *frame = mux->video[mux->video_head].frame;
+        uint32_t room = spare - used - IRIGFIX_MUX_FRAGMENT_OVERHEAD;
+        uint32_t remaining = frame->data_size - mux->video_offset;
+        uint32_t len = (remaining < room) ? remaining : room;
+
+        uint8_t *p = mux->fragment;
+        *p++ = IRIGFIX_MUX_FRAGMENT_MARKER;
+        p = put_be(p, frame->frame_id, 4);
+        p = put_be(p, frame->data_size, 3);
+        p = put_be(p, mux->video_offset, 3);
+        p = put_be(p, len, 2);
+        memcpy(p, frame->data + mux->video_offset, len);
+        p += len;
+        uint32_t crc = FlightLog_CRC32(0, mux->fragment, (uint32_t)(p - mux->fragment));
+        p = put_be(p, crc, 4);
+
+        uint32_t frag_len = (uint32_t)(p - mux->fragment);
+        FramePacker_WriteSpare(mux->packer, info, used, mux->fragment, frag_len);
+        used += frag_len;
+
+        mux->video_fragments++;
+        mux->video_bytes += len;
+        mux->video_offset += len;
+
+        if (mux->video_offset == frame->data_size) {
+            video_pop(mux);
+            mux->video_frames_sent++;
+        }
+    }
+
+    return used;
+}
+
+static void build_block(DownlinkMux *mux, uint8_t *info, uint64_t now_us)
+{
+    FramePacker *packer = mux->packer;
+
+    /* 1. 텔레메트리 (필수): 블록이 차면 나머지는 다음 슬롯 */
+    bool full = false;
+    while (mux->telemetry_count > 0 && !full) {
+        bool done = FramePacker_AddFrame(packer, &mux->telemetry[mux->telemetry_head], info);
+        if (done) {
+            /* 지연 = 슬롯 끝 (마지막 바이트 송신) - 프레임 시각 */
+            uint64_t sent_us = now_us + (uint64_t)mux->block_period_us;
+            uint64_t ts = mux->telemetry[mux->telemetry_head].timestamp_us;
+            if (sent_us > ts && sent_us - ts > mux->telemetry_latency_max_us) {
+                mux->telemetry_latency_max_us = sent_us - ts;
+            }
+            mux->telemetry_head = (mux->telemetry_head + 1) % PT_MUX_TELEMETRY_QUEUE;
+            mux->telemetry_count--;
+            mux->telemetry_frames++;
+        }
+        full = FramePacker_IsBlockReady(packer);
+    }
+
+    /* 2. 송신 시각이므로 덜 찬 블록 (빈 블록 포함) 도 닫음 */
+    if (!full) FramePacker_Close(packer, info);
+
+    /* 3. 여유 자리 = 영상 */
+    uint32_t spare = FramePacker_GetSpareBytes(packer);
+    mux->spare_avg += ((int32_t)spare - (int32_t)mux->spare_avg) >> PT_MUX_SPARE_AVG_SHIFT;
+    uint32_t used = fill_video(mux, info, spare, now_us);
+    mux->spare_bytes_unused += spare - used;
+    mux->blocks++;
+}
+
+bool DownlinkMux_NextBlock(DownlinkMux *mux, uint64_t now_us, uint8_t *info)
+{
+    if (!mux || !info) return false;
+
+    if (mux->next_slot_us < 0.0) mux->next_slot_us = (double)now_us;
+
+    /* 슬롯 시각은 us 단위로 내림 (Finish 가 next_slot_us 를 그대로 넘겨도 진행) */
+    uint64_t slot_us = (uint64_t)mux->next_slot_us;
+    if (slot_us > now_us) return false;
+
+    build_block(mux, info, slot_us);
+    mux->next_slot_us += mux->block_period_us;
+    return true;
+}
+
+/* ============================================================
+ * 지상측 재조립
+ * ============================================================ */
+
+DownlinkDemux* DownlinkDemux_Create(int info_bits, DownlinkVideoFn on_frame, void *context)
+{
+    if (info_bits < (IRIGFIX_PACKER_HEADER_BYTES + 1) * 8) return NULL;
+
+    DownlinkDemux *demux = malloc(sizeof(DownlinkDemux));
+    if (!demux) return NULL;
+    memset(demux, 0, sizeof(DownlinkDemux));
+
+    demux->frame_buf = malloc(IRIGFIX_CAMERA_MAX_FRAME_SIZE);
+    if (!demux->frame_buf) {
+        free(demux);
+        return NULL;
+    }
+
+    demux->payload_capacity = info_bits / 8 - IRIGFIX_PACKER_HEADER_BYTES;
+    demux->on_frame = on_frame;
+    demux->context = context;
+
+    return demux;
+}
+
+void DownlinkDemux_Destroy(DownlinkDemux *demux)
+{
+    if (!demux) return;
+
+    free(demux->frame_buf);
+    free(demux);
+}
+
+static void abandon_frame(DownlinkDemux *demux)
+{
+    if (demux->active) demux->frames_incomplete++;
+    demux->active = false;
+}
+
+int DownlinkDemux_PushBlock(DownlinkDemux *demux, const uint8_t *block)
+{
+    if (!demux || !block) return 0;
+
+    uint32_t payload_len = get_be(block + 2, 2);
+    if (payload_len > demux->payload_capacity) {
+        /* 헤더 손상: 조각 위치를 알 수 없음 */
+        abandon_frame(demux);
+        return 0;
+    }
+
+    const uint8_t *end = block + IRIGFIX_PACKER_HEADER_BYTES + demux->payload_capacity;
+    const uint8_t *p = block + IRIGFIX_PACKER_HEADER_BYTES + payload_len;
+    int completed = 0;
+
+    while (end - p >= IRIGFIX_MUX_FRAGMENT_OVERHEAD && p[0] == IRIGFIX_MUX_FRAGMENT_MARKER) {
+        uint32_t frame_id = get_be(p + 1, 4);
+        uint32_t total = get_be(p + 5, 3);
+        uint32_t offset = get_be(p + 8, 3);
+        uint32_t len = get_be(p + 11, 2);
+        uint32_t frag_len = IRIGFIX_MUX_FRAGMENT_OVERHEAD + len;
+
+        if (frag_len > (uint32_t)(end - p) || total == 0 ||
+            total > IRIGFIX_CAMERA_MAX_FRAME_SIZE || offset + len > total ||
+            FlightLog_CRC32(0, p, frag_len - IRIGFIX_MUX_FRAGMENT_CRC_BYTES) !=
+                get_be(p + frag_len - IRIGFIX_MUX_FRAGMENT_CRC_BYTES, 4)) {
+            /* 이후 조각 경계도 믿을 수 없음 */
+            demux->fragments_bad++;
+            abandon_frame(demux);
+            break;
+        }
+        demux->fragments++;
+
+        if (offset == 0) {
+            abandon_frame(demux);
+            demux->active = true;
+            demux->frame_id = frame_id;
+            demux->total_size = total;
+            demux->received = 0;
+        } else if (!demux->active || demux->frame_id != frame_id ||
+                   demux->total_size != total || demux->received != offset) {
+            /* 앞 조각 손실 (또는 송신측이 중단한 프레임) */
+            abandon_frame(demux);
+            p += frag_len;
+            continue;
+        }
+
+        memcpy(demux->frame_buf + offset, p + IRIGFIX_MUX_FRAGMENT_HEADER_BYTES, len);
+        demux->received += len;
+
+        if (demux->received == demux->total_size) {
+            demux->active = false;
+            demux->frames_completed++;
+            completed++;
+            if (demux->on_frame) {
+                demux->on_frame(demux->context, frame_id, demux->frame_buf, total);
+            }
+        }
+        p += frag_len;
+    }
+
+    return completed;
+}
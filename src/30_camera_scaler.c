@@ -0,0 +1,368 @@
+#include "camera_scaler.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * 카메라 축소 / 관심 영역 구현
+ *
+ * 두 축소 모두 출력 한 행에 필요한 원본 행들을 열마다 세로로 합치거나
+ * 보간해 u16 한 행을 만든 뒤 (원본 행을 한 번씩 순차로 읽음) 가로로
+ * 모아 출력 화소를 낸다. 벡터는 기본 x86-64 (SSE2) 에서도 그대로
+ * 명령 하나씩으로 내려가는 16바이트 폭만 쓴다: u8 → u16 확장은 0 과
+ * 끼워 넣기, 가중치 곱은 u16 곱. 가장 흔한 가로 2배 박스는 u16 레인
+ * 안의 두 바이트를 마스크/시프트로 더해 행 버퍼 없이 레지스터에서 끝낸다.
+ * ============================================================ */
+
+typedef uint8_t v16u8 __attribute__((vector_size(16)));
+typedef uint16_t v8u16 __attribute__((vector_size(16)));
+typedef uint32_t v8u32 __attribute__((vector_size(32)));
+
+#define SCALE_LANES 16
+#define WEIGHT_ONE 256                  /* Q8 가중치 1.0 */
+
+/* 행 버퍼: 원본 한 행 + 쌍선형 오른쪽 이웃 1 + 벡터 여유 */
+#define ROW_CAPACITY (PT_CAMERA_SCALER_MAX_WIDTH + SCALE_LANES)
+
+static const v16u8 widen_lo = { 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23 };
+static const v16u8 widen_hi = { 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31 };
+
+/* 16화소 → u16 8개 × 2 */
+static inline void widen(const uint8_t *p, v8u16 *lo, v8u16 *hi)
+{
+    const v16u8 zero = {0};
+    v16u8 v;
+    memcpy(&v, p, sizeof(v));
+    *lo = (v8u16)__builtin_shuffle(v, zero, widen_lo);
+    *hi = (v8u16)__builtin_shuffle(v, zero, widen_hi);
+}
+
+CameraScaler* CameraScaler_Create(void)
+{
+    CameraScaler *scaler = malloc(sizeof(CameraScaler));
+    if (!scaler) return NULL;
+    memset(scaler, 0, sizeof(CameraScaler));
+
+    scaler->rows = aligned_alloc(32, ROW_CAPACITY * sizeof(uint16_t));
+    scaler->x_index = malloc(PT_CAMERA_SCALER_MAX_WIDTH * sizeof(uint16_t));
+    scaler->x_weight = malloc(PT_CAMERA_SCALER_MAX_WIDTH * sizeof(uint16_t));
+    if (!scaler->rows || !scaler->x_index || !scaler->x_weight) {
+        CameraScaler_Destroy(scaler);
+        return NULL;
+    }
+
+    return scaler;
+}
+
+void CameraScaler_Destroy(CameraScaler *scaler)
+{
+    if (!scaler) return;
+
+    free(scaler->rows);
+    free(scaler->x_index);
+    free(scaler->x_weight);
+    free(scaler);
+}
+
+/* ============================================================
+ * 파라미터
+ * ============================================================ */
+
+void CameraScaler_DefaultParams(CameraScaleParams *params)
+{
+    if (!params) return;
+    memset(params, 0, sizeof(CameraScaleParams));
+    params->mode = CAMERA_SCALE_BOX;
+}
+
+static uint16_t config_u16(ConfigSet *config, uint8_t param_id)
+{
+    int32_t value = TelemetryConfig_GetInt(config, param_id);
+    if (value < 0) return 0;
+    return (value > UINT16_MAX) ? UINT16_MAX : (uint16_t)value;
+}
+
+void CameraScaler_ApplyConfig(CameraScaleParams *params, ConfigSet *config)
+{
+    if (!params || !config) return;
+
+    params->out_width = config_u16(config, CAMERA_CONFIG_PARAM_OUT_WIDTH);
+    params->out_height = config_u16(config, CAMERA_CONFIG_PARAM_OUT_HEIGHT);
+    params->roi_x = config_u16(config, CAMERA_CONFIG_PARAM_ROI_X);
+    params->roi_y = config_u16(config, CAMERA_CONFIG_PARAM_ROI_Y);
+    params->roi_width = config_u16(config, CAMERA_CONFIG_PARAM_ROI_WIDTH);
+    params->roi_height = config_u16(config, CAMERA_CONFIG_PARAM_ROI_HEIGHT);
+    params->mode = (TelemetryConfig_GetInt(config, CAMERA_CONFIG_PARAM_SCALE_MODE) == CAMERA_SCALE_BILINEAR)
+                   ? CAMERA_SCALE_BILINEAR : CAMERA_SCALE_BOX;
+}
+
+/* 한 축: 시작/길이를 원본 안으로, 출력은 (0 → 길이), 확대 없음 */
+static void resolve_axis(uint16_t src, uint16_t *start, uint16_t *len, uint16_t *out,
+                         bool box)
+{
+    if (*start >= src) *start = src - 1;
+    if (*len == 0 || *len > src - *start) *len = src - *start;
+    if (*out == 0 || *out > *len) *out = *len;
+
+    /* 박스 합이 u16 을 넘지 않도록 배율 상한 */
+    uint16_t min_out = (*len + PT_CAMERA_SCALE_MAX_FACTOR - 1) / PT_CAMERA_SCALE_MAX_FACTOR;
+    if (box && *out < min_out) *out = min_out;
+}
+
+bool CameraScaler_Resolve(const CameraScaleParams *params, uint16_t src_width,
+                          uint16_t src_height, CameraScaleParams *resolved)
+{
+    if (!params || !resolved || src_width == 0 || src_height == 0) return false;
+
+    CameraScaleParams r = *params;
+    if (r.mode != CAMERA_SCALE_BILINEAR) r.mode = CAMERA_SCALE_BOX;
+
+    bool box = (r.mode == CAMERA_SCALE_BOX);
+    resolve_axis(src_width, &r.roi_x, &r.roi_width, &r.out_width, box);
+    resolve_axis(src_height, &r.roi_y, &r.roi_height, &r.out_height, box);
+
+    /* 정수 배율이 아니면 박스는 가장자리를 잘라 버리므로 쌍선형으로 */
+    if (box && (r.roi_width % r.out_width != 0 || r.roi_height % r.out_height != 0)) {
+        r.mode = CAMERA_SCALE_BILINEAR;
+    }
+    *resolved = r;
+
+    return r.out_width != src_width || r.out_height != src_height;
+}
+
+/* ============================================================
+ * ROI 자르기
+ * ============================================================ */
+
+void CameraScaler_Crop(const uint8_t *src, uint32_t stride, uint16_t width,
+                       uint16_t height, uint8_t *dst)
+{
+    if (!src || !dst) return;
+
+    for (uint16_t y = 0; y < height; y++) {
+        memcpy(dst + (size_t)y * width, src + (size_t)y * stride, width);
+    }
+}
+
+/* ============================================================
+ * 박스 축소
+ * ============================================================ */
+
+/* rows[x] = src 의 count 개 행 합 (열마다) */
+static void sum_rows(uint16_t *rows, const uint8_t *src, uint32_t stride,
+                     uint16_t width, uint16_t count)
+{
+    uint32_t x = 0;
+    for (; x + SCALE_LANES <= width; x += SCALE_LANES) {
+        v8u16 lo = {0}, hi = {0};
+        for (uint16_t r = 0; r < count; r++) {
+            v8u16 a, b;
+            widen(src + (size_t)r * stride + x, &a, &b);
+            lo += a;
+            hi += b;
+        }
+        memcpy(rows + x, &lo, sizeof(lo));
+        memcpy(rows + x + SCALE_LANES / 2, &hi, sizeof(hi));
+    }
+    for (; x < width; x++) {
+        uint16_t sum = 0;
+        for (uint16_t r = 0; r < count; r++) sum += src[(size_t)r * stride + x];
+        rows[x] = sum;
+    }
+}
+
+/* 합 × (2^16 / 면적) 반올림 → 평균 */
+static inline uint8_t box_average(uint32_t sum, uint32_t recip)
+{
+    return (uint8_t)((sum * recip + 32768) >> 16);
+}
+
+static inline v8u16 box_average_v(v8u16 sum, uint32_t recip)
+{
+    return __builtin_convertvector((__builtin_convertvector(sum, v8u32) * recip + 32768) >> 16,
+                                   v8u16);
+}
+
+/* 가로 2배: 출력 16화소 = 원본 32화소 × count 행. u16 레인의 두 바이트가
+ * 곧 가로 짝이므로 (w & 0xFF) + (w >> 8) 이 짝 합 (≤ 510 × 16 행) */
+static uint32_t box_pairs(const uint8_t *src, uint32_t stride, uint16_t count,
+                          uint8_t *dst, uint16_t out_width, uint32_t recip)
+{
+    const v16u8 even = { 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30 };
+
+    uint32_t x = 0;
+    for (; x + SCALE_LANES <= out_width; x += SCALE_LANES) {
+        v8u16 lo = {0}, hi = {0};
+        for (uint16_t r = 0; r < count; r++) {
+            const uint8_t *p = src + (size_t)r * stride + 2 * x;
+            v8u16 a, b;
+            memcpy(&a, p, sizeof(a));
+            memcpy(&b, p + sizeof(a), sizeof(b));
+            lo += (a & 0xFF) + (a >> 8);
+            hi += (b & 0xFF) + (b >> 8);
+        }
+
+        v16u8 out = __builtin_shuffle((v16u8)box_average_v(lo, recip),
+                                      (v16u8)box_average_v(hi, recip), even);
+        memcpy(dst + x, &out, sizeof(out));
+    }
+    return x;
+}
+
+bool CameraScaler_Box(CameraScaler *scaler, const uint8_t *src, uint32_t stride,
+                      uint16_t src_width, uint16_t src_height,
+                      uint8_t *dst, uint16_t out_width, uint16_t out_height)
+{
+    if (!scaler || !src || !dst || out_width == 0 || out_height == 0) return false;
+    if (src_width > PT_CAMERA_SCALER_MAX_WIDTH) return false;
+
+    /* 정수 배율만 (나머지 화소를 버리지 않음) */
+    if (src_width % out_width != 0 || src_height % out_height != 0) return false;
+
+    uint16_t fx = src_width / out_width;
+    uint16_t fy = src_height / out_height;
+    if (fx > PT_CAMERA_SCALE_MAX_FACTOR || fy > PT_CAMERA_SCALE_MAX_FACTOR) return false;
+
+    uint32_t area = (uint32_t)fx * fy;
+    uint32_t recip = (65536 + area / 2) / area;
+
+    for (uint16_t y = 0; y < out_height; y++) {
+        const uint8_t *rows = src + (size_t)y * fy * stride;
+        uint8_t *out = dst + (size_t)y * out_width;
+
+        uint32_t x = (fx == 2) ? box_pairs(rows, stride, fy, out, out_width, recip) : 0;
+        if (x == out_width) continue;
+
+        sum_rows(scaler->rows, rows + x * fx, stride, src_width - x * fx, fy);
+        for (uint32_t i = 0; x < out_width; x++, i++) {
+            const uint16_t *cols = scaler->rows + i * fx;
+            uint32_t sum = 0;
+            for (uint16_t c = 0; c < fx; c++) sum += cols[c];
+            out[x] = box_average(sum, recip);
+        }
+    }
+
+    return true;
+}
+
+/* ============================================================
+ * 쌍선형 축소
+ * ============================================================ */
+
+/* 출력 i 의 화소 중심 → 원본 좌표 (왼쪽 화소, 오른쪽 가중치 Q8) */
+static inline void map_center(uint16_t i, uint16_t src, uint16_t out,
+                              uint16_t *index, uint16_t *weight)
+{
+    float pos = ((float)i + 0.5f) * (float)src / (float)out - 0.5f;
+    if (pos < 0.0f) pos = 0.0f;
+
+    uint16_t left = (uint16_t)pos;
+    if (left >= src - 1) {
+        *index = src - 1;
+        *weight = 0;
+        return;
+    }
+    *index = left;
+    *weight = (uint16_t)((pos - (float)left) * WEIGHT_ONE + 0.5f);
+}
+
+static void build_x_table(CameraScaler *scaler, uint16_t src_width, uint16_t out_width)
+{
+    if (scaler->table_src_width == src_width && scaler->table_out_width == out_width) return;
+
+    for (uint16_t x = 0; x < out_width; x++) {
+        map_center(x, src_width, out_width, &scaler->x_index[x], &scaler->x_weight[x]);
+    }
+    scaler->table_src_width = src_width;
+    scaler->table_out_width = out_width;
+}
+
+/* rows[x] = top × (256 - w) + bottom × w  (255 × 256 < 2^16) */
+static void blend_rows(uint16_t *rows, const uint8_t *top, const uint8_t *bottom,
+                       uint16_t weight, uint16_t width)
+{
+    const v8u16 wb = (v8u16){0} + weight;
+    const v8u16 wt = (v8u16){0} + (uint16_t)(WEIGHT_ONE - weight);
+
+    uint32_t x = 0;
+    for (; x + SCALE_LANES <= width; x += SCALE_LANES) {
+        v8u16 t_lo, t_hi, b_lo, b_hi;
+        widen(top + x, &t_lo, &t_hi);
+        widen(bottom + x, &b_lo, &b_hi);
+        v8u16 lo = t_lo * wt + b_lo * wb;
+        v8u16 hi = t_hi * wt + b_hi * wb;
+        memcpy(rows + x, &lo, sizeof(lo));
+        memcpy(rows + x + SCALE_LANES / 2, &hi, sizeof(hi));
+    }
+    for (; x < width; x++) {
+        rows[x] = (uint16_t)(top[x] * (WEIGHT_ONE - weight) + bottom[x] * weight);
+    }
+
+    /* 마지막 열의 오른쪽 이웃 (가중치 0 이지만 읽음) */
+    rows[width] = rows[width - 1];
+}
+
+bool CameraScaler_Bilinear(CameraScaler *scaler, const uint8_t *src, uint32_t stride,
+                           uint16_t src_width, uint16_t src_height,
+                           uint8_t *dst, uint16_t out_width, uint16_t out_height)
+{
+    if (!scaler || !src || !dst || out_width == 0 || out_height == 0) return false;
+    if (src_width == 0 || src_height == 0 || src_width > PT_CAMERA_SCALER_MAX_WIDTH) return false;
+
+    build_x_table(scaler, src_width, out_width);
+
+    for (uint16_t y = 0; y < out_height; y++) {
+        uint16_t top, wy;
+        map_center(y, src_height, out_height, &top, &wy);
+        uint16_t bottom = (top + 1 < src_height) ? top + 1 : top;
+
+        blend_rows(scaler->rows, src + (size_t)top * stride, src + (size_t)bottom * stride,
+                   wy, src_width);
+
+        /* 가중치 합 256 × 256 → >> 16 */
+        uint8_t *out = dst + (size_t)y * out_width;
+        for (uint16_t x = 0; x < out_width; x++) {
+            const uint16_t *p = scaler->rows + scaler->x_index[x];
+            uint32_t wx = scaler->x_weight[x];
+            out[x] = (uint8_t)((p[0] * (WEIGHT_ONE - wx) + p[1] * wx + 32768) >> 16);
+        }
+    }
+
+    return true;
+}
+
+/* ============================================================
+ * 프레임 단위
+ * ============================================================ */
+
+bool CameraScaler_Process(CameraScaler *scaler, const CameraScaleParams *params,
+                          const CameraFrame *src, CameraFrame *dst)
+{
+    if (!scaler || !params || !src || !dst || !src->data || !dst->data) return false;
+    if (src->format != IRIGFIX_CAMERA_FORMAT_RAW_GRAY) return false;
+
+    CameraScaleParams r;
+    if (!CameraScaler_Resolve(params, src->width, src->height, &r)) return false;
+
+    const uint8_t *origin = src->data + (size_t)r.roi_y * src->width + r.roi_x;
+    bool ok = true;
+    if (r.out_width == r.roi_width && r.out_height == r.roi_height) {
+        CameraScaler_Crop(origin, src->width, r.roi_width, r.roi_height, dst->data);
+    } else if (r.mode == CAMERA_SCALE_BILINEAR) {
+        ok = CameraScaler_Bilinear(scaler, origin, src->width, r.roi_width, r.roi_height,
+                                   dst->data, r.out_width, r.out_height);
+    } else {
+        ok = CameraScaler_Box(scaler, origin, src->width, r.roi_width, r.roi_height,
+                              dst->data, r.out_width, r.out_height);
+    }
+    if (!ok) return false;
+
+    dst->frame_id = src->frame_id;
+    dst->timestamp_us = src->timestamp_us;
+    dst->width = r.out_width;
+    dst->height = r.out_height;
+    dst->data_size = (uint32_t)r.out_width * r.out_height;
+    dst->format = IRIGFIX_CAMERA_FORMAT_RAW_GRAY;
+    scaler->frames_scaled++;
+
+    return true;
+}
@@ -1,14 +1,249 @@
 #include "data_storage.h"
+#include "flight_log.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <sched.h>
+#include <unistd.h>
 
 /* ============================================================
  * 데이터 저장소 구현
  * ============================================================ */
 
+/* ============================================================
+ * 카메라 프레임 색인 (선형 탐사, 역방향 이동 삭제)
+ * ============================================================ */
+
+static inline uint32_t cam_home(const LogBuffer *log, uint32_t frame_id)
+{
+    /* 순차 frame_id 를 고르게 흩뜨리는 곱셈 해시 */
+    return (frame_id * 2654435761u) & log->camera_index_mask;
+}
+
+static uint32_t cam_index_find(const LogBuffer *log, uint32_t frame_id)
+{
+    uint32_t i = cam_home(log, frame_id);
+    
+    while (log->camera_index[i].slot != CAMERA_INDEX_EMPTY) {
+        if (log->camera_index[i].frame_id == frame_id) return i;
+        i = (i + 1) & log->camera_index_mask;
+    }
+    return CAMERA_INDEX_EMPTY;
+}
+
+static void cam_index_insert(LogBuffer *log, uint32_t frame_id, uint32_t slot)
+{
+    uint32_t i = cam_home(log, frame_id);
+    
+    /* 같은 frame_id 가 다시 오면 최신 슬롯을 가리킴 */
+    while (log->camera_index[i].slot != CAMERA_INDEX_EMPTY &&
+           log->camera_index[i].frame_id != frame_id) {
+        i = (i + 1) & log->camera_index_mask;
+    }
+    log->camera_index[i].frame_id = frame_id;
+    log->camera_index[i].slot = slot;
+}
+
+static void cam_index_remove(LogBuffer *log, uint32_t frame_id, uint32_t slot)
+{
+    uint32_t i = cam_index_find(log, frame_id);
+    if (i == CAMERA_INDEX_EMPTY || log->camera_index[i].slot != slot) return;
+    
+    /* 빈 칸 뒤의 항목 중 홈 위치가 빈 칸 이전인 것을 앞으로 당김 */
+    uint32_t mask = log->camera_index_mask;
+    uint32_t j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (log->camera_index[j].slot == CAMERA_INDEX_EMPTY) break;
+        
+        uint32_t k = cam_home(log, log->camera_index[j].frame_id);
+        if (((j - k) & mask) >= ((j - i) & mask)) {
+            log->camera_index[i] = log->camera_index[j];
+            i = j;
+        }
+    }
+    log->camera_index[i].slot = CAMERA_INDEX_EMPTY;
+}
+
+/* 슬롯에 카메라 데이터가 생기거나 사라질 때 색인/개수 갱신 */
+static void cam_slot_attach(LogBuffer *log, uint32_t slot)
+{
+    if (log->buffer[slot].camera_data_size == 0) return;
+    cam_index_insert(log, log->buffer[slot].camera_frame_id, slot);
+    log->camera_frame_count++;
+}
+
+static void cam_slot_detach(LogBuffer *log, uint32_t slot)
+{
+    if (log->buffer[slot].camera_data_size == 0) return;
+    cam_index_remove(log, log->buffer[slot].camera_frame_id, slot);
+    log->camera_frame_count--;
+}
+
+/* ============================================================
+ * 카메라 슬랩 풀
+ *
+ * 비행 중에는 malloc 없이 고정 아레나에서 슬랩을 꺼내 쓰고, 링 슬롯이
+ * 덮어써질 때 돌려받는다. 카메라가 예상보다 빨라 슬랩이 바닥나면 가장
+ * 오래된 카메라 프레임을 회수한다.
+ * ============================================================ */
+
+static void cam_slabs_reset(LogBuffer *log)
+{
+    for (uint32_t i = 0; i < log->camera_slab_count; i++) {
+        log->camera_free_slabs[i] = log->camera_slab_count - 1 - i;
+    }
+    log->camera_free_count = log->camera_slab_count;
+}
+
+static bool cam_in_arena(const LogBuffer *log, const uint8_t *p)
+{
+    return p >= log->camera_arena &&
+           p < log->camera_arena + (size_t)log->camera_slab_count * PT_CAMERA_FRAME_SIZE;
+}
+
+static void cam_slab_free(LogBuffer *log, uint8_t *p)
+{
+    uint32_t slab = (uint32_t)((p - log->camera_arena) / PT_CAMERA_FRAME_SIZE);
+    log->camera_free_slabs[log->camera_free_count++] = slab;
+}
+
+/* 슬롯이 소유한 카메라 데이터 반환: 아레나 슬랩 또는 풀 프레임 참조 */
+static void cam_slab_release(LogBuffer *log, uint32_t slot)
+{
+    LogEntry *entry = &log->buffer[slot];
+    
+    if (log->camera_refs[slot]) {
+        Camera_ReleaseFrame(log->camera_refs[slot]);
+        log->camera_refs[slot] = NULL;
+        entry->camera_data = NULL;
+        return;
+    }
+    if (!cam_in_arena(log, entry->camera_data)) return;
+    
+    cam_slab_free(log, entry->camera_data);
+    entry->camera_data = NULL;
+}
+
+/* 모든 슬롯의 풀 프레임 참조 반환 (로드/해제 전) */
+static void cam_refs_release(LogBuffer *log)
+{
+    for (uint32_t i = 0; i < log->buffer_capacity; i++) {
+        if (log->camera_refs[i]) {
+            Camera_ReleaseFrame(log->camera_refs[i]);
+            log->camera_refs[i] = NULL;
+            log->buffer[i].camera_data = NULL;
+            log->buffer[i].camera_data_size = 0;
+        }
+    }
+}
+
+static void cam_slot_detach(LogBuffer *log, uint32_t slot);
+
+static uint8_t* cam_slab_alloc(LogBuffer *log)
+{
+    if (log->camera_free_count == 0) {
+        /* 드문 경로: 가장 오래된 카메라 프레임 회수 */
+        uint32_t start = log->is_full ? log->write_position : 0;
+        for (uint32_t n = 0; n < log->buffer_count; n++) {
+            uint32_t slot = (start + n) % log->buffer_capacity;
+            if (slot != log->last_position && cam_in_arena(log, log->buffer[slot].camera_data)) {
+                cam_slot_detach(log, slot);
+                cam_slab_release(log, slot);
+                log->buffer[slot].camera_data_size = 0;
+                break;
+            }
+        }
+        if (log->camera_free_count == 0) return NULL;
+    }
+    
+    uint32_t slab = log->camera_free_slabs[--log->camera_free_count];
+    return log->camera_arena + (size_t)slab * PT_CAMERA_FRAME_SIZE;
+}
+
+/* LoadFromSD 처럼 버퍼를 직접 채운 뒤 색인 재구성 */
+static void cam_index_rebuild(LogBuffer *log)
+{
+    for (uint32_t i = 0; i <= log->camera_index_mask; i++) {
+        log->camera_index[i].slot = CAMERA_INDEX_EMPTY;
+    }
+    log->camera_frame_count = 0;
+    
+    uint32_t n = (log->buffer_count < log->buffer_capacity) ? log->buffer_count
+                                                             : log->buffer_capacity;
+    for (uint32_t i = 0; i < n; i++) {
+        cam_slot_attach(log, i);
+    }
+}
+
+/* ============================================================
+ * 카메라 스핀락
+ *
+ * 카메라 색인/슬랩은 WriteCameraFrame, 카메라가 있던 슬롯의 덮어쓰기,
+ * 스트리밍에서만 만지므로 경합이 드물다. 페이로드 복사는 락 밖에서 한다.
+ * ============================================================ */
+
+static inline void cam_lock(LogBuffer *log)
+{
+    while (atomic_flag_test_and_set_explicit(&log->camera_lock, memory_order_acquire)) {
+        sched_yield();
+    }
+}
+
+static inline void cam_unlock(LogBuffer *log)
+{
+    atomic_flag_clear_explicit(&log->camera_lock, memory_order_release);
+}
+
+/*
+ * 호출자가 슬롯에 붙인 카메라 버퍼를 로그 소유 슬랩으로 복사해 첨부.
+ * 빌린 포인터 (호출자 버퍼, 다른 슬롯의 슬랩/풀 프레임) 는 색인하지 않는다.
+ * 슬롯은 아직 공개 전 (예약 상태) 이어야 한다.
+ */
+static void cam_adopt(LogBuffer *log, uint32_t slot)
+{
+    LogEntry *entry = &log->buffer[slot];
+    const uint8_t *src = entry->camera_data;
+    uint32_t size = entry->camera_data_size;
+    
+    /* 슬랩 회수 탐색이 빌린 포인터를 이 슬롯 소유로 보지 않도록 먼저 비움 */
+    entry->camera_data = NULL;
+    entry->camera_data_size = 0;
+    if (size == 0) return;
+    if (!src || size > PT_CAMERA_FRAME_SIZE) {
+        log->camera_frames_dropped++;
+        return;
+    }
+    
+    cam_lock(log);
+    uint8_t *slab = cam_slab_alloc(log);
+    bool shared = cam_in_arena(log, src);
+    if (slab && shared) {
+        /* 다른 슬롯의 슬랩은 회수/교체될 수 있으므로 락 안에서 복사 */
+        memmove(slab, src, size);
+    }
+    cam_unlock(log);
+    
+    if (!slab) {
+        log->camera_frames_dropped++;
+        return;
+    }
+    
+    /* 꺼낸 슬랩은 아직 아무 엔트리에도 붙지 않았으므로 락 밖에서 복사 */
+    if (!shared) memcpy(slab, src, size);
+    
+    cam_lock(log);
+    entry->camera_data = slab;
+    entry->camera_data_size = size;
+    cam_slot_attach(log, slot);
+    cam_unlock(log);
+}
+
 LogBuffer* DataStorage_Init(uint32_t capacity)
 {
+    /* 예약은 한 바퀴 전 엔트리 + 최신 하나가 공개되길 기다리므로 슬롯 2개 이상 */
+    if (capacity < 2) return NULL;
+    
     LogBuffer *log = malloc(sizeof(LogBuffer));
     if (!log) return NULL;
     
@@ -18,10 +253,62 @@ LogBuffer* DataStorage_Init(uint32_t capacity)
         return NULL;
     }
     
+    log->slot_seq = calloc(capacity, sizeof(*log->slot_seq));
+    if (!log->slot_seq) {
+        free(log->buffer);
+        free(log);
+        return NULL;
+    }
+    
+    uint32_t index_size = 16;
+    while (index_size < capacity * 2) index_size <<= 1;
+    
+    log->camera_index = malloc(index_size * sizeof(CameraIndexEntry));
+    if (!log->camera_index) {
+        free(log->slot_seq);
+        free(log->buffer);
+        free(log);
+        return NULL;
+    }
+    log->camera_index_mask = index_size - 1;
+    for (uint32_t i = 0; i < index_size; i++) {
+        log->camera_index[i].slot = CAMERA_INDEX_EMPTY;
+    }
+    log->camera_frame_count = 0;
+    
+    log->camera_slab_count = capacity / PT_CAMERA_SLAB_ENTRY_INTERVAL + PT_CAMERA_SLAB_SPARE;
+    log->camera_arena = aligned_alloc(64, (size_t)log->camera_slab_count * PT_CAMERA_FRAME_SIZE);
+    log->camera_free_slabs = malloc(log->camera_slab_count * sizeof(uint32_t));
+    log->camera_refs = calloc(capacity, sizeof(CameraFrame *));
+    if (!log->camera_arena || !log->camera_free_slabs || !log->camera_refs) {
+        if (log->camera_arena) free(log->camera_arena);
+        if (log->camera_free_slabs) free(log->camera_free_slabs);
+        if (log->camera_refs) free(log->camera_refs);
+        free(log->camera_index);
+        free(log->slot_seq);
+        free(log->buffer);
+        free(log);
+        return NULL;
+    }
+    cam_slabs_reset(log);
+    log->camera_frames_dropped = 0;
+    
     log->buffer_count = 0;
     log->buffer_capacity = capacity;
     log->write_position = 0;
     log->is_full = false;
+    log->reserve_ticket = 0;
+    log->published = 0;
+    log->reserve_waits = 0;
+    atomic_flag_clear(&log->publish_lock);
+    atomic_flag_clear(&log->camera_lock);
+    log->writer = NULL;
+    log->stream_state = NULL;
+    log->last_position = 0;
+    log->stream_next = 0;
+    log->append_state = NULL;
+    log->pyramid = NULL;
+    log->pyramid_next = 0;
     
     return log;
 }
@@ -29,43 +316,276 @@ LogBuffer* DataStorage_Init(uint32_t capacity)
 void DataStorage_Destroy(LogBuffer *log)
 {
     if (log) {
+        DataStorage_CloseAppend(log);
+        DataStorage_DetachPyramid(log);
+        if (log->camera_refs) {
+            cam_refs_release(log);
+            free(log->camera_refs);
+        }
         if (log->buffer) free(log->buffer);
+        if (log->slot_seq) free(log->slot_seq);
+        if (log->camera_index) free(log->camera_index);
+        if (log->camera_arena) free(log->camera_arena);
+        if (log->camera_free_slabs) free(log->camera_free_slabs);
         free(log);
     }
 }
 
-void DataStorage_WriteEntry(LogBuffer *log, LogEntry *entry)
+/* 엔트리 + 카메라 데이터를 TELEMETRY/CAMERA 패킷으로 묶어 기록 스레드에 전달 */
+static void stream_entry(LogBuffer *log, const LogEntry *entry)
 {
-    if (!log || !entry) return;
+    FlightLogState *state = (FlightLogState *)log->stream_state;
+    FlightLogPacket tm, cam;
+    LogWriterSpan spans[5];
+    int n = 0;
+    
+    FlightLog_BuildTelemetry(state, &tm, entry);
+    spans[n++] = (LogWriterSpan){ tm.head, tm.head_len };
+    spans[n++] = (LogWriterSpan){ tm.tail, tm.tail_len };
+    
+    bool has_camera = entry->camera_data && entry->camera_data_size > 0;
+    if (has_camera) {
+        FlightLog_BuildCamera(state, &cam, entry->timestamp_us, entry->camera_frame_id,
+                              entry->camera_data, entry->camera_data_size);
+        spans[n++] = (LogWriterSpan){ cam.head, cam.head_len };
+        spans[n++] = (LogWriterSpan){ cam.payload, cam.payload_len };
+        spans[n++] = (LogWriterSpan){ cam.tail, cam.tail_len };
+    }
+    
+    if (LogWriter_AppendV(log->writer, spans, n)) {
+        FlightLog_Commit(state, &tm);
+        if (has_camera) FlightLog_Commit(state, &cam);
+    }
+}
+
+/* stream_next 부터 end 직전 티켓까지 내보냄 (publish_lock 보유 중) */
+static void stream_until(LogBuffer *log, uint64_t end)
+{
+    while (log->stream_next < end) {
+        uint32_t slot = (uint32_t)(log->stream_next % log->buffer_capacity);
+        
+        /* 슬랩 회수/교체와 겹치지 않도록 카메라 락 안에서 복사 */
+        cam_lock(log);
+        stream_entry(log, &log->buffer[slot]);
+        cam_unlock(log);
+        
+        log->stream_next++;
+    }
+}
+
+/* pyramid_next 부터 end 직전 티켓까지 피라미드에 더함 (publish_lock 보유 중) */
+static void pyramid_until(LogBuffer *log, uint64_t end)
+{
+    while (log->pyramid_next < end) {
+        const LogEntry *entry = &log->buffer[log->pyramid_next % log->buffer_capacity];
+        LogPyramid_Add(log->pyramid, entry->timestamp_us, &entry->telemetry);
+        log->pyramid_next++;
+    }
+}
+
+/* ============================================================
+ * 다중 생산자 예약 / 커밋
+ * ============================================================ */
+
+/* 티켓 end 직전까지 공개된 상태로 조회용 필드 갱신 */
+static void publish_to(LogBuffer *log, uint64_t end)
+{
+    uint32_t capacity = log->buffer_capacity;
+    
+    log->buffer_count = (end < capacity) ? (uint32_t)end : capacity;
+    log->write_position = (uint32_t)(end % capacity);
+    log->is_full = (end >= capacity);
+    atomic_store_explicit(&log->published, end, memory_order_release);
+}
+
+/* 연속으로 커밋된 티켓까지 공개. 락을 못 잡으면 보유자가 대신 처리 */
+static void publish(LogBuffer *log)
+{
+    uint32_t capacity = log->buffer_capacity;
     
-    if (log->buffer_count >= log->buffer_capacity) {
-        log->is_full = true;
-        log->write_position = 0;
+    for (;;) {
+        if (atomic_flag_test_and_set(&log->publish_lock)) return;
+        
+        uint64_t start = atomic_load_explicit(&log->published, memory_order_relaxed);
+        uint64_t end = start;
+        while (atomic_load_explicit(&log->slot_seq[end % capacity], memory_order_acquire) == end + 1) {
+            end++;
+        }
+        if (end != start) {
+            /* 카메라 첨부 대상을 새 최신 엔트리로 옮긴 뒤 나머지를 내보냄 */
+            cam_lock(log);
+            log->last_position = (uint32_t)((end - 1) % capacity);
+            cam_unlock(log);
+            
+            if (log->writer) stream_until(log, end - 1);
+            if (log->pyramid) pyramid_until(log, end);
+            
+            /* 내보낸 뒤에 공개해야 예약이 아직 안 나간 슬롯을 덮어쓰지 않음 */
+            publish_to(log, end);
+        }
+        
+        atomic_flag_clear(&log->publish_lock);
+        
+        /* 락을 쥔 동안 커밋되고 trylock 에 실패한 생산자가 있으면 이어서 처리 */
+        if (atomic_load(&log->slot_seq[end % capacity]) != end + 1) return;
+    }
+}
+
+/* 제어 경로 (부착/분리/플러시) 전용: 공개 락을 기다려서 잡음 */
+static void publish_lock_wait(LogBuffer *log)
+{
+    while (atomic_flag_test_and_set(&log->publish_lock)) {
+        sched_yield();
     }
+}
+
+/*
+ * 다음 슬롯을 예약해 반환. 호출자는 카메라 필드를 제외한 내용을 채운 뒤
+ * DataStorage_Commit 해야 한다 (커밋하지 않으면 이후 엔트리가 공개되지 않음).
+ * entry_id 는 티켓으로 미리 채워진다. camera_data 를 붙이면 커밋 시 로그
+ * 소유 슬랩으로 복사된다 (포인터를 그대로 보관하지 않음).
+ */
+LogEntry* DataStorage_Reserve(LogBuffer *log, LogReservation *res)
+{
+    if (!log || !res) return NULL;
     
-    memcpy(&log->buffer[log->write_position], entry, sizeof(LogEntry));
+    uint64_t ticket = atomic_fetch_add_explicit(&log->reserve_ticket, 1, memory_order_relaxed);
+    uint32_t slot = (uint32_t)(ticket % log->buffer_capacity);
+    LogEntry *entry = &log->buffer[slot];
     
-    log->write_position++;
-    if (log->write_position >= log->buffer_capacity) {
-        log->write_position = 0;
+    if (ticket >= log->buffer_capacity) {
+        /*
+         * 한 바퀴 전 엔트리가 공개되고 스트리밍 대상 (최신 제외) 이 될 때까지
+         * 대기. 생산자가 링 길이만큼 앞서거나 뒤처질 때만 발생한다.
+         */
+        uint64_t need = ticket - log->buffer_capacity + 2;
+        if (atomic_load_explicit(&log->published, memory_order_acquire) < need) {
+            log->reserve_waits++;
+            while (atomic_load_explicit(&log->published, memory_order_acquire) < need) {
+                publish(log);
+                sched_yield();
+            }
+        }
+        
+        /* WriteCameraFrame 의 첨부와 겹치지 않도록 락 안에서 확인 */
+        cam_lock(log);
+        if (entry->camera_data_size > 0) {
+            cam_slot_detach(log, slot);
+            cam_slab_release(log, slot);
+            entry->camera_data_size = 0;
+        }
+        cam_unlock(log);
     }
     
-    if (!log->is_full) {
-        log->buffer_count++;
+    entry->entry_id = (uint32_t)ticket;
+    entry->camera_frame_id = 0;
+    entry->camera_data_size = 0;
+    entry->camera_data = NULL;
+    
+    res->entry = entry;
+    res->ticket = ticket;
+    return entry;
+}
+
+void DataStorage_Commit(LogBuffer *log, LogReservation *res)
+{
+    if (!log || !res || !res->entry) return;
+    
+    uint32_t slot = (uint32_t)(res->entry - log->buffer);
+    
+    /* 호출자가 카메라 버퍼를 붙였으면 로그 소유 슬랩으로 복사해 색인에 등록 */
+    if (res->entry->camera_data_size > 0 || res->entry->camera_data) {
+        cam_adopt(log, slot);
     }
+    
+    atomic_store(&log->slot_seq[slot], res->ticket + 1);
+    res->entry = NULL;
+    
+    publish(log);
+}
+
+void DataStorage_WriteEntry(LogBuffer *log, LogEntry *entry)
+{
+    if (!log || !entry) return;
+    
+    LogReservation res;
+    LogEntry *written = DataStorage_Reserve(log, &res);
+    if (!written) return;
+    
+    /* 카메라 데이터는 커밋에서 자기 슬랩으로 복사됨 (호출자 버퍼는 바로 해제해도 됨) */
+    memcpy(written, entry, sizeof(LogEntry));
+    
+    DataStorage_Commit(log, &res);
 }
 
 void DataStorage_WriteCameraFrame(LogBuffer *log, uint32_t frame_id,
                                    uint8_t *frame_data, uint32_t size)
 {
     if (!log || !frame_data) return;
+    if (atomic_load(&log->published) == 0) return;
+    
+    if (size == 0 || size > PT_CAMERA_FRAME_SIZE) {
+        log->camera_frames_dropped++;
+        return;
+    }
+    
+    cam_lock(log);
+    uint8_t *slab = cam_slab_alloc(log);
+    cam_unlock(log);
+    
+    if (!slab) {
+        log->camera_frames_dropped++;
+        return;
+    }
+    
+    /* 꺼낸 슬랩은 아직 아무 엔트리에도 붙지 않았으므로 락 밖에서 복사 */
+    memcpy(slab, frame_data, size);
+    
+    /* 최신 공개 엔트리에 첨부 (스트리밍은 최신 엔트리를 건너뛰므로 아직 안 나감) */
+    cam_lock(log);
+    uint32_t slot = log->last_position;
+    LogEntry *current = &log->buffer[slot];
+    cam_slot_detach(log, slot);
+    cam_slab_release(log, slot);
+    
+    current->camera_frame_id = frame_id;
+    current->camera_data_size = size;
+    current->camera_data = slab;
+    cam_slot_attach(log, slot);
+    cam_unlock(log);
+}
+
+/*
+ * 풀 프레임을 복사 없이 최신 엔트리에 첨부. 로그가 참조 하나를 가지며
+ * 슬롯이 덮어써지거나 교체될 때 반환한다. 호출자의 참조는 그대로 유지.
+ */
+bool DataStorage_WriteCameraFrameRef(LogBuffer *log, CameraFrame *frame)
+{
+    if (!log || !frame || !frame->data) return false;
+    if (atomic_load(&log->published) == 0) return false;
     
-    if (log->write_position > 0) {
-        LogEntry *current = &log->buffer[log->write_position - 1];
-        current->camera_frame_id = frame_id;
-        current->camera_data_size = size;
-        current->camera_data = frame_data;
+    /* 저장/로드 경로와 같은 상한 (슬랩 크기) */
+    if (frame->data_size == 0 || frame->data_size > PT_CAMERA_FRAME_SIZE) {
+        log->camera_frames_dropped++;
+        return false;
     }
+    
+    Camera_RetainFrame(frame);
+    
+    cam_lock(log);
+    uint32_t slot = log->last_position;
+    LogEntry *current = &log->buffer[slot];
+    cam_slot_detach(log, slot);
+    cam_slab_release(log, slot);
+    
+    current->camera_frame_id = frame->frame_id;
+    current->camera_data_size = frame->data_size;
+    current->camera_data = frame->data;
+    log->camera_refs[slot] = frame;
+    cam_slot_attach(log, slot);
+    cam_unlock(log);
+    
+    return true;
 }
 
 LogEntry* DataStorage_ReadEntry(LogBuffer *log, uint32_t index)
@@ -74,17 +594,94 @@ LogEntry* DataStorage_ReadEntry(LogBuffer *log, uint32_t index)
     return &log->buffer[index];
 }
 
-uint8_t* DataStorage_ReadCameraFrame(LogBuffer *log, uint32_t frame_id)
+/* ============================================================
+ * 시간 순서 접근 / 시간 범위 질의
+ *
+ * 링이 한 바퀴 돌면 슬롯 번호는 시간 순서가 아니므로, 가장 오래된
+ * 슬롯 (is_full 이면 write_position) 기준의 순번으로 접근한다.
+ * timestamp_us 는 기록 순서대로 단조 증가한다고 가정하고 이진 탐색한다.
+ * ============================================================ */
+
+static inline uint32_t chrono_slot(const LogBuffer *log, uint32_t n)
+{
+    uint32_t start = log->is_full ? log->write_position : 0;
+    uint32_t slot = start + n;
+    return (slot >= log->buffer_capacity) ? slot - log->buffer_capacity : slot;
+}
+
+LogEntry* DataStorage_ReadEntryChrono(LogBuffer *log, uint32_t n)
 {
-    if (!log) return NULL;
+    if (!log || n >= log->buffer_count) return NULL;
+    return &log->buffer[chrono_slot(log, n)];
+}
+
+/* timestamp_us >= time_us 인 첫 엔트리의 순번 (없으면 buffer_count) */
+uint32_t DataStorage_LowerBound(LogBuffer *log, uint64_t time_us)
+{
+    if (!log) return 0;
     
-    for (uint32_t i = 0; i < log->buffer_count; i++) {
-        if (log->buffer[i].camera_frame_id == frame_id) {
-            return log->buffer[i].camera_data;
+    uint32_t lo = 0, hi = log->buffer_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (log->buffer[chrono_slot(log, mid)].timestamp_us < time_us) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
+    return lo;
+}
+
+void DataStorage_IterBegin(LogBuffer *log, LogIterator *it)
+{
+    if (!it) return;
     
-    return NULL;
+    it->log = log;
+    it->next = 0;
+    it->end = log ? log->buffer_count : 0;
+}
+
+/* [start_us, end_us) 범위 엔트리 반복자, 반환: 엔트리 수 */
+uint32_t DataStorage_QueryRange(LogBuffer *log, uint64_t start_us, uint64_t end_us,
+                                LogIterator *it)
+{
+    if (!log || !it) return 0;
+    
+    it->log = log;
+    it->next = DataStorage_LowerBound(log, start_us);
+    it->end = (end_us > start_us) ? DataStorage_LowerBound(log, end_us) : it->next;
+    
+    return it->end - it->next;
+}
+
+LogEntry* DataStorage_IterNext(LogIterator *it)
+{
+    if (!it || !it->log || it->next >= it->end) return NULL;
+    return &it->log->buffer[chrono_slot(it->log, it->next++)];
+}
+
+/*
+ * 카메라 프레임을 out 으로 복사. 슬랩 재사용 / 풀 참조 반환과 겹치지 않도록
+ * 카메라 락을 쥔 채 복사한다. 반환: 프레임 바이트 (없거나 capacity 부족이면 0)
+ */
+uint32_t DataStorage_ReadCameraFrame(LogBuffer *log, uint32_t frame_id,
+                                     uint8_t *out, uint32_t capacity)
+{
+    if (!log || !out) return 0;
+    
+    uint32_t size = 0;
+    cam_lock(log);
+    uint32_t i = cam_index_find(log, frame_id);
+    if (i != CAMERA_INDEX_EMPTY) {
+        const LogEntry *entry = &log->buffer[log->camera_index[i].slot];
+        if (entry->camera_data && entry->camera_data_size <= capacity) {
+            memcpy(out, entry->camera_data, entry->camera_data_size);
+            size = entry->camera_data_size;
+        }
+    }
+    cam_unlock(log);
+    
+    return size;
 }
 
 uint32_t DataStorage_GetEntryCount(LogBuffer *log)
@@ -96,15 +693,103 @@ uint32_t DataStorage_GetEntryCount(LogBuffer *log)
 uint32_t DataStorage_GetCameraFrameCount(LogBuffer *log)
 {
     if (!log) return 0;
+    return log->camera_frame_count;
+}
+
+bool DataStorage_AttachWriter(LogBuffer *log, LogWriter *writer)
+{
+    if (!log || !writer || log->writer) return false;
     
-    uint32_t count = 0;
-    for (uint32_t i = 0; i < log->buffer_count; i++) {
-        if (log->buffer[i].camera_data_size > 0) {
-            count++;
-        }
+    FlightLogState *state = malloc(sizeof(FlightLogState));
+    if (!state) return false;
+    FlightLogState_Init(state);
+    
+    FlightLogPacket setup;
+    FlightLog_BuildSetup(state, &setup);
+    if (!LogWriter_AppendRecord(writer, setup.head, setup.head_len,
+                                setup.tail, setup.tail_len)) {
+        free(state);
+        return false;
     }
+    FlightLog_Commit(state, &setup);
     
-    return count;
+    /* 부착 이전 엔트리는 내보내지 않음 */
+    publish_lock_wait(log);
+    log->writer = writer;
+    log->stream_state = state;
+    log->stream_next = atomic_load(&log->published);
+    atomic_flag_clear(&log->publish_lock);
+    return true;
+}
+
+void DataStorage_FlushWriter(LogBuffer *log)
+{
+    if (!log || !log->writer) return;
+    
+    /* 카메라 대기 중인 최신 엔트리까지 내보냄 */
+    publish_lock_wait(log);
+    stream_until(log, atomic_load(&log->published));
+    atomic_flag_clear(&log->publish_lock);
+    
+    LogWriter_Flush(log->writer);
+}
+
+/* 색인 + 트레일러로 파일을 마감하고 분리 (종료 경로, 블로킹 허용). 반환: 마감 기록 성공 */
+bool DataStorage_DetachWriter(LogBuffer *log)
+{
+    if (!log || !log->writer) return false;
+    
+    /* 공개 락을 쥔 채 남은 엔트리를 내보내고 분리 → 색인 뒤에 끼어드는 패킷 없음 */
+    publish_lock_wait(log);
+    stream_until(log, atomic_load(&log->published));
+    LogWriter *writer = log->writer;
+    FlightLogState *state = (FlightLogState *)log->stream_state;
+    uint64_t last_time = log->buffer_count ? log->buffer[log->last_position].timestamp_us : 0;
+    log->stream_state = NULL;
+    log->writer = NULL;
+    atomic_flag_clear(&log->publish_lock);
+    
+    FlightLogPacket index;
+    uint64_t index_offset = state->offset;
+    FlightLog_BuildIndex(state, &index, last_time);
+    
+    uint8_t trailer[IRIGFIX_FLOG_TRAILER_BYTES];
+    FlightLog_BuildTrailer(trailer, index_offset);
+    
+    /* 색인은 긴 비행에서 페이지 몇 장을 넘으므로 빈 페이지를 기다리며 나눠 기록 */
+    LogWriterSpan spans[4] = {
+        { index.head, index.head_len }, { index.payload, index.payload_len },
+        { index.tail, index.tail_len }, { trailer, sizeof(trailer) }
+    };
+    bool ok = LogWriter_AppendBlocking(writer, spans, 4);
+    
+    FlightLogState_Free(state);
+    free(state);
+    return ok;
+}
+
+bool DataStorage_AttachPyramid(LogBuffer *log, LogPyramid *pyramid)
+{
+    if (!log || !pyramid || log->pyramid) return false;
+    
+    /* 부착 이후 공개되는 엔트리부터 반영 */
+    publish_lock_wait(log);
+    log->pyramid = pyramid;
+    log->pyramid_next = atomic_load(&log->published);
+    atomic_flag_clear(&log->publish_lock);
+    return true;
+}
+
+/* 남은 엔트리와 부분 버킷까지 내보내고 분리 (피라미드 해제는 호출자) */
+void DataStorage_DetachPyramid(LogBuffer *log)
+{
+    if (!log || !log->pyramid) return;
+    
+    publish_lock_wait(log);
+    pyramid_until(log, atomic_load(&log->published));
+    LogPyramid_Finish(log->pyramid);
+    log->pyramid = NULL;
+    atomic_flag_clear(&log->publish_lock);
 }
 
 bool DataStorage_SaveToSD(LogBuffer *log, const char *filename)
@@ -114,22 +799,332 @@ bool DataStorage_SaveToSD(LogBuffer *log, const char *filename)
     FILE *file = fopen(filename, "wb");
     if (!file) return false;
     
-    uint32_t magic = IRIGFIX_LOG_MAGIC;
-    fwrite(&magic, sizeof(uint32_t), 1, file);
+    FlightLogState state;
+    FlightLogState_Init(&state);
+    
+    FlightLogPacket pkt;
+    FlightLog_BuildSetup(&state, &pkt);
+    bool ok = FlightLog_WritePacket(file, &state, &pkt);
     
-    uint32_t count = log->buffer_count;
-    fwrite(&count, sizeof(uint32_t), 1, file);
+    /* 링 버퍼를 시간 순서로 기록 */
+    uint64_t last_time = 0;
     
-    for (uint32_t i = 0; i < count; i++) {
-        fwrite(&log->buffer[i], sizeof(LogEntry), 1, file);
+    for (uint32_t i = 0; ok && i < log->buffer_count; i++) {
+        const LogEntry *entry = &log->buffer[chrono_slot(log, i)];
+        
+        FlightLog_BuildTelemetry(&state, &pkt, entry);
+        ok = FlightLog_WritePacket(file, &state, &pkt);
         
-        if (log->buffer[i].camera_data && log->buffer[i].camera_data_size > 0) {
-            fwrite(log->buffer[i].camera_data, 
-                   log->buffer[i].camera_data_size, 1, file);
+        if (ok && entry->camera_data && entry->camera_data_size > 0) {
+            FlightLog_BuildCamera(&state, &pkt, entry->timestamp_us, entry->camera_frame_id,
+                                  entry->camera_data, entry->camera_data_size);
+            ok = FlightLog_WritePacket(file, &state, &pkt);
         }
+        last_time = entry->timestamp_us;
     }
     
-    fclose(file);
+    if (ok) {
+        uint64_t index_offset = state.offset;
+        uint8_t trailer[IRIGFIX_FLOG_TRAILER_BYTES];
+        
+        FlightLog_BuildIndex(&state, &pkt, last_time);
+        ok = FlightLog_WritePacket(file, &state, &pkt);
+        
+        FlightLog_BuildTrailer(trailer, index_offset);
+        ok = ok && fwrite(trailer, 1, sizeof(trailer), file) == sizeof(trailer);
+    }
+    
+    FlightLogState_Free(&state);
+    if (fclose(file) != 0) ok = false;
+    return ok;
+}
+
+/* ============================================================
+ * 증분 저장 (추가 전용)
+ *
+ * 첫 호출에서 파일을 만들고 SETUP 을 쓴 뒤 열어 둔다. 이후 호출은
+ * 워터마크 (다음에 저장할 티켓) 이후의 엔트리/카메라 데이터만 덧붙이고
+ * COMMIT 패킷 + fdatasync 로 마무리하므로 비용이 새 데이터에 비례한다.
+ * 쓰기에 실패하면 직전 COMMIT 끝으로 파일을 잘라 다음 저장이 깨진
+ * 패킷 뒤에 붙지 않게 한다. 최신 엔트리는 카메라 첨부를 기다리므로
+ * 다음 저장으로 넘긴다.
+ * ============================================================ */
+
+typedef struct {
+    FILE *file;                         /* NULL: 되돌리기 실패, 다음 호출에서 재시도 */
+    char *filename;
+    FlightLogState state;
+    uint64_t next;                      /* 영속 워터마크: 다음에 저장할 티켓 */
+    uint64_t last_time;
+    uint8_t *camera_copy;               /* 카메라 락 밖에서 쓰기 위한 복사본 */
+} AppendState;
+
+static void append_free(AppendState *app)
+{
+    if (app->file) fclose(app->file);
+    if (app->filename) free(app->filename);
+    if (app->camera_copy) free(app->camera_copy);
+    FlightLogState_Free(&app->state);
+    free(app);
+}
+
+static AppendState* append_open(LogBuffer *log, const char *filename)
+{
+    AppendState *app = calloc(1, sizeof(AppendState));
+    if (!app) return NULL;
+    FlightLogState_Init(&app->state);
+    
+    app->filename = malloc(strlen(filename) + 1);
+    app->camera_copy = malloc(PT_CAMERA_FRAME_SIZE);
+    app->file = fopen(filename, "wb");
+    if (!app->filename || !app->camera_copy || !app->file) {
+        append_free(app);
+        return NULL;
+    }
+    strcpy(app->filename, filename);
+    
+    FlightLogPacket setup;
+    FlightLog_BuildSetup(&app->state, &setup);
+    if (!FlightLog_WritePacket(app->file, &app->state, &setup)) {
+        append_free(app);
+        return NULL;
+    }
+    
+    /* 링에 남아 있는 가장 오래된 엔트리부터 */
+    uint64_t published = atomic_load(&log->published);
+    app->next = (published > log->buffer_capacity) ? published - log->buffer_capacity : 0;
+    return app;
+}
+
+/* 직전 COMMIT 끝 (state.offset) 으로 파일을 자르고 다시 엶 */
+static bool append_rollback(AppendState *app)
+{
+    if (app->file) fclose(app->file);    /* 쓰지 못한 버퍼는 버림 */
+    
+    app->file = fopen(app->filename, "r+b");
+    if (!app->file) return false;
+    
+    if (ftruncate(fileno(app->file), (off_t)app->state.offset) != 0 ||
+        fseek(app->file, (long)app->state.offset, SEEK_SET) != 0) {
+        fclose(app->file);
+        app->file = NULL;
+        return false;
+    }
+    return true;
+}
+
+/* 워터마크부터 end 직전 티켓까지 덧붙이고 COMMIT */
+static bool append_save(LogBuffer *log, AppendState *app, uint64_t end)
+{
+    if (!app->file && !append_rollback(app)) return false;
+    
+    uint32_t capacity = log->buffer_capacity;
+    uint64_t published = atomic_load(&log->published);
+    uint64_t oldest = (published > capacity) ? published - capacity : 0;
+    if (app->next < oldest) app->next = oldest;     /* 저장 전에 덮어써진 엔트리 */
+    
+    /* 실패 시 되돌릴 직전 COMMIT 상태 */
+    uint64_t saved_offset = app->state.offset;
+    uint32_t saved_packets = app->state.telemetry_packets;
+    uint32_t saved_index = app->state.index_count;
+    uint8_t saved_sequence[IRIGFIX_FLOG_NUM_CHANNELS];
+    memcpy(saved_sequence, app->state.sequence, sizeof(saved_sequence));
+    
+    bool ok = true;
+    uint64_t t;
+    for (t = app->next; ok && t < end; t++) {
+        uint32_t slot = (uint32_t)(t % capacity);
+        LogEntry entry;
+        uint32_t camera_size = 0;
+        
+        /* 슬랩 회수/교체와 겹치지 않도록 복사만 락 안에서 */
+        cam_lock(log);
+        memcpy(&entry, &log->buffer[slot], sizeof(LogEntry));
+        if (entry.camera_data && entry.camera_data_size > 0 &&
+            entry.camera_data_size <= PT_CAMERA_FRAME_SIZE) {
+            memcpy(app->camera_copy, entry.camera_data, entry.camera_data_size);
+            camera_size = entry.camera_data_size;
+        }
+        cam_unlock(log);
+        
+        FlightLogPacket pkt;
+        FlightLog_BuildTelemetry(&app->state, &pkt, &entry);
+        ok = FlightLog_WritePacket(app->file, &app->state, &pkt);
+        
+        if (ok && camera_size > 0) {
+            FlightLog_BuildCamera(&app->state, &pkt, entry.timestamp_us, entry.camera_frame_id,
+                                  app->camera_copy, camera_size);
+            ok = FlightLog_WritePacket(app->file, &app->state, &pkt);
+        }
+        app->last_time = entry.timestamp_us;
+    }
+    
+    if (ok) {
+        FlightLogPacket commit;
+        FlightLog_BuildCommit(&app->state, &commit, app->last_time);
+        ok = FlightLog_WritePacket(app->file, &app->state, &commit);
+    }
+    ok = ok && fflush(app->file) == 0 && fdatasync(fileno(app->file)) == 0;
+    
+    if (ok) {
+        app->next = t;
+        return true;
+    }
+    
+    app->state.offset = saved_offset;
+    app->state.telemetry_packets = saved_packets;
+    app->state.index_count = saved_index;
+    memcpy(app->state.sequence, saved_sequence, sizeof(saved_sequence));
+    append_rollback(app);
+    return false;
+}
+
+bool DataStorage_AppendToSD(LogBuffer *log, const char *filename)
+{
+    if (!log || !filename) return false;
+    
+    AppendState *app = (AppendState *)log->append_state;
+    if (app && strcmp(app->filename, filename) != 0) {
+        DataStorage_CloseAppend(log);
+        app = NULL;
+    }
+    if (!app) {
+        app = append_open(log, filename);
+        if (!app) return false;
+        log->append_state = app;
+    }
+    
+    uint64_t published = atomic_load(&log->published);
+    return append_save(log, app, (published > 0) ? published - 1 : 0);
+}
+
+/* 최신 엔트리까지 저장한 뒤 색인 + 트레일러로 마감하고 닫음 */
+bool DataStorage_CloseAppend(LogBuffer *log)
+{
+    if (!log || !log->append_state) return false;
+    
+    AppendState *app = (AppendState *)log->append_state;
+    bool saved = append_save(log, app, atomic_load(&log->published));
+    bool ok = false;
+    
+    /* 마지막 저장이 되돌려졌어도 직전 COMMIT 까지의 색인은 유효 */
+    if (app->file) {
+        uint64_t index_offset = app->state.offset;
+        FlightLogPacket index;
+        FlightLog_BuildIndex(&app->state, &index, app->last_time);
+        
+        ok = FlightLog_WritePacket(app->file, &app->state, &index);
+        if (ok) {
+            uint8_t trailer[IRIGFIX_FLOG_TRAILER_BYTES];
+            FlightLog_BuildTrailer(trailer, index_offset);
+            ok = fwrite(trailer, 1, sizeof(trailer), app->file) == sizeof(trailer);
+        }
+        ok = (fflush(app->file) == 0) && ok;
+        ok = ok && fdatasync(fileno(app->file)) == 0;
+    }
+    
+    append_free(app);
+    log->append_state = NULL;
+    return saved && ok;
+}
+
+/* 비행 로그 컨테이너 형식: 기록이 끊긴 파일도 마지막 유효 패킷까지 복구 */
+/* 로드 전 링/색인/슬랩 초기화 (이전 내용의 슬랩은 모두 반환) */
+static void reset_for_load(LogBuffer *log)
+{
+    /* 증분 저장 워터마크는 이전 내용 기준이므로 세션을 마감 */
+    DataStorage_CloseAppend(log);
+    
+    log->buffer_count = 0;
+    log->write_position = 0;
+    log->last_position = 0;
+    log->is_full = false;
+    log->reserve_ticket = 0;
+    log->published = 0;
+    log->stream_next = 0;
+    log->pyramid_next = 0;
+    for (uint32_t i = 0; i < log->buffer_capacity; i++) {
+        log->slot_seq[i] = 0;
+    }
+    cam_refs_release(log);
+    cam_slabs_reset(log);
+    cam_index_rebuild(log);
+}
+
+/* 로드 (단일 스레드): buffer_count 슬롯에 채운 엔트리를 바로 커밋/공개 */
+static void load_publish(LogBuffer *log)
+{
+    uint64_t ticket = log->reserve_ticket;
+    
+    log->slot_seq[ticket % log->buffer_capacity] = ticket + 1;
+    log->reserve_ticket = ticket + 1;
+    log->stream_next = ticket + 1;
+    log->pyramid_next = ticket + 1;     /* 로드된 엔트리는 피라미드에 넣지 않음 */
+    log->last_position = (uint32_t)(ticket % log->buffer_capacity);
+    publish_to(log, ticket + 1);
+}
+
+/* 로드된 카메라 데이터를 슬랩으로 복사 (슬랩 부족 시 가장 오래된 것 회수) */
+static bool load_camera(LogBuffer *log, uint32_t slot, const uint8_t *data,
+                        uint32_t size, FILE *file)
+{
+    LogEntry *entry = &log->buffer[slot];
+    uint8_t *slab = (size <= PT_CAMERA_FRAME_SIZE) ? cam_slab_alloc(log) : NULL;
+    
+    entry->camera_data = NULL;
+    entry->camera_data_size = 0;
+    
+    if (!slab) {
+        log->camera_frames_dropped++;
+        if (file) fseek(file, size, SEEK_CUR);
+        return false;
+    }
+    
+    /*  fread 반환값 확인 */
+    if (data) {
+        memcpy(slab, data, size);
+    } else if (fread(slab, size, 1, file) != 1) {
+        cam_slab_free(log, slab);
+        return false;
+    }
+    
+    entry->camera_data = slab;
+    entry->camera_data_size = size;
+    cam_slot_attach(log, slot);
+    return true;
+}
+
+static bool load_flight_log(LogBuffer *log, const char *filename)
+{
+    FlightLogReader *reader = FlightLogReader_Open(filename);
+    if (!reader) return false;
+    
+    reset_for_load(log);
+    
+    FlightLogPacketHeader hdr;
+    const uint8_t *body;
+    
+    while (log->buffer_count < log->buffer_capacity &&
+           FlightLogReader_Next(reader, &hdr, &body)) {
+        if (hdr.channel_id == IRIGFIX_FLOG_CHANNEL_TELEMETRY) {
+            LogEntry *entry = &log->buffer[log->buffer_count];
+            if (FlightLog_DecodeTelemetry(&hdr, body, entry)) {
+                entry->camera_data_size = 0;
+                load_publish(log);
+            }
+        } else if (hdr.channel_id == IRIGFIX_FLOG_CHANNEL_CAMERA && log->buffer_count > 0) {
+            LogEntry *entry = &log->buffer[log->last_position];
+            uint32_t frame_id, size;
+            const uint8_t *data;
+            
+            if (FlightLog_DecodeCamera(&hdr, body, &frame_id, &data, &size) &&
+                frame_id == entry->camera_frame_id && !entry->camera_data) {
+                load_camera(log, log->last_position, data, size, NULL);
+            }
+        }
+    }
+    
+    FlightLogReader_Close(reader);
     return true;
 }
 
@@ -149,9 +1144,10 @@ bool DataStorage_LoadFromSD(LogBuffer *log, const char *filename)
     
     if (magic != IRIGFIX_LOG_MAGIC) {
         fclose(file);
-        return false;
+        return load_flight_log(log, filename);
     }
     
+    /* 구 형식: 매직 + 개수 + LogEntry 원본 */
     uint32_t count;
     /*  fread 반환값 확인 */
     if (fread(&count, sizeof(uint32_t), 1, file) != 1) {
@@ -159,27 +1155,26 @@ bool DataStorage_LoadFromSD(LogBuffer *log, const char *filename)
         return false;
     }
     
+    reset_for_load(log);
+    
     for (uint32_t i = 0; i < count && i < log->buffer_capacity; i++) {
         /*  fread 반환값 확인 */
         if (fread(&log->buffer[i], sizeof(LogEntry), 1, file) != 1) {
             fclose(file);
             return false;
         }
+        load_publish(log);
         
-        if (log->buffer[i].camera_data_size > 0) {
-            log->buffer[i].camera_data = malloc(log->buffer[i].camera_data_size);
-            if (log->buffer[i].camera_data) {
-                /*  fread 반환값 확인 */
-                if (fread(log->buffer[i].camera_data, 
-                          log->buffer[i].camera_data_size, 1, file) != 1) {
-                    free(log->buffer[i].camera_data);
-                    log->buffer[i].camera_data = NULL;
-                }
-            }
+        /* 파일에 저장된 포인터 값은 무의미 */
+        uint32_t size = log->buffer[i].camera_data_size;
+        log->buffer[i].camera_data = NULL;
+        log->buffer[i].camera_data_size = 0;
+        
+        if (size > 0) {
+            load_camera(log, i, NULL, size, file);
         }
     }
     
-    log->buffer_count = count;
     fclose(file);
     return true;
 }
@@ -1,11 +1,126 @@
 #include "camera_interface.h"
 #include <stdlib.h>
 #include <string.h>
+#include <sched.h>
 
 /* ============================================================
  * 카메라 인터페이스 구현
  * ============================================================ */
 
+_Static_assert(PT_CAMERA_RESOLUTION_WIDTH * PT_CAMERA_RESOLUTION_HEIGHT <= IRIGFIX_CAMERA_MAX_FRAME_SIZE,
+               "raw frame must fit in a pool buffer");
+
+/* ============================================================
+ * 프레임 풀
+ * ============================================================ */
+
+static inline void pool_lock(CameraFramePool *pool)
+{
+    while (atomic_flag_test_and_set_explicit(&pool->lock, memory_order_acquire)) {
+        sched_yield();
+    }
+}
+
+static inline void pool_unlock(CameraFramePool *pool)
+{
+    atomic_flag_clear_explicit(&pool->lock, memory_order_release);
+}
+
+static void pool_free(CameraFramePool *pool)
+{
+    if (pool->frames) free(pool->frames);
+    if (pool->buffers) free(pool->buffers);
+    if (pool->free_stack) free(pool->free_stack);
+    free(pool);
+}
+
+/* 소유자 또는 반환된 프레임의 참조 해제, 마지막이면 풀 해제 */
+static void pool_unref(CameraFramePool *pool)
+{
+    if (atomic_fetch_sub_explicit(&pool->refs, 1, memory_order_acq_rel) == 1) {
+        pool_free(pool);
+    }
+}
+
+CameraFramePool* CameraFramePool_Create(uint32_t frame_count)
+{
+    if (frame_count == 0) return NULL;
+    
+    CameraFramePool *pool = malloc(sizeof(CameraFramePool));
+    if (!pool) return NULL;
+    memset(pool, 0, sizeof(CameraFramePool));
+    
+    pool->frames = calloc(frame_count, sizeof(CameraFrame));
+    pool->buffers = aligned_alloc(64, (size_t)frame_count * IRIGFIX_CAMERA_MAX_FRAME_SIZE);
+    pool->free_stack = malloc(frame_count * sizeof(uint32_t));
+    if (!pool->frames || !pool->buffers || !pool->free_stack) {
+        pool_free(pool);
+        return NULL;
+    }
+    
+    pool->frame_count = frame_count;
+    for (uint32_t i = 0; i < frame_count; i++) {
+        CameraFrame *frame = &pool->frames[i];
+        frame->data = pool->buffers + (size_t)i * IRIGFIX_CAMERA_MAX_FRAME_SIZE;
+        frame->pool = pool;
+        frame->pool_index = i;
+        frame->refcount = 0;
+        pool->free_stack[i] = frame_count - 1 - i;
+    }
+    pool->free_count = frame_count;
+    atomic_flag_clear(&pool->lock);
+    pool->refs = 1;
+    pool->exhausted = 0;
+    
+    return pool;
+}
+
+void CameraFramePool_Destroy(CameraFramePool *pool)
+{
+    if (pool) pool_unref(pool);
+}
+
+/* 빈 프레임 하나 (참조 1). 없으면 NULL */
+CameraFrame* CameraFramePool_Acquire(CameraFramePool *pool)
+{
+    if (!pool) return NULL;
+    
+    pool_lock(pool);
+    if (pool->free_count == 0) {
+        pool_unlock(pool);
+        pool->exhausted++;
+        return NULL;
+    }
+    uint32_t index = pool->free_stack[--pool->free_count];
+    pool_unlock(pool);
+    
+    CameraFrame *frame = &pool->frames[index];
+    atomic_store_explicit(&frame->refcount, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&pool->refs, 1, memory_order_relaxed);
+    
+    frame->frame_id = 0;
+    frame->timestamp_us = 0;
+    frame->width = 0;
+    frame->height = 0;
+    frame->data_size = 0;
+    frame->format = IRIGFIX_CAMERA_FORMAT_RAW_GRAY;
+    return frame;
+}
+
+uint32_t CameraFramePool_GetFreeCount(CameraFramePool *pool)
+{
+    if (!pool) return 0;
+    
+    pool_lock(pool);
+    uint32_t count = pool->free_count;
+    pool_unlock(pool);
+    return count;
+}
+
+/* ============================================================
+ * 장치
+ * ============================================================ */
+
 CameraDevice* Camera_Init(void)
 {
     CameraDevice *cam = malloc(sizeof(CameraDevice));
@@ -14,13 +129,24 @@ CameraDevice* Camera_Init(void)
     cam->camera_handle = NULL;
     cam->current_frame_id = 0;
     cam->is_streaming = false;
+    cam->frames_dropped = 0;
+    cam->source.read = PT_CAMERA_SYNTHETIC_SOURCE ? Camera_SyntheticSource : NULL;
+    cam->source.context = NULL;
+    
+    cam->pool = CameraFramePool_Create(PT_CAMERA_POOL_FRAMES);
+    if (!cam->pool) {
+        free(cam);
+        return NULL;
+    }
     
     return cam;
 }
 
+/* 나가 있는 프레임은 각 소유자가 Release 할 때 풀로 돌아간 뒤 해제됨 */
 void Camera_Destroy(CameraDevice *cam)
 {
     if (cam) {
+        CameraFramePool_Destroy(cam->pool);
         free(cam);
     }
 }
@@ -44,26 +170,103 @@ bool Camera_Stop(CameraDevice *cam)
     return true;
 }
 
+void Camera_SetSource(CameraDevice *cam, CameraSourceFn read, void *context)
+{
+    if (!cam) return;
+    
+    cam->source.read = read;
+    cam->source.context = context;
+}
+
+/* ============================================================
+ * 합성 패턴 원천
+ *
+ * 완만한 배경 음영 + 프레임마다 4화소씩 움직이는 밝은 세로 막대 +
+ * 가로로 움직이는 8화소 체커 표적 + 맨 위 8행의 frame_id 32비트 띠.
+ * 정수 연산만 쓰므로 같은 frame_id 는 항상 같은 영상이 된다.
+ * ============================================================ */
+
+bool Camera_SyntheticSource(void *context, uint32_t frame_id,
+                            uint8_t *pixels, uint16_t width, uint16_t height)
+{
+    (void)context;
+    if (!pixels || width == 0 || height == 0) return false;
+    
+    uint32_t bar_x = (frame_id * 4) % width;
+    uint32_t target_size = (height / 4) & ~7u;
+    if (target_size > width) target_size = 0;
+    uint32_t target_x = (frame_id * 2) % (width - target_size + 1);
+    uint32_t target_y = (height - target_size) / 2;
+    uint32_t bit_width = width / 32;
+    
+    for (uint32_t y = 0; y < height; y++) {
+        uint8_t *row = pixels + (size_t)y * width;
+        for (uint32_t x = 0; x < width; x++) {
+            uint32_t v = 48 + (x * 96) / width + (y * 64) / height;
+            
+            if (x - bar_x < 16) v = 230;
+            if (x - target_x < target_size && y - target_y < target_size) {
+                v = (((x - target_x) >> 3) ^ ((y - target_y) >> 3)) & 1 ? 240 : 16;
+            }
+            if (y < 8 && bit_width > 0 && x / bit_width < 32) {
+                v = (frame_id >> (31 - x / bit_width)) & 1 ? 255 : 0;
+            }
+            row[x] = (uint8_t)v;
+        }
+    }
+    return true;
+}
+
 CameraFrame* Camera_CaptureFrame(CameraDevice *cam)
 {
     if (!cam || !cam->is_streaming) return NULL;
     
-    CameraFrame *frame = malloc(sizeof(CameraFrame));
-    if (!frame) return NULL;
+    CameraFrame *frame = CameraFramePool_Acquire(cam->pool);
+    if (!frame) {
+        cam->frames_dropped++;
+        return NULL;
+    }
     
     frame->frame_id = cam->current_frame_id++;
     frame->width = PT_CAMERA_RESOLUTION_WIDTH;
     frame->height = PT_CAMERA_RESOLUTION_HEIGHT;
     frame->data_size = 0;
-    frame->data = NULL;
+    
+    if (cam->source.read) {
+        if (!cam->source.read(cam->source.context, frame->frame_id,
+                              frame->data, frame->width, frame->height)) {
+            Camera_ReleaseFrame(frame);
+            cam->frames_dropped++;
+            return NULL;
+        }
+        frame->data_size = (uint32_t)frame->width * frame->height;
+        frame->format = IRIGFIX_CAMERA_FORMAT_RAW_GRAY;
+    }
     
     return frame;
 }
 
+/* 다른 소비자에게 넘기기 전에 참조 추가 (복사 없음) */
+void Camera_RetainFrame(CameraFrame *frame)
+{
+    if (frame) atomic_fetch_add_explicit(&frame->refcount, 1, memory_order_relaxed);
+}
+
 void Camera_ReleaseFrame(CameraFrame *frame)
 {
-    if (frame) {
+    if (!frame) return;
+    if (atomic_fetch_sub_explicit(&frame->refcount, 1, memory_order_acq_rel) != 1) return;
+    
+    CameraFramePool *pool = frame->pool;
+    if (!pool) {
+        /* 풀 밖에서 만든 프레임 */
         if (frame->data) free(frame->data);
         free(frame);
+        return;
     }
+    
+    pool_lock(pool);
+    pool->free_stack[pool->free_count++] = frame->pool_index;
+    pool_unlock(pool);
+    pool_unref(pool);
 }
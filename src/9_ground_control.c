@@ -55,6 +55,13 @@ bool GroundControl_ProcessCommand(GroundControlCommand *cmd,
         return false;
     }
     
+    return GroundControl_ApplyCommand(cmd, state);
+}
+
+bool GroundControl_ApplyCommand(const GroundControlCommand *cmd, ControlState *state)
+{
+    if (!cmd || !state) return false;
+    
     switch (cmd->cmd_type) {
         case CMD_THRUST_UPDATE:
             if (cmd->payload.thrust.thrust_percent >= PT_THRUST_MIN &&
@@ -161,3 +168,241 @@ void GroundControl_CheckTimeout(ControlState *state)
         GroundControl_SetThrust(PT_THRUST_MIN);
     }
 }
+
+/* ============================================================
+ * 상향 링크 프레임
+ * ============================================================ */
+
+static inline uint16_t get_le16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+#define WIRE_TYPE 2
+#define WIRE_ID 3
+#define WIRE_TIMESTAMP 5
+#define WIRE_PAYLOAD 9
+#define WIRE_CRC (WIRE_PAYLOAD + IRIGFIX_COMMAND_WIRE_PAYLOAD)
+
+_Static_assert(WIRE_CRC + 2 == IRIGFIX_COMMAND_WIRE_SIZE, "command wire layout");
+_Static_assert(sizeof(((GroundControlCommand *)0)->payload) == IRIGFIX_COMMAND_WIRE_PAYLOAD,
+               "payload union must match wire payload");
+
+uint16_t GroundControl_CRC16(const uint8_t *data, uint32_t len)
+{
+    if (!data) return 0;
+    
+    uint16_t crc = 0;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++) {
+            crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+    }
+    
+    return crc;
+}
+
+void GroundControl_EncodeCommand(const GroundControlCommand *cmd,
+                                 uint8_t out[IRIGFIX_COMMAND_WIRE_SIZE])
+{
+    if (!cmd || !out) return;
+    
+    put_le16(out, IRIGFIX_COMMAND_HEADER);
+    out[WIRE_TYPE] = (uint8_t)cmd->cmd_type;
+    put_le16(out + WIRE_ID, cmd->cmd_id);
+    put_le32(out + WIRE_TIMESTAMP, cmd->timestamp);
+    
+    /* 페이로드 공용체 12바이트 전체를 32비트 워드 3개로 (명령마다 앞쪽만 의미 있음) */
+    uint32_t words[IRIGFIX_COMMAND_WIRE_PAYLOAD / 4];
+    memcpy(words, &cmd->payload, sizeof(words));
+    for (int i = 0; i < IRIGFIX_COMMAND_WIRE_PAYLOAD / 4; i++) {
+        put_le32(out + WIRE_PAYLOAD + i * 4, words[i]);
+    }
+    
+    put_le16(out + WIRE_CRC, GroundControl_CRC16(out, WIRE_CRC));
+}
+
+static bool is_known_type(uint8_t type)
+{
+    switch (type) {
+        case CMD_THRUST_UPDATE:
+        case CMD_RUDDER_UPDATE:
+        case CMD_ELEVON_UPDATE:
+        case CMD_TRAJECTORY_CHANGE:
+        case CMD_SPEED_INCREASE:
+        case CMD_SPEED_DECREASE:
+        case CMD_QUERY_STATUS:
+        case CMD_REQUEST_CAMERA:
+        case CMD_EMERGENCY_STOP:
+        case CMD_SELF_DESTRUCT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* ============================================================
+ * 스트림 역프레이머
+ * ============================================================ */
+
+CommandDeframer* CommandDeframer_Create(GroundCommandFn on_command, void *context)
+{
+    CommandDeframer *deframer = malloc(sizeof(CommandDeframer));
+    if (!deframer) return NULL;
+    memset(deframer, 0, sizeof(CommandDeframer));
+    
+    deframer->on_command = on_command;
+    deframer->context = context;
+    
+    /* 바이트 단위 표 (GroundControl_CRC16 과 같은 결과) */
+    for (int i = 0; i < 256; i++) {
+        uint16_t crc = (uint16_t)i;
+        for (int j = 0; j < 8; j++) {
+            crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+        deframer->crc_table[i] = crc;
+    }
+    
+    return deframer;
+}
+
+void CommandDeframer_Destroy(CommandDeframer *deframer)
+{
+    if (deframer) free(deframer);
+}
+
+void CommandDeframer_Reset(CommandDeframer *deframer)
+{
+    if (!deframer) return;
+    deframer->carry_len = 0;
+}
+
+/* p 에서 시작하는 완전한 프레임 하나 검증 후 해석 */
+static bool parse_frame(CommandDeframer *deframer, const uint8_t *p)
+{
+    if (get_le16(p) != IRIGFIX_COMMAND_HEADER) return false;
+    
+    uint16_t crc = 0;
+    for (int i = 0; i < WIRE_CRC; i++) {
+        crc = (crc >> 8) ^ deframer->crc_table[(crc ^ p[i]) & 0xFF];
+    }
+    if (crc != get_le16(p + WIRE_CRC)) {
+        deframer->crc_errors++;
+        return false;
+    }
+    if (!is_known_type(p[WIRE_TYPE])) {
+        deframer->type_errors++;
+        return false;
+    }
+    
+    GroundControlCommand cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.header = IRIGFIX_COMMAND_HEADER;
+    cmd.cmd_type = (CommandType)p[WIRE_TYPE];
+    cmd.cmd_id = get_le16(p + WIRE_ID);
+    cmd.timestamp = get_le32(p + WIRE_TIMESTAMP);
+    
+    uint32_t words[IRIGFIX_COMMAND_WIRE_PAYLOAD / 4];
+    for (int i = 0; i < IRIGFIX_COMMAND_WIRE_PAYLOAD / 4; i++) {
+        words[i] = get_le32(p + WIRE_PAYLOAD + i * 4);
+    }
+    memcpy(&cmd.payload, words, sizeof(words));
+    cmd.checksum = crc;
+    
+    deframer->commands++;
+    if (deframer->on_command) deframer->on_command(deframer->context, &cmd);
+    return true;
+}
+
+/* buf[start, limit) 에서 프레임 시작을 찾아 처리 (프레임은 len 까지 읽을 수 있음).
+ * 반환: 다음에 볼 위치. limit 보다 작으면 그 자리의 프레임이 len 을 넘어 아직 불완전 */
+static uint32_t scan(CommandDeframer *deframer, const uint8_t *buf, uint32_t len,
+                     uint32_t start, uint32_t limit, int *emitted)
+{
+    uint32_t i = start;
+    
+    while (i < limit) {
+        const uint8_t *p = memchr(buf + i, IRIGFIX_COMMAND_HEADER & 0xFF, limit - i);
+        if (!p) {
+            deframer->bytes_skipped += limit - i;
+            return limit;
+        }
+        
+        uint32_t at = (uint32_t)(p - buf);
+        deframer->bytes_skipped += at - i;
+        i = at;
+        
+        if (len - i < IRIGFIX_COMMAND_WIRE_SIZE) return i;
+        
+        if (parse_frame(deframer, p)) {
+            (*emitted)++;
+            i += IRIGFIX_COMMAND_WIRE_SIZE;
+        } else {
+            /* 재동기: 헤더 첫 바이트 다음부터 다시 찾음 */
+            deframer->bytes_skipped++;
+            i++;
+        }
+    }
+    
+    return i;
+}
+
+int CommandDeframer_Push(CommandDeframer *deframer, const uint8_t *data, uint32_t len)
+{
+    if (!deframer || !data) return 0;
+    
+    deframer->bytes_in += len;
+    int emitted = 0;
+    uint32_t pos = 0;
+    
+    /* 보관한 부분 프레임 + 새 데이터 앞부분만 이어 붙여, 보관분에서 시작하는 프레임 처리 */
+    if (deframer->carry_len > 0) {
+        uint8_t join[2 * IRIGFIX_COMMAND_WIRE_SIZE];
+        uint32_t carry_len = deframer->carry_len;
+        uint32_t take = (len < IRIGFIX_COMMAND_WIRE_SIZE - 1) ? len : IRIGFIX_COMMAND_WIRE_SIZE - 1;
+        memcpy(join, deframer->carry, carry_len);
+        memcpy(join + carry_len, data, take);
+        
+        uint32_t join_len = carry_len + take;
+        uint32_t i = scan(deframer, join, join_len, 0, carry_len, &emitted);
+        if (i < carry_len) {
+            /* 새 데이터를 다 붙여도 아직 불완전 (take == len) */
+            deframer->carry_len = join_len - i;
+            memmove(deframer->carry, join + i, deframer->carry_len);
+            return emitted;
+        }
+        
+        deframer->carry_len = 0;
+        pos = i - carry_len;
+    }
+    
+    /* 나머지는 수신 버퍼에서 바로 */
+    uint32_t i = scan(deframer, data, len, pos, len, &emitted);
+    if (i < len) {
+        deframer->carry_len = len - i;
+        memcpy(deframer->carry, data + i, deframer->carry_len);
+    }
+    
+    return emitted;
+}
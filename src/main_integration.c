@@ -1,11 +1,18 @@
 #include "missile_telemetry.h"
+#include "sensor_acquisition.h"
 #include "ldpc_codec.h"
 #include "soqpsk.h"
 #include "data_storage.h"
 #include "camera_interface.h"
+#include "camera_pipeline.h"
+#include "downlink_mux.h"
 #include "ground_control.h"
 #include "emergency_system.h"
 #include "telemetry_config.h"
+#include "launch_detector.h"
+#include "column_store.h"
+#include "black_box.h"
+#include "replay.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -14,9 +21,6 @@
 
 #define PT_SENSOR_SAMPLE_PERIOD_MS 1
 #define PT_DATA_TX_PERIOD_MS 10
-#define PT_LAUNCH_DETECTION_PERIOD_MS 100
-#define PT_LAUNCH_ACCEL_THRESHOLD_G 5.0f
-#define PT_LAUNCH_SUSTAINED_SAMPLES 10
 #define PT_PLL_BANDWIDTH_SCALE 0.01f
 #define PT_PLL_DAMPING_FACTOR 0.707f
 #define PT_LDPC_DECODER_MAX_ITERATIONS 50
@@ -28,6 +32,7 @@
 #define PT_IMU_ACCEL_SCALE 100.0f
 #define PT_IMU_GYRO_SCALE 2000.0f
 #define PT_CONFIG_UPDATE_PERIOD_MS 5000
+#define PT_DOWNLINK_LDPC_RATE LDPC_RATE_2_3
 
 static MissileTelemetrySystem *g_tm_system = NULL;
 static LDPC_Encoder *g_ldpc_encoder = NULL;
@@ -36,14 +41,44 @@ static SOQPSK_Modulator *g_soqpsk_mod = NULL;
 static SOQPSK_Demodulator *g_soqpsk_demod = NULL;
 
 static LogBuffer *g_log_buffer = NULL;
+static LogWriter *g_log_writer = NULL;
+static LogPyramid *g_log_pyramid = NULL;
+static BlackBox *g_black_box = NULL;
 static CameraDevice *g_camera = NULL;
+static CameraPipeline *g_camera_pipeline = NULL;
 static ControlState g_control_state = {0};
+static CommandDeframer *g_uplink_deframer = NULL;
 static EmergencyState *g_emergency_state = NULL;
 static ConfigSet *g_config = NULL;
 
 static uint32_t g_frames_transmitted = 0;
 static uint32_t g_frames_received = 0;
 static float g_last_accel_magnitude = 0.0f;
+static DownlinkMux *g_downlink_mux = NULL;
+static uint8_t *g_tx_info = NULL;
+static uint8_t *g_tx_codeword = NULL;
+static uint8_t *g_tx_randomized = NULL;
+static float_complex *g_tx_samples = NULL;     /* 코드워드 하나의 기저대역 (N × 심볼당 샘플) */
+static uint32_t g_codewords_transmitted = 0;
+
+/* 상향 링크 역프레이머 콜백: CRC/타입 검증이 끝난 명령을 제어 상태에 적용 */
+static void on_uplink_command(void *context, const GroundControlCommand *cmd)
+{
+    if (!GroundControl_ApplyCommand(cmd, (ControlState *)context)) {
+        printf("[UPLINK] 명령 %u (타입 %d) 적용 안 함\n", cmd->cmd_id, (int)cmd->cmd_type);
+    }
+}
+
+/* 다중화기가 만든 정보 블록 하나를 부호화 → 랜덤화 → 변조 (g_tx_samples 를 송신기로) */
+static void transmit_block(const uint8_t *info)
+{
+    int n = g_ldpc_encoder->N;
+    
+    LDPC_Encode(g_ldpc_encoder, info, g_tx_codeword);
+    LDPC_Randomize(g_tx_codeword, g_tx_randomized, n);
+    SOQPSK_Modulate(g_soqpsk_mod, g_tx_randomized, n, g_tx_samples);
+    g_codewords_transmitted++;
+}
 
 int MissileTM_InitializeSystem(void)
 {
@@ -62,13 +97,16 @@ int MissileTM_InitializeSystem(void)
     g_tm_system->launch_detected = false;
     g_tm_system->telemetry_active = false;
     
+    printf("[INIT] 센서 변환 테이블 초기화...\n");
+    Sensor_Init();
+    
     printf("[INIT] SOQPSK 모듈 초기화...\n");
-    g_soqpsk_mod = malloc(sizeof(SOQPSK_Modulator));
+    g_soqpsk_mod = SOQPSK_Modulator_Create(IRIGFIX_CARRIER_FREQ, IRIGFIX_SAMPLE_RATE,
+                                           IRIGFIX_SAMPLES_PER_SYMBOL);
     if (!g_soqpsk_mod) {
         printf("오류: SOQPSK 변조기 초기화 실패\n");
         return -1;
     }
-    memset(g_soqpsk_mod, 0, sizeof(SOQPSK_Modulator));
     
     g_soqpsk_demod = malloc(sizeof(SOQPSK_Demodulator));
     if (!g_soqpsk_demod) {
@@ -78,12 +116,24 @@ int MissileTM_InitializeSystem(void)
     memset(g_soqpsk_demod, 0, sizeof(SOQPSK_Demodulator));
     
     printf("[INIT] LDPC 코덱 초기화...\n");
-    g_ldpc_encoder = malloc(sizeof(LDPC_Encoder));
+    g_ldpc_encoder = LDPC_Encoder_Create(PT_DOWNLINK_LDPC_RATE);
     if (!g_ldpc_encoder) {
         printf("오류: LDPC 인코더 초기화 실패\n");
         return -1;
     }
-    memset(g_ldpc_encoder, 0, sizeof(LDPC_Encoder));
+    
+    /* 하향 링크: 코드워드 슬롯마다 텔레메트리 우선, 남는 자리에 영상 */
+    g_downlink_mux = DownlinkMux_Create(g_ldpc_encoder->K,
+                                        IRIGFIX_LDPC_N / IRIGFIX_DATA_RATE * 1e6);
+    g_tx_info = malloc(IRIGFIX_LDPC_N);
+    g_tx_codeword = malloc(IRIGFIX_LDPC_N);
+    g_tx_randomized = malloc(IRIGFIX_LDPC_N);
+    g_tx_samples = malloc((size_t)IRIGFIX_LDPC_N * IRIGFIX_SAMPLES_PER_SYMBOL * sizeof(float_complex));
+    if (!g_downlink_mux || !g_tx_info || !g_tx_codeword || !g_tx_randomized || !g_tx_samples) {
+        printf("오류: 하향 링크 다중화기 초기화 실패\n");
+        return -1;
+    }
+    LDPC_Randomizer_Init(0);
     
     g_ldpc_decoder = malloc(sizeof(LDPC_Decoder));
     if (!g_ldpc_decoder) {
@@ -105,6 +155,10 @@ int MissileTM_InitializeSystem(void)
         printf("경고: 카메라 초기화 실패 (계속 진행)\n");
     } else {
         Camera_Start(g_camera);
+        g_camera_pipeline = CameraPipeline_Create(g_camera, g_log_buffer);
+        if (!g_camera_pipeline) {
+            printf("경고: 영상 압축 스레드 시작 실패 (영상 없음)\n");
+        }
     }
     
     printf("[INIT] 긴급 시스템 초기화...\n");
@@ -114,6 +168,16 @@ int MissileTM_InitializeSystem(void)
         return -1;
     }
     
+    if (PT_BLACK_BOX_ENABLE) {
+        printf("[INIT] 블랙박스 파일 할당...\n");
+        g_black_box = BlackBox_Create(PT_BLACK_BOX_FILENAME, g_log_buffer,
+                                      PT_BLACK_BOX_WINDOW_MS);
+        if (!g_black_box) {
+            printf("경고: 블랙박스 할당 실패 (비상 시 기록 없음)\n");
+        }
+        EmergencySystem_SetBlackBox(g_black_box);
+    }
+    
     printf("[INIT] 설정 시스템 초기화...\n");
     g_config = TelemetryConfig_Init();
     if (!g_config) {
@@ -126,18 +190,72 @@ int MissileTM_InitializeSystem(void)
             "PT_SENSOR_SAMPLE_PERIOD_MS", 1, 1, 100);
         TelemetryConfig_RegisterIntParam(g_config, 1,
             "PT_DATA_TX_PERIOD_MS", 10, 5, 100);
-        TelemetryConfig_RegisterFloatParam(g_config, 2,
-            "PT_LAUNCH_ACCEL_THRESHOLD_G", 5.0f, 1.0f, 10.0f);
+        TelemetryConfig_RegisterFloatParam(g_config, LAUNCH_CONFIG_PARAM_THRESHOLD,
+            "PT_LAUNCH_ACCEL_THRESHOLD_G", PT_LAUNCH_ACCEL_THRESHOLD_G, 1.0f, 10.0f);
         TelemetryConfig_RegisterFloatParam(g_config, 3,
             "PT_PLL_BANDWIDTH_SCALE", 0.01f, 0.001f, 0.1f);
         TelemetryConfig_RegisterIntParam(g_config, 4,
             "PT_LDPC_DECODER_MAX_ITERATIONS", 50, 10, 100);
+        TelemetryConfig_RegisterIntParam(g_config, LAUNCH_CONFIG_PARAM_SUSTAINED,
+            "PT_LAUNCH_SUSTAINED_SAMPLES", PT_LAUNCH_SUSTAINED_SAMPLES, 1, 1000);
+        TelemetryConfig_RegisterIntParam(g_config, 6,
+            "PT_LOG_WRITER_SYNC_INTERVAL_MS", PT_LOG_WRITER_SYNC_INTERVAL_MS, 0, 10000);
+        /* 영상 ROI / 축소 (0 = 원본): 링크 여유가 없을 때 지상에서 변경 */
+        TelemetryConfig_RegisterIntParam(g_config, CAMERA_CONFIG_PARAM_OUT_WIDTH,
+            "PT_CAMERA_OUT_WIDTH", 0, 0, PT_CAMERA_RESOLUTION_WIDTH);
+        TelemetryConfig_RegisterIntParam(g_config, CAMERA_CONFIG_PARAM_OUT_HEIGHT,
+            "PT_CAMERA_OUT_HEIGHT", 0, 0, PT_CAMERA_RESOLUTION_HEIGHT);
+        TelemetryConfig_RegisterIntParam(g_config, CAMERA_CONFIG_PARAM_SCALE_MODE,
+            "PT_CAMERA_SCALE_MODE", CAMERA_SCALE_BOX, CAMERA_SCALE_BOX, CAMERA_SCALE_BILINEAR);
+        TelemetryConfig_RegisterIntParam(g_config, CAMERA_CONFIG_PARAM_ROI_X,
+            "PT_CAMERA_ROI_X", 0, 0, PT_CAMERA_RESOLUTION_WIDTH - 1);
+        TelemetryConfig_RegisterIntParam(g_config, CAMERA_CONFIG_PARAM_ROI_Y,
+            "PT_CAMERA_ROI_Y", 0, 0, PT_CAMERA_RESOLUTION_HEIGHT - 1);
+        TelemetryConfig_RegisterIntParam(g_config, CAMERA_CONFIG_PARAM_ROI_WIDTH,
+            "PT_CAMERA_ROI_WIDTH", 0, 0, PT_CAMERA_RESOLUTION_WIDTH);
+        TelemetryConfig_RegisterIntParam(g_config, CAMERA_CONFIG_PARAM_ROI_HEIGHT,
+            "PT_CAMERA_ROI_HEIGHT", 0, 0, PT_CAMERA_RESOLUTION_HEIGHT);
+    }
+    
+    printf("[INIT] 로그 기록 스레드 시작...\n");
+    g_log_writer = LogWriter_Create(PT_LOG_WRITER_FILENAME,
+                                    (uint32_t)TelemetryConfig_GetInt(g_config, 6));
+    if (!g_log_writer || !DataStorage_AttachWriter(g_log_buffer, g_log_writer)) {
+        printf("경고: 로그 기록 스레드 시작 실패 (종료 시에만 저장)\n");
+    }
+    
+    if (PT_ENABLE_LOG_PYRAMID) {
+        g_log_pyramid = LogPyramid_Create(PT_LOG_PYRAMID_FILENAME);
+        if (!g_log_pyramid || !DataStorage_AttachPyramid(g_log_buffer, g_log_pyramid)) {
+            printf("경고: 감축 피라미드 생성 실패 (퀵룩 없음)\n");
+        }
+    }
+    
+    printf("[INIT] 발사 감지기 초기화...\n");
+    g_tm_system->launch_detector = LaunchDetector_Create(g_config);
+    if (!g_tm_system->launch_detector) {
+        printf("오류: 발사 감지기 초기화 실패\n");
+        return -1;
+    }
+    
+    printf("[INIT] IMU 데시메이터 초기화 (%d kHz → %d Hz)...\n",
+           PT_IMU_OVERSAMPLE_RATE_HZ / 1000, PT_IMU_OUTPUT_RATE_HZ);
+    g_tm_system->imu_decimator = ImuDecimator_Create();
+    if (!g_tm_system->imu_decimator) {
+        printf("경고: IMU 데시메이터 생성 실패 (단일 샘플 IMU 사용)\n");
     }
     
     memset(&g_control_state, 0, sizeof(ControlState));
     g_control_state.is_command_valid = true;
     g_control_state.current_thrust = 0.0f;
     
+    printf("[INIT] 상향 링크 역프레이머 초기화...\n");
+    g_uplink_deframer = CommandDeframer_Create(on_uplink_command, &g_control_state);
+    if (!g_uplink_deframer) {
+        printf("오류: 상향 링크 역프레이머 초기화 실패\n");
+        return -1;
+    }
+    
     printf("\n시스템 초기화 완료!\n\n");
     
     return 0;
@@ -149,19 +267,48 @@ void MissileTM_ShutdownSystem(void)
     printf("시스템 종료 중...\n");
     printf("========================================\n");
     
+    if (g_camera_pipeline) {
+        CameraPipeline_WaitIdle(g_camera_pipeline);
+        uint32_t frames = atomic_load(&g_camera_pipeline->frames_compressed);
+        uint64_t raw = atomic_load(&g_camera_pipeline->raw_bytes);
+        uint64_t compressed = atomic_load(&g_camera_pipeline->compressed_bytes);
+        printf("[SHUTDOWN] 영상 압축: %u 프레임, 압축률 %.1f:1, 평균 %llu us / 최대 %u us\n",
+               frames, compressed ? (double)raw / compressed : 0.0,
+               frames ? (unsigned long long)(atomic_load(&g_camera_pipeline->encode_us_total) / frames) : 0ULL,
+               atomic_load(&g_camera_pipeline->encode_us_max));
+        uint32_t scaled = atomic_load(&g_camera_pipeline->frames_scaled);
+        if (scaled > 0) {
+            printf("[SHUTDOWN] 영상 축소/ROI: %u 프레임, 평균 %llu us\n", scaled,
+                   (unsigned long long)(atomic_load(&g_camera_pipeline->scale_us_total) / scaled));
+        }
+        CameraPipeline_Destroy(g_camera_pipeline);
+        g_camera_pipeline = NULL;
+    }
+    
     if (g_camera) {
         Camera_Stop(g_camera);
         Camera_Destroy(g_camera);
         g_camera = NULL;
     }
     
+    if (g_uplink_deframer) {
+        printf("[SHUTDOWN] 상향 링크: 명령 %u, CRC 오류 %u, 미지 명령 %u, 재동기 %llu bytes\n",
+               g_uplink_deframer->commands, g_uplink_deframer->crc_errors,
+               g_uplink_deframer->type_errors,
+               (unsigned long long)g_uplink_deframer->bytes_skipped);
+        CommandDeframer_Destroy(g_uplink_deframer);
+        g_uplink_deframer = NULL;
+    }
+    
     if (g_tm_system) {
+        LaunchDetector_Destroy((LaunchDetector *)g_tm_system->launch_detector);
+        ImuDecimator_Destroy((ImuDecimator *)g_tm_system->imu_decimator);
         free(g_tm_system);
         g_tm_system = NULL;
     }
     
     if (g_soqpsk_mod) {
-        free(g_soqpsk_mod);
+        SOQPSK_Modulator_Destroy(g_soqpsk_mod);
         g_soqpsk_mod = NULL;
     }
     
@@ -170,8 +317,42 @@ void MissileTM_ShutdownSystem(void)
         g_soqpsk_demod = NULL;
     }
     
+    if (g_downlink_mux) {
+        printf("[SHUTDOWN] 하향 링크: 블록 %llu개, 텔레메트리 최대 지연 %llu us, "
+               "영상 %u 프레임 송신 / %u 폐기 (%llu 바이트)\n",
+               (unsigned long long)g_downlink_mux->blocks,
+               (unsigned long long)g_downlink_mux->telemetry_latency_max_us,
+               g_downlink_mux->video_frames_sent,
+               g_downlink_mux->video_frames_stale + g_downlink_mux->video_frames_superseded,
+               (unsigned long long)g_downlink_mux->video_bytes);
+        printf("[SHUTDOWN] 송신 체인: 코드워드 %u개 (LDPC → 랜덤화 → SOQPSK)\n",
+               g_codewords_transmitted);
+        DownlinkMux_Destroy(g_downlink_mux);
+        g_downlink_mux = NULL;
+    }
+    
+    if (g_tx_info) {
+        free(g_tx_info);
+        g_tx_info = NULL;
+    }
+    
+    if (g_tx_codeword) {
+        free(g_tx_codeword);
+        g_tx_codeword = NULL;
+    }
+    
+    if (g_tx_randomized) {
+        free(g_tx_randomized);
+        g_tx_randomized = NULL;
+    }
+    
+    if (g_tx_samples) {
+        free(g_tx_samples);
+        g_tx_samples = NULL;
+    }
+    
     if (g_ldpc_encoder) {
-        free(g_ldpc_encoder);
+        LDPC_Encoder_Destroy(g_ldpc_encoder);
         g_ldpc_encoder = NULL;
     }
     
@@ -180,7 +361,35 @@ void MissileTM_ShutdownSystem(void)
         g_ldpc_decoder = NULL;
     }
     
+    if (g_log_writer) {
+        if (!DataStorage_DetachWriter(g_log_buffer)) {
+            printf("경고: 비행 로그 색인/트레일러 기록 실패 (읽기 시 순차 탐색으로 복구)\n");
+        }
+        LogWriter_Destroy(g_log_writer);
+        g_log_writer = NULL;
+    }
+    
+    if (g_log_pyramid) {
+        DataStorage_DetachPyramid(g_log_buffer);
+        LogPyramid_Destroy(g_log_pyramid);
+        g_log_pyramid = NULL;
+    }
+    
     if (g_log_buffer) {
+        /* 비행 후 분석용 열 저장 파일 (채널별 청크 + min/max) */
+        if (PT_ENABLE_COLUMN_EXPORT) {
+            ColumnExportOptions options = { 0, 0, true, NULL };
+            if (ColumnStore_Export(g_log_buffer, PT_COLUMN_EXPORT_FILENAME, &options)) {
+                printf("[SHUTDOWN] 열 저장 내보내기: %s\n", PT_COLUMN_EXPORT_FILENAME);
+            }
+        }
+        if (PT_LOG_SAVE_PERIOD_MS > 0) {
+            if (DataStorage_CloseAppend(g_log_buffer)) {
+                printf("[SHUTDOWN] 증분 저장 마감: %s\n", PT_LOG_SAVE_FILENAME);
+            } else {
+                printf("경고: 증분 저장 마감 실패 (읽기 시 순차 탐색으로 복구)\n");
+            }
+        }
         DataStorage_Destroy(g_log_buffer);
         g_log_buffer = NULL;
     }
@@ -190,6 +399,12 @@ void MissileTM_ShutdownSystem(void)
         g_emergency_state = NULL;
     }
     
+    if (g_black_box) {
+        EmergencySystem_SetBlackBox(NULL);
+        BlackBox_Destroy(g_black_box);
+        g_black_box = NULL;
+    }
+    
     if (g_config) {
         TelemetryConfig_Destroy(g_config);
         g_config = NULL;
@@ -212,10 +427,34 @@ void MissileTM_MainLoop(void)
         loop_count++;
         
         if (g_tm_system) {
-            g_tm_system->current_frame.frame_counter++;
+            /* 1 ms 분량 센서 수집 (frame_counter 증가 포함) */
+            if (g_tm_system->imu_decimator) {
+                MissileTM_ReadSensorsOversampled(g_tm_system,
+                                                 (ImuDecimator *)g_tm_system->imu_decimator);
+            } else {
+                MissileTM_ReadSensors(g_tm_system);
+            }
             g_tm_system->current_frame.timestamp_us += 1000;
         }
         
+        /* 지금까지 송신 시각이 된 코드워드 슬롯마다 정보 블록 생성 (이번 프레임은 다음 슬롯) */
+        if (g_downlink_mux && g_tm_system) {
+            while (DownlinkMux_NextBlock(g_downlink_mux, g_tm_system->current_frame.timestamp_us,
+                                         g_tx_info)) {
+                transmit_block(g_tx_info);
+            }
+        }
+        
+        /* 상향 링크: UART 에서 받은 만큼 그대로 (프레임 경계 무관, 명령은 콜백에서 적용) */
+        if (g_uplink_deframer) {
+            uint8_t uplink_rx[64] = {0};
+            uint32_t uplink_len = 0;
+            
+            if (uplink_len > 0) {
+                CommandDeframer_Push(g_uplink_deframer, uplink_rx, uplink_len);
+            }
+        }
+        
         if (loop_count == 1) {
             if (g_tm_system) {
                 g_tm_system->launch_detected = true;
@@ -225,17 +464,46 @@ void MissileTM_MainLoop(void)
         }
         
         if (g_tm_system && g_tm_system->telemetry_active && g_log_buffer) {
-            LogEntry log_entry;
-            memset(&log_entry, 0, sizeof(LogEntry));
-            log_entry.entry_id = g_log_buffer->buffer_count;
-            log_entry.timestamp_us = g_tm_system->current_frame.timestamp_us;
-            memcpy(&log_entry.telemetry, &g_tm_system->current_frame,
-                   sizeof(MissileTelemetryFrame));
-            
-            DataStorage_WriteEntry(g_log_buffer, &log_entry);
+            /* 링 슬롯에 제자리 기록 (entry_id 는 예약 티켓) */
+            LogReservation res;
+            LogEntry *log_entry = DataStorage_Reserve(g_log_buffer, &res);
+            if (log_entry) {
+                log_entry->timestamp_us = g_tm_system->current_frame.timestamp_us;
+                memcpy(&log_entry->telemetry, &g_tm_system->current_frame,
+                       sizeof(MissileTelemetryFrame));
+                log_entry->last_command_type = 0;
+                log_entry->last_thrust_cmd = 0.0f;
+                DataStorage_Commit(g_log_buffer, &res);
+            }
+            if (g_downlink_mux) {
+                DownlinkMux_AddTelemetry(g_downlink_mux, &g_tm_system->current_frame);
+            }
             g_frames_transmitted++;
         }
         
+        /* 캡처 요청만 넣고 압축/로그 전달은 워커 스레드가 처리 (1 ms 루프 밖) */
+        if (g_camera_pipeline && loop_count % (1000 / PT_CAMERA_FPS) == 0) {
+            CameraPipeline_ApplyConfig(g_camera_pipeline, g_config);
+            CameraPipeline_Trigger(g_camera_pipeline,
+                                   g_tm_system ? g_tm_system->current_frame.timestamp_us : 0);
+        }
+        
+        /* 압축 영상은 다중화기가 참조를 잡고 여유 자리에 조각으로 실음 */
+        if (g_camera_pipeline) {
+            CameraFrame *frame;
+            while ((frame = CameraPipeline_PopDownlink(g_camera_pipeline)) != NULL) {
+                DownlinkMux_SubmitVideo(g_downlink_mux, frame);
+                Camera_ReleaseFrame(frame);
+            }
+        }
+        
+        /* 증분 저장: 지난 저장 이후 공개된 엔트리만 덧붙이고 COMMIT */
+        if (g_log_buffer && PT_LOG_SAVE_PERIOD_MS > 0 && loop_count % PT_LOG_SAVE_PERIOD_MS == 0) {
+            if (!DataStorage_AppendToSD(g_log_buffer, PT_LOG_SAVE_FILENAME)) {
+                printf("경고: 증분 저장 실패 (직전 COMMIT 까지 유지)\n");
+            }
+        }
+        
         if (loop_count % 10 == 0) {
             printf("[%d ms] TX: %d, Log: %d\n",
                    loop_count, g_frames_transmitted,
@@ -251,8 +519,88 @@ void MissileTM_MainLoop(void)
     printf("\n메인 루프 종료\n");
 }
 
-int main(void)
+/* 기록 재생: 센서 대신 저장된 로그로 송신 체인을 구동 (회귀 시험 / 처리율 측정) */
+int MissileTM_Replay(const char *filename, const ReplayOptions *options)
 {
+    printf("========================================\n");
+    printf("기록 재생: %s (%s)\n", filename,
+           options->speed > 0.0 ? "실시간 배속" : "최대 속도");
+    printf("========================================\n\n");
+    
+    ReplayPipeline *replay = Replay_Create(options);
+    if (!replay) {
+        printf("오류: 송신 체인 초기화 실패\n");
+        return 1;
+    }
+    
+    ReplayReport r;
+    if (!Replay_RunFile(replay, filename, &r)) {
+        printf("오류: 로그를 읽을 수 없음 (비행 로그 컨테이너 형식만 지원)\n");
+        Replay_Destroy(replay);
+        return 1;
+    }
+    
+    printf("[REPLAY] 프레임 %llu개, 코드워드 %llu개, 샘플 %llu개\n",
+           (unsigned long long)r.frames, (unsigned long long)r.codewords,
+           (unsigned long long)r.samples);
+    printf("[REPLAY] 기록 %.3f s / 재생 %.3f s (실시간 %.2f배)\n",
+           r.log_span_us / 1e6, r.elapsed_us / 1e6, r.realtime_factor);
+    printf("[REPLAY] 처리율: %.0f 프레임/s, 정보 %.3f Mbps\n",
+           r.frames_per_s, r.info_bits_per_s / 1e6);
+    printf("[REPLAY] 단계별: 패킹 %llu us, LDPC %llu us, 랜덤화 %llu us, 변조 %llu us\n",
+           (unsigned long long)r.pack_us, (unsigned long long)r.encode_us,
+           (unsigned long long)r.randomize_us, (unsigned long long)r.modulate_us);
+    if (options->speed > 0.0) {
+        printf("[REPLAY] 목표 시각 대비 최대 지연: %llu us\n", (unsigned long long)r.max_lag_us);
+    }
+    if (options->video) {
+        printf("[REPLAY] 영상: %u 제출, %u 송신, %u 폐기, 지상 재조립 %u (%llu 바이트)\n",
+               r.video_frames_submitted, r.video_frames_sent, r.video_frames_dropped,
+               r.video_frames_received, (unsigned long long)r.video_bytes);
+        printf("[REPLAY] 텔레메트리 지상 수신 %llu, 최대 지연 %llu us\n",
+               (unsigned long long)r.telemetry_frames_received,
+               (unsigned long long)r.telemetry_latency_max_us);
+    }
+    printf("[REPLAY] 비트 해시: %016llx\n", (unsigned long long)r.bit_hash);
+    
+    Replay_Destroy(replay);
+    return 0;
+}
+
+static void print_usage(const char *prog)
+{
+    printf("사용법: %s [--replay <로그> [--speed 배속] [--frames N] [--no-modulate] [--video]]\n", prog);
+    printf("  --speed 0 (기본) = 최대 속도, 1 = 실시간, 10 = 10배속\n");
+    printf("  --video 고정 속도 링크 슬롯 + 로그 영상 다중화\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *replay_file = NULL;
+    ReplayOptions replay_options;
+    Replay_DefaultOptions(&replay_options);
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_file = argv[++i];
+        } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            replay_options.speed = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            replay_options.max_frames = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--no-modulate") == 0) {
+            replay_options.modulate = false;
+        } else if (strcmp(argv[i], "--video") == 0) {
+            replay_options.video = true;
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    
+    if (replay_file) {
+        return MissileTM_Replay(replay_file, &replay_options);
+    }
+    
     printf("\n");
     printf("========================================\n");
     printf("미사일 텔레메트리 시스템 v3\n");
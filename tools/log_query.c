@@ -0,0 +1,90 @@
+#include "log_query.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/* ============================================================
+ * 로그 질의 도구 (지상 분석용)
+ *
+ * log_query [-j 스레드] [-c 열,열,...] [-b] [-s] <파일> '<식>'
+ *   -j  병렬 스레드 수 (기본 PT_LOG_QUERY_THREADS)
+ *   -c  출력 열 (채널 이름, 쉼표 구분. 기본: 전체)
+ *   -b  CSV 대신 f64 리틀 엔디언 바이너리 출력
+ *   -s  청크/행 통계를 stderr 로 출력
+ * 예: log_query -c timestamp_us,temperature_c[3] flight_columns.tmc \
+ *         'temperature_c[3] > 85 && flight_mode == 2'
+ * ============================================================ */
+
+static void usage(void)
+{
+    fprintf(stderr, "사용법: log_query [-j 스레드] [-c 열,열,...] [-b] [-s] <파일> '<식>'\n");
+    fprintf(stderr, "  파일: 비행 로그 (*.bin) 또는 열 저장 파일 (*.tmc)\n");
+}
+
+/* 쉼표로 구분된 채널 이름 → 채널 번호 */
+static int parse_columns(char *list, int *columns)
+{
+    int count = 0;
+    for (char *name = strtok(list, ","); name; name = strtok(NULL, ",")) {
+        int c = TelemetryChannels_Find(name);
+        if (c < 0) {
+            fprintf(stderr, "오류: 알 수 없는 채널 '%s'\n", name);
+            return -1;
+        }
+        if (count == TELEMETRY_NUM_CHANNELS) break;
+        columns[count++] = c;
+    }
+    return count;
+}
+
+int main(int argc, char **argv)
+{
+    LogQueryOptions options = { 0, LOG_QUERY_FORMAT_CSV, NULL, 0 };
+    int columns[TELEMETRY_NUM_CHANNELS];
+    bool show_stats = false;
+    int arg = 1;
+
+    for (; arg < argc && argv[arg][0] == '-' && argv[arg][1] != '\0'; arg++) {
+        const char *opt = argv[arg];
+        if (strcmp(opt, "-j") == 0 && arg + 1 < argc) {
+            options.threads = (uint32_t)atoi(argv[++arg]);
+        } else if (strcmp(opt, "-c") == 0 && arg + 1 < argc) {
+            options.column_count = parse_columns(argv[++arg], columns);
+            if (options.column_count < 0) return 2;
+            options.columns = columns;
+        } else if (strcmp(opt, "-b") == 0) {
+            options.format = LOG_QUERY_FORMAT_BINARY;
+        } else if (strcmp(opt, "-s") == 0) {
+            show_stats = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    if (argc - arg != 2) {
+        usage();
+        return 2;
+    }
+
+    LogQueryExpr expr;
+    char err[128];
+    if (!LogQuery_Parse(argv[arg + 1], &expr, err, sizeof(err))) {
+        fprintf(stderr, "오류: 식 파싱 실패 (%s)\n", err);
+        return 2;
+    }
+
+    LogQueryStats stats;
+    if (!LogQuery_Run(argv[arg], &expr, &options, stdout, &stats)) {
+        fprintf(stderr, "오류: 질의 실패 '%s'\n", argv[arg]);
+        return 1;
+    }
+
+    if (show_stats) {
+        fprintf(stderr, "청크 %u개 중 %u개 건너뜀, 행 %llu개 검사, %llu개 일치\n",
+                stats.chunks_total, stats.chunks_skipped,
+                (unsigned long long)stats.rows_scanned,
+                (unsigned long long)stats.rows_matched);
+    }
+    return 0;
+}